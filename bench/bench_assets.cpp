@@ -0,0 +1,74 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <maths/maths_util.h>
+#include "graphics/mesh/mesh_builder.h"
+#include "graphics/texture/texture_loader.h"
+
+namespace mkr {
+    namespace {
+        /// Write a triangulated UV sphere to an OBJ file, and return its path.
+        std::string write_sphere_obj(uint32_t _slices, uint32_t _stacks) {
+            const auto path = std::filesystem::temp_directory_path() / ("mkr_bench_sphere_" + std::to_string(_slices) + "x" + std::to_string(_stacks) + ".obj");
+            std::ofstream stream{path};
+            for (uint32_t stack = 0; stack <= _stacks; ++stack) {
+                const float phi = maths_util::pi * static_cast<float>(stack) / static_cast<float>(_stacks);
+                for (uint32_t slice = 0; slice <= _slices; ++slice) {
+                    const float theta = 2.0f * maths_util::pi * static_cast<float>(slice) / static_cast<float>(_slices);
+                    const float x = std::sin(phi) * std::cos(theta), y = std::cos(phi), z = std::sin(phi) * std::sin(theta);
+                    stream << "v " << x << ' ' << y << ' ' << z << '\n';
+                    stream << "vt " << static_cast<float>(slice) / static_cast<float>(_slices) << ' ' << static_cast<float>(stack) / static_cast<float>(_stacks) << '\n';
+                    stream << "vn " << x << ' ' << y << ' ' << z << '\n';
+                }
+            }
+            // OBJ indices start at 1.
+            for (uint32_t stack = 0; stack < _stacks; ++stack) {
+                for (uint32_t slice = 0; slice < _slices; ++slice) {
+                    const uint32_t a = stack * (_slices + 1) + slice + 1, b = a + _slices + 1;
+                    stream << "f " << a << '/' << a << '/' << a << ' ' << b << '/' << b << '/' << b << ' ' << a + 1 << '/' << a + 1 << '/' << a + 1 << '\n';
+                    stream << "f " << b << '/' << b << '/' << b << ' ' << b + 1 << '/' << b + 1 << '/' << b + 1 << ' ' << a + 1 << '/' << a + 1 << '/' << a + 1 << '\n';
+                }
+            }
+            return path.string();
+        }
+    }
+
+    /// The argument is the number of slices of the sphere, which has half as many stacks.
+    void bm_load_obj(benchmark::State& _state) {
+        const auto slices = static_cast<uint32_t>(_state.range(0));
+        const std::string file = write_sphere_obj(slices, slices / 2);
+        for (auto _ : _state) {
+            benchmark::DoNotOptimize(mesh_builder::load_obj("bench_sphere", file));
+            gfx().end_frame();
+        }
+        _state.SetItemsProcessed(_state.iterations() * slices * (slices / 2) * 2);
+        std::filesystem::remove(file);
+    }
+    BENCHMARK(bm_load_obj)->Arg(32)->Arg(128)->Unit(benchmark::kMicrosecond);
+
+    /// The argument is the width and height of the image, which has 4 bytes per pixel.
+    void bm_flip_image_x(benchmark::State& _state) {
+        const auto size = static_cast<uint32_t>(_state.range(0));
+        std::vector<uint8_t> image(static_cast<size_t>(size) * size * 4, 0x7F);
+        for (auto _ : _state) {
+            texture_loader::flip_image_x(image.data(), size, size, 4);
+            benchmark::ClobberMemory();
+        }
+        _state.SetBytesProcessed(_state.iterations() * static_cast<int64_t>(image.size()));
+    }
+    BENCHMARK(bm_flip_image_x)->Arg(512)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+    void bm_flip_image_y(benchmark::State& _state) {
+        const auto size = static_cast<uint32_t>(_state.range(0));
+        std::vector<uint8_t> image(static_cast<size_t>(size) * size * 4, 0x7F);
+        for (auto _ : _state) {
+            texture_loader::flip_image_y(image.data(), size, size, 4);
+            benchmark::ClobberMemory();
+        }
+        _state.SetBytesProcessed(_state.iterations() * static_cast<int64_t>(image.size()));
+    }
+    BENCHMARK(bm_flip_image_y)->Arg(512)->Arg(2048)->Unit(benchmark::kMicrosecond);
+} // mkr
\ No newline at end of file
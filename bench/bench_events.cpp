@@ -0,0 +1,34 @@
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "event/event_dispatcher.h"
+#include "event/event_listener.h"
+#include "input/input_event.h"
+
+namespace mkr {
+    /// The argument is the number of listeners to the dispatched event type.
+    void bm_dispatch_event(benchmark::State& _state) {
+        event_dispatcher dispatcher;
+        std::vector<std::unique_ptr<event_listener>> listeners;
+        uint64_t num_received = 0;
+        for (int64_t i = 0; i < _state.range(0); ++i) {
+            listeners.push_back(std::make_unique<event_listener>());
+            dispatcher.add_listener<button_event>(listeners.back().get(), [&num_received](const button_event& _event) { num_received += _event.action_; });
+            // Listeners to other event types must not slow down the dispatch.
+            dispatcher.add_listener<axis_event>(listeners.back().get(), [&num_received](const axis_event& _event) { num_received += _event.action_; });
+        }
+
+        const button_event event{1, button_state::down};
+        for (auto _ : _state) {
+            dispatcher.dispatch_event(event);
+        }
+        benchmark::DoNotOptimize(num_received);
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+
+        for (const auto& l : listeners) {
+            dispatcher.remove_listener<button_event>(l.get());
+            dispatcher.remove_listener<axis_event>(l.get());
+        }
+    }
+    BENCHMARK(bm_dispatch_event)->Arg(1)->Arg(16)->Arg(256);
+} // mkr
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "input/input.h"
+#include "input/input_helper.h"
+#include "input/binding_index.h"
+#include "input/keycode.h"
+
+namespace mkr {
+    namespace {
+        struct registration {
+            input_mask_t mask_;
+            input_action_t action_;
+        };
+
+        /// Registrations spread over every keycode, in a few contexts and for a few controllers.
+        std::vector<registration> make_registrations(size_t _count) {
+            std::vector<registration> registrations;
+            registrations.reserve(_count);
+            for (size_t i = 0; i < _count; ++i) {
+                const auto context = static_cast<input_context>(1u << (i % 4));
+                const auto controller = static_cast<controller_index>(1u << (i % 2));
+                const auto keycode = static_cast<mkr::keycode>(1 + i % (num_keycodes - 1));
+                registrations.push_back({input_helper::get_input_mask(context, controller, keycode), static_cast<input_action_t>(i)});
+            }
+            return registrations;
+        }
+
+        const input_mask_t pressed = input_helper::get_input_mask(input_context_0, controller_index_0, kc_space);
+    }
+
+    /// Finding the actions for an input by comparing it against every registered mask, as the input handlers used to.
+    void bm_compare_mask_scan(benchmark::State& _state) {
+        const auto registrations = make_registrations(static_cast<size_t>(_state.range(0)));
+        for (auto _ : _state) {
+            uint32_t num_matches = 0;
+            for (const auto& r : registrations) {
+                if (input_helper::compare_mask(r.mask_, pressed)) { ++num_matches; }
+            }
+            benchmark::DoNotOptimize(num_matches);
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+    }
+    BENCHMARK(bm_compare_mask_scan)->Arg(64)->Arg(1024)->Arg(4096);
+
+    /// Finding the actions for an input through the binding index, which only checks the registrations for the input's keycode.
+    void bm_binding_index_lookup(benchmark::State& _state) {
+        binding_index index;
+        for (const auto& r : make_registrations(static_cast<size_t>(_state.range(0)))) { index.add(r.action_, r.mask_); }
+        for (auto _ : _state) {
+            uint32_t num_matches = 0;
+            index.for_each_action(pressed, [&](input_action_t) { ++num_matches; });
+            benchmark::DoNotOptimize(num_matches);
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+    }
+    BENCHMARK(bm_binding_index_lookup)->Arg(64)->Arg(1024)->Arg(4096);
+} // mkr
\ No newline at end of file
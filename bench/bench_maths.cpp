@@ -0,0 +1,45 @@
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <maths/maths_util.h>
+#include <maths/matrix_util.h>
+#include "component/transform.h"
+
+namespace mkr {
+    namespace {
+        std::vector<transform> make_transforms(size_t _count) {
+            std::vector<transform> transforms(_count);
+            for (size_t i = 0; i < _count; ++i) {
+                const float f = static_cast<float>(i);
+                transforms[i].set_position(vector3{f, f * 0.5f, -f});
+                transforms[i].set_rotation(quaternion{vector3::y_axis(), f * maths_util::deg2rad});
+                transforms[i].set_scale(vector3{1.0f + f * 0.01f, 1.0f, 1.0f});
+            }
+            return transforms;
+        }
+    }
+
+    void bm_transform_matrix(benchmark::State& _state) {
+        const auto transforms = make_transforms(static_cast<size_t>(_state.range(0)));
+        for (auto _ : _state) {
+            for (const auto& t : transforms) {
+                benchmark::DoNotOptimize(t.transform_matrix());
+            }
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+    }
+    BENCHMARK(bm_transform_matrix)->Arg(1024);
+
+    void bm_inverse_matrix(benchmark::State& _state) {
+        const auto transforms = make_transforms(static_cast<size_t>(_state.range(0)));
+        std::vector<matrix4x4> matrices;
+        for (const auto& t : transforms) { matrices.push_back(t.transform_matrix()); }
+
+        for (auto _ : _state) {
+            for (const auto& m : matrices) {
+                benchmark::DoNotOptimize(matrix_util::inverse_matrix(m));
+            }
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+    }
+    BENCHMARK(bm_inverse_matrix)->Arg(1024);
+} // mkr
\ No newline at end of file
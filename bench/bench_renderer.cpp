@@ -0,0 +1,36 @@
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "graphics/renderer/graphics_renderer.h"
+#include "graphics/mesh/mesh_builder.h"
+#include "memory/frame_allocator.h"
+
+namespace mkr {
+    /// Arguments are the number of meshes submitted per frame, and whether they are static.
+    void bm_submit_mesh(benchmark::State& _state) {
+        auto& renderer = graphics_renderer::instance();
+        const auto sphere = mesh_builder::make_light_sphere("bench_sphere");
+        const auto cone = mesh_builder::make_light_cone("bench_cone");
+        material deferred_material;
+        material forward_material;
+        forward_material.render_path_ = render_path::forward;
+
+        const render_mesh render_meshes[] = {{&deferred_material, sphere.get()}, {&deferred_material, cone.get()}, {&forward_material, sphere.get()}};
+        std::vector<local_to_world> transforms(static_cast<size_t>(_state.range(0)));
+        for (size_t i = 0; i < transforms.size(); ++i) {
+            transforms[i].transform_ = matrix_util::translation_matrix(vector3{static_cast<float>(i), 0.0f, 0.0f});
+        }
+        const bool is_static = _state.range(1) != 0;
+
+        for (auto _ : _state) {
+            for (size_t i = 0; i < transforms.size(); ++i) {
+                renderer.submit_mesh(transforms[i], render_meshes[i % 3], is_static);
+            }
+            renderer.discard_frame();
+            frame_arena::local().reset();
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+        gfx().end_frame();
+    }
+    BENCHMARK(bm_submit_mesh)->Args({1024, 0})->Args({1024, 1})->Args({16384, 0});
+} // mkr
\ No newline at end of file
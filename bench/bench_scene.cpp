@@ -0,0 +1,111 @@
+#include <filesystem>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "scene/scene.h"
+#include "graphics/mesh/mesh_manager.h"
+#include "graphics/mesh/mesh_builder.h"
+#include "graphics/material/material_manager.h"
+#include "component/transform.h"
+#include "component/local_to_world.h"
+#include "component/render_mesh.h"
+#include "component/static_tag.h"
+
+namespace mkr {
+    namespace {
+        /// A scene of chains of entities, each the child of the one before, so that updating it propagates transforms down the hierarchy.
+        class bench_scene : public scene {
+        public:
+            bench_scene(int64_t _num_chains, int64_t _depth) {
+                for (int64_t c = 0; c < _num_chains; ++c) {
+                    auto parent = world_.entity().set<transform>(transform{vector3{static_cast<float>(c), 0.0f, 0.0f}}).add<local_to_world>();
+                    for (int64_t d = 1; d < _depth; ++d) {
+                        parent = world_.entity().set<transform>(transform{vector3{0.0f, 1.0f, 0.0f}}).add<local_to_world>().child_of(parent);
+                    }
+                }
+            }
+
+            void init() override {}
+            void pre_update() override {}
+            void post_update() override {}
+            void exit() override {}
+        };
+
+        /// A level of static meshes in a row, baked as the game's scenes are.
+        class static_bench_scene : public scene {
+        public:
+            explicit static_bench_scene(int64_t _count) {
+                // The assets are looked up by name when a scene is loaded, so they are registered with the managers once.
+                static const render_mesh rend{material_manager::instance().make_material("bench_static"),
+                                              mesh_manager::instance().add_mesh(mesh_builder::make_light_sphere("bench_static_sphere"))};
+                std::vector<transform> transforms;
+                for (int64_t i = 0; i < _count; ++i) {
+                    transforms.emplace_back(vector3{static_cast<float>(i), 0.0f, 0.0f});
+                }
+                const std::vector<render_mesh> render_meshes(transforms.size(), rend);
+                spawn(transforms, render_meshes, {world_.component<static_tag>().id()});
+                bake_static();
+            }
+
+            void init() override {}
+            void pre_update() override {}
+            void post_update() override {}
+            void exit() override {}
+
+            /// The static entities that are saved with the scene.
+            [[nodiscard]] size_t num_static_meshes() {
+                size_t count = 0;
+                world_.each([&](const transform&, const render_mesh&, const static_tag) { ++count; });
+                return count;
+            }
+
+            [[nodiscard]] size_t num_chunks() const { return static_chunks_.size(); }
+        };
+    }
+
+    /// Arguments are the number of chains and their depth.
+    void bm_scene_update(benchmark::State& _state) {
+        bench_scene s{_state.range(0), _state.range(1)};
+        for (auto _ : _state) {
+            s.update();
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0) * _state.range(1));
+    }
+    BENCHMARK(bm_scene_update)->Args({1024, 1})->Args({256, 4})->Args({64, 16});
+
+    /// Saves a baked level and loads it into a new scene. The argument is the number of static entities. Fails if the static geometry does not come back.
+    void bm_scene_save_load(benchmark::State& _state) {
+        const auto file = (std::filesystem::temp_directory_path() / "mkr_bench_scene.bin").string();
+        static_bench_scene saved{_state.range(0)};
+        size_t num_loaded = 0, num_loaded_chunks = 0;
+        for (auto _ : _state) {
+            saved.save(file);
+            static_bench_scene loaded{0};
+            loaded.load(file);
+            num_loaded = loaded.num_static_meshes();
+            num_loaded_chunks = loaded.num_chunks();
+        }
+        std::filesystem::remove(file);
+
+        if (num_loaded != saved.num_static_meshes() || num_loaded_chunks != saved.num_chunks()) {
+            _state.SkipWithError("the loaded scene lost static geometry");
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+    }
+    BENCHMARK(bm_scene_save_load)->Arg(1024);
+
+    /// Snapshots a baked level and restores it into the same scene. The argument is the number of static entities. Fails if the static geometry does not come back.
+    void bm_scene_snapshot_restore(benchmark::State& _state) {
+        static_bench_scene s{_state.range(0)};
+        const size_t num_static_meshes = s.num_static_meshes();
+        const size_t num_chunks = s.num_chunks();
+        for (auto _ : _state) {
+            s.restore(s.snapshot());
+        }
+
+        if (s.num_static_meshes() != num_static_meshes || s.num_chunks() != num_chunks) {
+            _state.SkipWithError("the restored scene lost static geometry");
+        }
+        _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+    }
+    BENCHMARK(bm_scene_snapshot_restore)->Arg(1024);
+} // mkr
\ No newline at end of file
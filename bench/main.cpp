@@ -0,0 +1,41 @@
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <log/log.h>
+#include "graphics/device/graphics_device.h"
+#include "graphics/device/null_device.h"
+#include "graphics/renderer/graphics_renderer.h"
+
+/**
+ * Runs the engine's micro-benchmarks.
+ * Graphics calls are made through the null device, so that benchmarks which create meshes or submit them to the renderer run without a GPU.
+ * Unless --benchmark_out is given, the results are also written as JSON to mkr_bench.json, so that they can be compared between runs.
+ */
+int main(int _argc, char* _argv[]) {
+    std::vector<char*> args{_argv, _argv + _argc};
+    bool has_out = false;
+    for (const std::string arg : args) {
+        if (arg.starts_with("--benchmark_out=")) { has_out = true; }
+    }
+    std::string out_arg = "--benchmark_out=mkr_bench.json";
+    std::string format_arg = "--benchmark_out_format=json";
+    if (!has_out) {
+        args.push_back(out_arg.data());
+        args.push_back(format_arg.data());
+    }
+    int argc = static_cast<int>(args.size());
+
+    mkr::log::init("./log/mkr_bench.txt");
+    mkr::null_device device;
+    mkr::graphics_device::set_current(&device);
+
+    benchmark::Initialize(&argc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(argc, args.data())) { return 1; }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    mkr::graphics_renderer::destroy();
+    mkr::graphics_device::set_current(nullptr);
+    mkr::log::exit();
+    return 0;
+}
\ No newline at end of file
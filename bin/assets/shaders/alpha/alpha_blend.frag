@@ -12,9 +12,10 @@ uniform sampler2D u_texture_revealage;
 const float epsilon = 0.00001f;
 
 void main() {
-    const vec2 tex_coord = (vs_out.frag_pos.xy / vs_out.frag_pos.w) * 0.5f + vec2(0.5f, 0.5f);
-    const vec4 accum = texture(u_texture_accumulation, tex_coord);
-    const float reveal = texture(u_texture_revealage, tex_coord).r;
+    // Read by pixel, as only part of the render targets may be rendered to.
+    const ivec2 pixel = ivec2(gl_FragCoord.xy);
+    const vec4 accum = texelFetch(u_texture_accumulation, pixel, 0);
+    const float reveal = texelFetch(u_texture_revealage, pixel, 0).r;
 
     out_colour = vec4(accum.rgb / max(accum.a, epsilon), reveal);
 }
\ No newline at end of file
@@ -17,8 +17,7 @@ in VS_OUT {
     mat3 tbn_matrix;// Converts from tangent space to camera space.
 } vs_out;
 
-#include <light.frag>
-#include <shadow.frag>
+#include <cluster.frag>
 #include <parallax.frag>
 
 // Transform
@@ -77,20 +76,17 @@ void main() {
     const vec2 tex_coord = get_tex_coord();
     const vec3 normal = get_normal(tex_coord);
 
-    bool cast_shadow[max_lights];
-    get_cast_shadow(vs_out.position, normal,
-                    u_inv_view_matrix,
-                    u_lights, u_num_lights,
-                    cast_shadow);
-
     vec3 diffuse; float alpha;
     get_diffuse(tex_coord, diffuse, alpha);
     vec3 specular; float gloss;
     get_specular(tex_coord, specular, gloss);
 
+    vec3 light_diffuse, light_specular;
+    get_lighting(vs_out.position, normal, gloss, u_inv_view_matrix, light_diffuse, light_specular);
+
     const vec3 ambient = diffuse * u_ambient_light.rgb;
-    diffuse *= get_light_diffuse(vs_out.position, normal, cast_shadow);
-    specular *= get_light_specular(vs_out.position, normal, gloss, cast_shadow);
+    diffuse *= light_diffuse;
+    specular *= light_specular;
 
     const vec3 colour = ambient + diffuse + specular;
 
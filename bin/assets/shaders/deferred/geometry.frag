@@ -1,10 +1,10 @@
 #version 460 core
 
 // IMPORTANT: All transforms in the fragment shader is in camera space, where the camera is at the origin.
-layout (location = 0) out vec3 out_position;
-layout (location = 1) out vec3 out_normal;
-layout (location = 2) out vec4 out_diffuse;
-layout (location = 3) out vec4 out_specular;
+// The position is not stored, as it is reconstructed from the depth buffer. The gloss is kept in the alpha channel of the specular colour.
+layout (location = 0) out vec2 out_normal; // Octahedron encoded.
+layout (location = 1) out vec4 out_diffuse;
+layout (location = 2) out vec4 out_specular;
 
 // Inputs
 in VS_OUT {
@@ -15,6 +15,7 @@ in VS_OUT {
 } vs_out;
 
 #include <parallax.frag>
+#include <gbuffer.frag>
 
 // Material
 uniform vec4 u_diffuse_colour;
@@ -55,8 +56,7 @@ vec4 get_specular(const in vec2 _tex_coord) {
 void main() {
     const vec2 tex_coord = get_tex_coord();
 
-    out_position = vs_out.position;
-    out_normal = get_normal(tex_coord);
+    out_normal = encode_normal(normalize(get_normal(tex_coord)));
     out_diffuse = get_diffuse(tex_coord);
     out_specular = get_specular(tex_coord);
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+#version 460 core
+
+layout (location = 0) out vec4 out_colour;
+
+#include <shadow.frag>
+#include <gbuffer.frag>
+
+// Transform
+uniform mat4 u_inv_view_matrix;
+uniform mat4 u_inv_projection_matrix;
+uniform vec2 u_viewport_size; // Only part of the render targets may be rendered to, see resolution_controller.
+
+// Light
+uniform uint u_light_index; // The index of the light in u_lights.
+
+// Textures
+uniform sampler2D u_texture_depth;
+uniform sampler2D u_texture_normal;
+uniform sampler2D u_texture_diffuse;
+uniform sampler2D u_texture_specular;
+
+// Shades the pixels covered by a light's volume, which are added on top of the ambient and directional lighting.
+void main() {
+    const ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+    const vec3 pos = reconstruct_position(gl_FragCoord.xy / u_viewport_size, texelFetch(u_texture_depth, pixel, 0).r, u_inv_projection_matrix);
+    const vec3 norm = decode_normal(texelFetch(u_texture_normal, pixel, 0).rg);
+    const vec3 diff = texelFetch(u_texture_diffuse, pixel, 0).rgb;
+
+    const vec4 spec_tex_val = texelFetch(u_texture_specular, pixel, 0);
+    const vec3 spec = spec_tex_val.rgb;
+    const float gloss = spec_tex_val.a;
+
+    const light l = u_lights[u_light_index];
+    if (cast_shadow(l, pos, norm, u_inv_view_matrix)) { discard; }
+
+    vec3 light_diffuse = vec3(0.0f, 0.0f, 0.0f);
+    vec3 light_specular = vec3(0.0f, 0.0f, 0.0f);
+    accumulate_light(l, pos, norm, gloss, light_diffuse, light_specular);
+
+    out_colour = vec4(diff * light_diffuse + spec * light_specular, 0.0f); // Alpha is left as it is by the additive blend.
+}
\ No newline at end of file
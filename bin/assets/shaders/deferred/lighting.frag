@@ -7,39 +7,47 @@ in VS_OUT {
     vec2 tex_coord;
 } vs_out;
 
-#include <light.frag>
-#include <shadow.frag>
+#include <cluster.frag>
+#include <gbuffer.frag>
 
 // Transform
 uniform mat4 u_inv_view_matrix;
+uniform mat4 u_inv_projection_matrix;
+uniform vec2 u_viewport_size; // Only part of the render targets may be rendered to, see resolution_controller.
+
+// Lights
+uniform bool u_directional_only; // Point and spot lights are drawn separately as light volumes.
 
 // Textures
-uniform sampler2D u_texture_position;
+uniform sampler2D u_texture_depth;
 uniform sampler2D u_texture_normal;
 uniform sampler2D u_texture_diffuse;
 uniform sampler2D u_texture_specular;
 
 void main() {
-    const vec3 pos = texture(u_texture_position, vs_out.tex_coord).rgb;
-    const vec3 norm = texture(u_texture_normal, vs_out.tex_coord).rgb;
+    // The screen quad covers the rendered region, which may be smaller than the render targets, so the G-buffer is read by pixel.
+    const ivec2 pixel = ivec2(gl_FragCoord.xy);
+    const vec3 pos = reconstruct_position(gl_FragCoord.xy / u_viewport_size, texelFetch(u_texture_depth, pixel, 0).r, u_inv_projection_matrix);
+    const vec3 norm = decode_normal(texelFetch(u_texture_normal, pixel, 0).rg);
 
-    const vec4 diff_tex_val = texture(u_texture_diffuse, vs_out.tex_coord);
+    const vec4 diff_tex_val = texelFetch(u_texture_diffuse, pixel, 0);
     const vec3 diff = diff_tex_val.rgb;
     const float alpha = diff_tex_val.a;
 
-    const vec4 spec_tex_val = texture(u_texture_specular, vs_out.tex_coord);
+    const vec4 spec_tex_val = texelFetch(u_texture_specular, pixel, 0);
     const vec3 spec = spec_tex_val.rgb;
     const float gloss = spec_tex_val.a;
 
-    bool cast_shadow[max_lights];
-    get_cast_shadow(pos, norm,
-                    u_inv_view_matrix,
-                    u_lights, u_num_lights,
-                    cast_shadow);
+    vec3 light_diffuse, light_specular;
+    if (u_directional_only) {
+        get_directional_lighting(pos, norm, gloss, u_inv_view_matrix, light_diffuse, light_specular);
+    } else {
+        get_lighting(pos, norm, gloss, u_inv_view_matrix, light_diffuse, light_specular);
+    }
 
     const vec3 ambient = diff * u_ambient_light.rgb;
-    const vec3 diffuse = diff * get_light_diffuse(pos, norm, cast_shadow);
-    const vec3 specular = spec * get_light_specular(pos, norm, gloss, cast_shadow);
+    const vec3 diffuse = diff * light_diffuse;
+    const vec3 specular = spec * light_specular;
     const vec3 colour = ambient + diffuse + specular;
 
     out_colour = vec4(colour, alpha);
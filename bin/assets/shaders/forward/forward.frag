@@ -7,8 +7,7 @@
    By using glBindFragDataLocation(GLuint program, GLuint colorNumber, const char * name), it is not necessary to use the layout qualifier and vice-versa.
    However, if both are used and are in conflict, the layout qualifier in the vertex shader has priority. */
 layout (location = 0) out vec4 out_colour;
-layout (location = 1) out vec3 out_position;
-layout (location = 2) out vec3 out_normal;
+layout (location = 1) out vec2 out_normal; // Octahedron encoded, the same as in the G-buffer.
 
 // Inputs
 in VS_OUT {
@@ -18,9 +17,9 @@ in VS_OUT {
     mat3 tbn_matrix;// Converts from tangent space to camera space.
 } vs_out;
 
-#include <light.frag>
-#include <shadow.frag>
+#include <cluster.frag>
 #include <parallax.frag>
+#include <gbuffer.frag>
 
 // Transform
 uniform mat4 u_view_matrix;
@@ -78,24 +77,20 @@ void main() {
     const vec2 tex_coord = get_tex_coord();
     const vec3 normal = get_normal(tex_coord);
 
-    bool cast_shadow[max_lights];
-    get_cast_shadow(vs_out.position, normal,
-                    u_inv_view_matrix,
-                    u_lights, u_num_lights,
-                    cast_shadow);
-
     vec3 diffuse; float alpha;
     get_diffuse(tex_coord, diffuse, alpha);
     vec3 specular; float gloss;
     get_specular(tex_coord, specular, gloss);
 
+    vec3 light_diffuse, light_specular;
+    get_lighting(vs_out.position, normal, gloss, u_inv_view_matrix, light_diffuse, light_specular);
+
     const vec3 ambient = diffuse * u_ambient_light.rgb;
-    diffuse *= get_light_diffuse(vs_out.position, normal, cast_shadow);
-    specular *= get_light_specular(vs_out.position, normal, gloss, cast_shadow);
+    diffuse *= light_diffuse;
+    specular *= light_specular;
 
     const vec3 colour = ambient + diffuse + specular;
 
     out_colour = vec4(colour, alpha);
-    out_position = vs_out.position;
-    out_normal = vs_out.normal;
+    out_normal = encode_normal(normalize(vs_out.normal));
 }
\ No newline at end of file
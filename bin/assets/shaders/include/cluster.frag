@@ -0,0 +1,36 @@
+#include <light.frag>
+#include <shadow.frag>
+
+uint get_cluster_index(const in vec2 _frag_coord, float _view_depth) {
+    const uvec2 tile = min(uvec2(_frag_coord / u_cluster_params.xy), u_cluster_dims.xy - uvec2(1, 1));
+    const uint slice = uint(clamp(floor(log(_view_depth) * u_cluster_params.z - u_cluster_params.w), 0.0f, float(u_cluster_dims.z - 1)));
+    return tile.x + tile.y * u_cluster_dims.x + slice * u_cluster_dims.x * u_cluster_dims.y;
+}
+
+// Evaluate the directional lights only.
+void get_directional_lighting(const in vec3 _pos, const in vec3 _normal, float _gloss,
+                              const in mat4 _inv_view_matrix,
+                              out vec3 _diffuse, out vec3 _specular) {
+    _diffuse = vec3(0.0f, 0.0f, 0.0f);
+    _specular = vec3(0.0f, 0.0f, 0.0f);
+
+    for (uint i = 0; i < u_cluster_dims.w; ++i) {
+        if (cast_shadow(u_lights[i], _pos, _normal, _inv_view_matrix)) { continue; }
+        accumulate_light(u_lights[i], _pos, _normal, _gloss, _diffuse, _specular);
+    }
+}
+
+// Evaluate the directional lights, and the lights in the cluster of the fragment being shaded.
+void get_lighting(const in vec3 _pos, const in vec3 _normal, float _gloss,
+                  const in mat4 _inv_view_matrix,
+                  out vec3 _diffuse, out vec3 _specular) {
+    get_directional_lighting(_pos, _normal, _gloss, _inv_view_matrix, _diffuse, _specular);
+
+    // In OpenGL convention, the camera looks down the -z axis.
+    const uvec2 cluster = u_light_grid[get_cluster_index(gl_FragCoord.xy, -_pos.z)];
+    for (uint i = 0; i < cluster.y; ++i) {
+        const light l = u_lights[u_light_indices[cluster.x + i]];
+        if (cast_shadow(l, _pos, _normal, _inv_view_matrix)) { continue; }
+        accumulate_light(l, _pos, _normal, _gloss, _diffuse, _specular);
+    }
+}
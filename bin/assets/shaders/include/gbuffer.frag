@@ -0,0 +1,28 @@
+// Encoding and decoding of the compact G-buffer.
+
+// Octahedral normal encoding. The unit sphere is projected onto an octahedron, which is unfolded into a square.
+// Stored in a rg16 texture, this keeps a normal in 4 bytes with an error well below what lighting can show.
+// rg16 is used over rg16_snorm, as snorm formats are not required to be colour-renderable, so the encoding is remapped into the [0, 1] range.
+vec2 oct_wrap(const in vec2 _v) {
+    return (vec2(1.0f, 1.0f) - abs(_v.yx)) * vec2(_v.x >= 0.0f ? 1.0f : -1.0f, _v.y >= 0.0f ? 1.0f : -1.0f);
+}
+
+vec2 encode_normal(const in vec3 _normal) {
+    const vec3 n = _normal / (abs(_normal.x) + abs(_normal.y) + abs(_normal.z));
+    const vec2 encoded = (n.z >= 0.0f) ? n.xy : oct_wrap(n.xy);
+    return encoded * 0.5f + vec2(0.5f, 0.5f); // Convert into the [0, 1] range.
+}
+
+vec3 decode_normal(const in vec2 _encoded) {
+    const vec2 e = _encoded * 2.0f - vec2(1.0f, 1.0f); // Convert into the [-1, 1] range.
+    vec3 n = vec3(e, 1.0f - abs(e.x) - abs(e.y));
+    if (n.z < 0.0f) { n.xy = oct_wrap(n.xy); }
+    return normalize(n);
+}
+
+// Reconstruct the camera space position of a pixel from the depth buffer, rather than storing it.
+vec3 reconstruct_position(const in vec2 _tex_coord, float _depth, const in mat4 _inv_projection_matrix) {
+    const vec4 ndc_pos = vec4(_tex_coord * 2.0f - vec2(1.0f, 1.0f), _depth * 2.0f - 1.0f, 1.0f); // Convert from the [0, 1] range to the [-1, 1] range.
+    const vec4 view_pos = _inv_projection_matrix * ndc_pos;
+    return view_pos.xyz / view_pos.w;
+}
\ No newline at end of file
@@ -1,34 +1,55 @@
 // Constants
-const int max_lights = 4;
-
 const int light_point = 0;
 const int light_spot = 1;
 const int light_directional = 2;
 
 // Light
+// Must match the layout of gpu_light in light_clusters.h!
 struct light {
-    int mode_;
-    float power_;
     vec4 colour_;
 
+    vec3 position_;
+    float power_;
+
+    vec3 direction_;
+    int mode_;
+
     float attenuation_constant_;
     float attenuation_linear_;
     float attenuation_quadratic_;
+    float range_;
 
     float spotlight_inner_cosine_;
     float spotlight_outer_cosine_;
-
-    vec3 position_;
-    vec3 direction_;
-
     float shadow_distance_;
+    int shadow_index_;
+
     mat4 view_projection_matrix_;
 };
 
 // Uniforms
-uniform int u_num_lights;
 uniform vec4 u_ambient_light;
-uniform light u_lights[max_lights];
+
+// Storage Buffers
+// Must match storage_binding in storage_binding.h!
+layout (std430, binding = 0) readonly buffer light_cluster_info {
+    uvec4 u_cluster_dims; // The number of clusters in x, y and z, and the number of directional lights.
+    vec4 u_cluster_params; // The tile width and height in pixels, and the depth slice scale and bias.
+};
+
+// Every light. Directional lights are at the front.
+layout (std430, binding = 1) readonly buffer light_list {
+    light u_lights[];
+};
+
+// The offset and count into u_light_indices of the lights in each cluster.
+layout (std430, binding = 2) readonly buffer light_grid {
+    uvec2 u_light_grid[];
+};
+
+layout (std430, binding = 3) readonly buffer light_index_list {
+    uint u_light_indices[];
+};
 
 float light_attenuation(const in vec3 _pos,
                         const in vec3 _light_pos,
@@ -64,56 +85,19 @@ float specular_intensity(const in vec3 _pos, const in vec3 _normal,
     return pow(max(dot(reflect(light_to_frag, _normal), view_dir), 0.0f), 32.0f * _gloss);
 }
 
-vec3 get_light_diffuse(const in vec3 _pos, const in vec3 _normal, const in bool _cast_shadow[max_lights]) {
-    vec3 colour = vec3(0.0f, 0.0f, 0.0f);
-    for (int i = 0; i < u_num_lights; ++i) {
-        if (_cast_shadow[i]) { continue; } // Check if there is shadow.
-        switch (u_lights[i].mode_) {
-            case light_point:
-                colour += diffuse_intensity(_pos, _normal, u_lights[i].position_, u_lights[i].direction_, false) *
-                u_lights[i].colour_.rgb * u_lights[i].power_ *
-                light_attenuation(_pos, u_lights[i].position_, u_lights[i].attenuation_constant_, u_lights[i].attenuation_linear_, u_lights[i].attenuation_quadratic_);
-                break;
-            case light_spot:
-                colour += diffuse_intensity(_pos, _normal, u_lights[i].position_, u_lights[i].direction_, false) *
-                u_lights[i].colour_.rgb * u_lights[i].power_ *
-                light_attenuation(_pos, u_lights[i].position_, u_lights[i].attenuation_constant_, u_lights[i].attenuation_linear_, u_lights[i].attenuation_quadratic_) *
-                spotlight_effect(_pos, u_lights[i].position_, u_lights[i].direction_, u_lights[i].spotlight_inner_cosine_, u_lights[i].spotlight_outer_cosine_);
-                break;
-            case light_directional:
-                colour += diffuse_intensity(_pos, _normal, u_lights[i].position_, u_lights[i].direction_, true) *
-                u_lights[i].colour_.rgb * u_lights[i].power_;
-                break;
-            default:
-                break;
-        }
+void accumulate_light(const in light _light,
+                      const in vec3 _pos, const in vec3 _normal, float _gloss,
+                      inout vec3 _diffuse, inout vec3 _specular) {
+    const bool is_dir_light = _light.mode_ == light_directional;
+    float intensity = _light.power_;
+    if (!is_dir_light) {
+        intensity *= light_attenuation(_pos, _light.position_, _light.attenuation_constant_, _light.attenuation_linear_, _light.attenuation_quadratic_);
     }
-    return colour;
-}
-
-vec3 get_light_specular(const in vec3 _pos, const in vec3 _normal, float _gloss, const in bool _cast_shadow[max_lights]) {
-    vec3 colour = vec3(0.0f, 0.0f, 0.0f);
-    for (int i = 0; i < u_num_lights; ++i) {
-        if (_cast_shadow[i]) { continue; } // Check if there is shadow.
-        switch (u_lights[i].mode_) {
-            case light_point:
-                colour += specular_intensity(_pos, _normal, u_lights[i].position_, u_lights[i].direction_, false, _gloss) *
-                u_lights[i].colour_.rgb * u_lights[i].power_ *
-                light_attenuation(_pos, u_lights[i].position_, u_lights[i].attenuation_constant_, u_lights[i].attenuation_linear_, u_lights[i].attenuation_quadratic_);
-                break;
-            case light_spot:
-                colour += specular_intensity(_pos, _normal, u_lights[i].position_, u_lights[i].direction_, false, _gloss) *
-                u_lights[i].colour_.rgb * u_lights[i].power_ *
-                light_attenuation(_pos, u_lights[i].position_, u_lights[i].attenuation_constant_, u_lights[i].attenuation_linear_, u_lights[i].attenuation_quadratic_) *
-                spotlight_effect(_pos, u_lights[i].position_, u_lights[i].direction_, u_lights[i].spotlight_inner_cosine_, u_lights[i].spotlight_outer_cosine_);
-                break;
-            case light_directional:
-                colour += specular_intensity(_pos, _normal, u_lights[i].position_, u_lights[i].direction_, true, _gloss) *
-                u_lights[i].colour_.rgb * u_lights[i].power_;
-                break;
-            default:
-                break;
-        }
+    if (_light.mode_ == light_spot) {
+        intensity *= spotlight_effect(_pos, _light.position_, _light.direction_, _light.spotlight_inner_cosine_, _light.spotlight_outer_cosine_);
     }
-    return colour;
-}
\ No newline at end of file
+
+    const vec3 colour = _light.colour_.rgb * intensity;
+    _diffuse += diffuse_intensity(_pos, _normal, _light.position_, _light.direction_, is_dir_light) * colour;
+    _specular += specular_intensity(_pos, _normal, _light.position_, _light.direction_, is_dir_light, _gloss) * colour;
+}
@@ -1,10 +1,29 @@
 #include <light.frag>
 
+// Constants
+const int max_cascades = 4; // Must match lighting::max_cascades!
+
+// Shadows
+// Must match the layout of gpu_shadow in shadow_atlas.h!
+struct shadow {
+    mat4 view_projection_matrices_[max_cascades]; // Spot lights only use the first.
+    vec4 tile_rects_[max_cascades]; // The offset (xy) and scale (zw) of each cascade's tile in the shadow atlas. Spot lights only use the first.
+    vec4 split_distances_; // The far distance of each cascade from the camera.
+    int num_cascades_;
+    int cubemap_layer_; // For point lights, the layer of the shadow cubemap array.
+};
+
 // Uniforms
-uniform sampler2D u_texture_shadows[max_lights];
-uniform samplerCube u_cubemap_shadows[max_lights];
+uniform sampler2D u_shadow_atlas; // The shadow maps of spot and directional lights, as tiles of a single texture.
+uniform samplerCubeArray u_shadow_cubemaps; // The shadow maps of point lights, one per layer.
 
-bool cast_point_shadow(const in samplerCube _cubemap,
+// Storage Buffers
+// Indexed by the light's shadow index.
+layout (std430, binding = 4) readonly buffer shadow_list {
+    shadow u_shadows[];
+};
+
+bool cast_point_shadow(const in shadow _shadow,
                        const in vec3 _pos, const in vec3 _normal,
                        const in mat4 _inv_view_matrix,
                        const in vec3 _light_pos,
@@ -16,7 +35,7 @@ bool cast_point_shadow(const in samplerCube _cubemap,
     const vec3 tex_coord = (frag_world_pos - light_world_pos).xyz; // No need to normalise the tex_coord for a cubemap.
 
     // Distance from light to shadow.
-    const float shadow_dist = texture(_cubemap, tex_coord).r;
+    const float shadow_dist = texture(u_shadow_cubemaps, vec4(tex_coord, float(_shadow.cubemap_layer_))).r;
 
     // Distance from light to fragment.
     const float frag_dist = length(_pos - _light_pos) / _cast_dist; // Normalise to the [0, 1] range.
@@ -26,18 +45,19 @@ bool cast_point_shadow(const in samplerCube _cubemap,
 
 }
 
-bool cast_spot_shadow(const in sampler2D _texture,
+bool cast_spot_shadow(const in shadow _shadow,
                       const in vec3 _pos, const in vec3 _normal,
                       const in mat4 _inv_view_matrix,
-                      const in mat4 _light_vp_mat, const in vec3 _light_dir) {
+                      const in vec3 _light_dir) {
     const float bias = 0.001f;
 
-    const vec4 light_clip_pos = _light_vp_mat * _inv_view_matrix * vec4(_pos, 1.0f); // Fragment position in the light's clip space.
+    const vec4 light_clip_pos = _shadow.view_projection_matrices_[0] * _inv_view_matrix * vec4(_pos, 1.0f); // Fragment position in the light's clip space.
     const vec3 light_ndc_pos = light_clip_pos.xyz / light_clip_pos.w; // Fragment position in the light's NDC space.
     const vec2 tex_coord = (light_ndc_pos.xy * 0.5f) + vec2(0.5f, 0.5f); // Normalise from the [-1, 1] range to the [0, 1] range.
 
     // Distance from light to shadow.
-    const float shadow_dist = texture(_texture, tex_coord).r;
+    const vec4 tile = _shadow.tile_rects_[0];
+    const float shadow_dist = texture(u_shadow_atlas, tile.xy + tex_coord * tile.zw).r;
 
     // Distance from light to fragment.
     const float frag_dist = 0.5f * light_ndc_pos.z + 0.5f; // Normalise from the [-1, 1] range to the [0, 1] range.
@@ -48,21 +68,50 @@ bool cast_spot_shadow(const in sampler2D _texture,
            0.0f <= tex_coord.y && tex_coord.y <= 1.0f;
 }
 
-bool cast_directional_shadow(const in sampler2D _texture,
+bool cast_directional_shadow(const in shadow _shadow,
                              const in vec3 _pos, const in vec3 _normal,
                              const in mat4 _inv_view_matrix,
-                             const in mat4 _light_vp_mat, const in vec3 _light_dir) {
-    return cast_spot_shadow(_texture, _pos, _normal, _inv_view_matrix, _light_vp_mat, _light_dir);
+                             const in vec3 _light_dir) {
+    const float bias = 0.001f;
+
+    // Use the first cascade that contains the fragment. In OpenGL convention, the camera looks down the -z axis.
+    const float view_depth = -_pos.z;
+    const int last_cascade = _shadow.num_cascades_ - 1;
+    if (view_depth > _shadow.split_distances_[last_cascade]) { return false; }
+    int cascade = 0;
+    while (cascade < last_cascade && view_depth > _shadow.split_distances_[cascade]) { ++cascade; }
+
+    const vec4 light_clip_pos = _shadow.view_projection_matrices_[cascade] * _inv_view_matrix * vec4(_pos, 1.0f); // Fragment position in the cascade's clip space.
+    const vec3 light_ndc_pos = light_clip_pos.xyz / light_clip_pos.w; // Fragment position in the cascade's NDC space.
+    const vec2 tex_coord = (light_ndc_pos.xy * 0.5f) + vec2(0.5f, 0.5f); // Normalise from the [-1, 1] range to the [0, 1] range.
+
+    // Distance from light to shadow. Every cascade is rendered into its own tile of the shadow atlas.
+    const vec4 tile = _shadow.tile_rects_[cascade];
+    const float shadow_dist = texture(u_shadow_atlas, tile.xy + tex_coord * tile.zw).r;
+
+    // Distance from light to fragment.
+    const float frag_dist = 0.5f * light_ndc_pos.z + 0.5f; // Normalise from the [-1, 1] range to the [0, 1] range.
+
+    return shadow_dist + bias < frag_dist && // Is the shadow closer to the light than the fragment?
+           dot(_light_dir, _normal) < 0.0f && // Only cast shadows on surfaces facing the light.
+           0.0f <= tex_coord.x && tex_coord.x <= 1.0f && // Ensure that the fragment is inside the cascade.
+           0.0f <= tex_coord.y && tex_coord.y <= 1.0f;
 }
 
-void get_cast_shadow(const in vec3 _position, const in vec3 _normal,
-                     const in mat4 _inv_view_matrix,
-                     const in light _lights[max_lights],
-                     int _num_lights,
-                     inout bool cast_shadow[max_lights]) {
-    for (int i = 0; i < _num_lights; ++i) {
-        cast_shadow[i] = (_lights[i].mode_ == light_point && cast_point_shadow(u_cubemap_shadows[i], _position, _normal, _inv_view_matrix, _lights[i].position_, _lights[i].shadow_distance_)) ||
-        (_lights[i].mode_ == light_spot && cast_spot_shadow(u_texture_shadows[i], _position, _normal, _inv_view_matrix, _lights[i].view_projection_matrix_, _lights[i].direction_)) ||
-        (_lights[i].mode_ == light_directional && cast_directional_shadow(u_texture_shadows[i], _position, _normal, _inv_view_matrix, _lights[i].view_projection_matrix_, _lights[i].direction_));
+bool cast_shadow(const in light _light,
+                 const in vec3 _pos, const in vec3 _normal,
+                 const in mat4 _inv_view_matrix) {
+    if (_light.shadow_index_ < 0) { return false; } // The light does not have a shadow map.
+
+    const shadow s = u_shadows[_light.shadow_index_];
+    switch (_light.mode_) {
+        case light_point:
+            return cast_point_shadow(s, _pos, _normal, _inv_view_matrix, _light.position_, _light.shadow_distance_);
+        case light_spot:
+            return cast_spot_shadow(s, _pos, _normal, _inv_view_matrix, _light.direction_);
+        case light_directional:
+            return cast_directional_shadow(s, _pos, _normal, _inv_view_matrix, _light.direction_);
+        default:
+            return false;
     }
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
 #version 460 core
 
 // Inputs
-in GS_OUT {
+in VS_OUT {
     vec2 tex_coord;
     vec4 frag_pos;
-} gs_out;
+} vs_out;
 
 uniform vec3 u_light_pos;
 uniform float u_shadow_distance;
@@ -19,13 +19,13 @@ void main() {
         // Discard transparent fragments.
         float alpha = u_diffuse_colour.a;
         if (u_has_texture_diffuse) {
-            alpha *= texture(u_texture_diffuse, gs_out.tex_coord).a;
+            alpha *= texture(u_texture_diffuse, vs_out.tex_coord).a;
         }
         if (alpha < 0.9f) { discard; }
     }
 
     // Get distance between fragment and light source.
-    float distance = length(gs_out.frag_pos.xyz - u_light_pos);
+    float distance = length(vs_out.frag_pos.xyz - u_light_pos);
     // Map to [0, 1] range by dividing by shadow distance.
     gl_FragDepth = distance / u_shadow_distance;
 }
\ No newline at end of file
@@ -13,13 +13,16 @@ layout(location = 8) in mat3 v_normal_matrix; // Unused. Set to identity matrix.
 // Outputs
 out VS_OUT {
     vec2 tex_coord;
+    vec4 frag_pos;
 } vs_out;
 
 // Uniforms
+uniform mat4 u_view_projection_matrix; // The view projection matrix of the cubemap face being rendered.
 uniform vec2 u_texture_offset;
 uniform vec2 u_texture_scale;
 
 void main() {
     vs_out.tex_coord = (v_tex_coord + u_texture_offset) * u_texture_scale;
-    gl_Position = v_model_matrix * vec4(v_position, 1.0f);
+    vs_out.frag_pos = v_model_matrix * vec4(v_position, 1.0f);
+    gl_Position = u_view_projection_matrix * vs_out.frag_pos;
 }
\ No newline at end of file
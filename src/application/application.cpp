@@ -1,11 +1,18 @@
+#include <algorithm>
+#include <cmath>
 #include <SDL2/SDL.h>
 #include <log/log.h>
 #include "application/application.h"
+#include "application/command_line.h"
 #include "application/sdl_message_pump.h"
+#include "event/event_bus.h"
 #include "input/input_manager.h"
 #include "graphics/renderer/graphics_renderer.h"
 #include "graphics/texture/texture_loader.h"
 #include "scene/scene_manager.h"
+#include "memory/frame_allocator.h"
+#include "memory/allocation_counter.h"
+#include "memory/memory_tracker.h"
 
 namespace mkr {
     void application::run() {
@@ -20,6 +27,11 @@ namespace mkr {
         // Initialise logging first to allow systems to start logging.
         log::init();
 
+        // The ECS allocations are tracked. The hook installs flecs' OS API with tracked allocators, so it must run before the first world is created,
+        // which includes constructing any scene. Allocations made by a world created earlier would be freed through the wrong allocator.
+        memory_tracker::hook_ecs();
+        load_memory_budgets();
+
         // Message Pump
         sdl_message_pump::instance().init();
 
@@ -28,6 +40,13 @@ namespace mkr {
         input_manager::instance().init();
         graphics_renderer::instance().init();
         scene_manager::instance().init();
+
+        // Profiling. Runs with a fixed number of frames, and headless and null graphics device runs, are benchmarks, so they are always profiled.
+        const auto& cmd = command_line::instance();
+        max_frames_ = static_cast<uint64_t>(std::max(cmd.get_int("frames", 0), 0));
+        profile_file_ = cmd.get_string("report", "");
+        const bool is_benchmark = max_frames_ > 0 || !profile_file_.empty() || cmd.has("headless") || cmd.get_string("graphics-device", "gl") == "null";
+        profiler_.set_enabled(cmd.has("profile") || is_benchmark, static_cast<size_t>(max_frames_));
     }
 
     void application::start() {
@@ -43,20 +62,105 @@ namespace mkr {
         while (run_) {
             prev_frame_time = curr_frame_time;
             curr_frame_time = SDL_GetPerformanceCounter();
-            delta_time_ = static_cast<float>(curr_frame_time - prev_frame_time) / static_cast<float>(SDL_GetPerformanceFrequency());
+            delta_time_ = fixed_frame_time_ ? fixed_delta_time_ : static_cast<float>(curr_frame_time - prev_frame_time) / static_cast<float>(SDL_GetPerformanceFrequency());
             time_elapsed_ += delta_time_;
 
+            profiler_.begin_frame();
+
             // Message Pump
             sdl_message_pump::instance().update();
 
-            // Systems
+            // Systems. Queued events are delivered in batches between them.
+            auto& bus = event_bus::instance();
             input_manager::instance().update();
+            bus.deliver(event_phase::input);
+            profiler_.end_phase(frame_phase::input);
+            fixed_update();
+            bus.deliver(event_phase::simulation);
+            profiler_.end_phase(frame_phase::simulation);
             scene_manager::instance().update();
+            bus.deliver(event_phase::render);
+            profiler_.end_phase(frame_phase::scene);
             graphics_renderer::instance().update();
+            profiler_.end_phase(frame_phase::render);
+            bus.end_frame();
+
+            // Release this frame's transient allocations.
+            frame_arena::local().reset();
+            report_allocations();
+            memory_tracker::update(delta_time_);
+            profiler_.end_frame(frame_allocations_, graphics_renderer::instance().stats());
+
+            if (max_frames_ != 0 && ++num_frames_ >= max_frames_) { terminate(); }
+        }
+    }
+
+    void application::report_allocations() {
+        const uint64_t num_allocations = allocation_counter::thread_count();
+        frame_allocations_ = num_allocations - prev_allocation_count_;
+        prev_allocation_count_ = num_allocations;
+
+        // Only report once a second, as logging allocates too.
+        if (frame_allocations_ > 0) { ++frames_with_allocations_; }
+        if (time_elapsed_ - last_allocation_report_ >= 1.0f) {
+            if (frames_with_allocations_ > 0) {
+                MKR_CORE_DEBUG("{} frame(s) allocated from the heap in the last {}s. Busiest frame arena use so far: {} bytes.",
+                               frames_with_allocations_, time_elapsed_ - last_allocation_report_, frame_arena::local().peak());
+            }
+            frames_with_allocations_ = 0;
+            last_allocation_report_ = time_elapsed_;
         }
     }
 
+    void application::load_memory_budgets() {
+        // Budgets are given in megabytes, such as --memory-budget-mesh=64 or --memory-budget-gpu-texture=512.
+        const auto& cmd = command_line::instance();
+        constexpr uint64_t mb = 1024 * 1024;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(memory_tag::num_memory_tags); ++i) {
+            const auto tag = static_cast<memory_tag>(i);
+            const int budget = cmd.get_int(std::string{"memory-budget-"} + memory_tracker::name(tag), 0);
+            if (budget > 0) { memory_tracker::set_budget(tag, static_cast<uint64_t>(budget) * mb); }
+        }
+        for (uint32_t i = 0; i < static_cast<uint32_t>(gpu_memory_tag::num_gpu_memory_tags); ++i) {
+            const auto tag = static_cast<gpu_memory_tag>(i);
+            const int budget = cmd.get_int(std::string{"memory-budget-gpu-"} + memory_tracker::name(tag), 0);
+            if (budget > 0) { memory_tracker::set_budget(tag, static_cast<uint64_t>(budget) * mb); }
+        }
+    }
+
+    void application::fixed_update() {
+        fixed_time_accumulator_ += delta_time_;
+
+        uint32_t num_steps = 0;
+        while (fixed_time_accumulator_ >= fixed_delta_time_ && num_steps < max_fixed_steps_) {
+            scene_manager::instance().fixed_update();
+            fixed_time_accumulator_ -= fixed_delta_time_;
+            ++num_steps;
+        }
+
+        // Drop whatever could not be simulated this frame instead of trying to catch up on it later.
+        if (fixed_time_accumulator_ >= fixed_delta_time_) {
+            const float remainder = std::fmod(fixed_time_accumulator_, fixed_delta_time_);
+            dropped_simulation_time_ += fixed_time_accumulator_ - remainder;
+            fixed_time_accumulator_ = remainder;
+        }
+
+        // Only report once a second, as logging allocates too, and falling behind usually lasts many frames.
+        if (time_elapsed_ - last_dropped_report_ >= 1.0f) {
+            if (dropped_simulation_time_ > 0.0f) {
+                MKR_CORE_WARN("Simulation fell behind, dropped {}s in the last {}s.", dropped_simulation_time_, time_elapsed_ - last_dropped_report_);
+            }
+            dropped_simulation_time_ = 0.0f;
+            last_dropped_report_ = time_elapsed_;
+        }
+
+        interpolation_alpha_ = fixed_time_accumulator_ / fixed_delta_time_;
+    }
+
     void application::stop() {
+        profiler_.log();
+        if (!profile_file_.empty()) { profiler_.write_csv(profile_file_); }
+        memory_tracker::dump();
     }
 
     void application::exit() {
@@ -77,6 +181,9 @@ namespace mkr {
         graphics_renderer::destroy();
         scene_manager::destroy();
 
+        // Destroy the event bus after everything that listens to it.
+        event_bus::destroy();
+
         // Exit logging last to allow systems to keep logging till the end.
         log::exit();
     }
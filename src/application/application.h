@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <string>
 #include <common/singleton.h>
+#include "application/frame_profiler.h"
 
 namespace mkr {
     class application : public singleton<application> {
@@ -13,6 +15,31 @@ namespace mkr {
         float delta_time_ = 0.0f;
         /// The duration that has passed since the application started.
         float time_elapsed_ = 0.0f;
+        /// The duration of a single simulation step. Gameplay systems are stepped at this fixed rate, independent of the frame rate.
+        float fixed_delta_time_ = 1.0f / 60.0f;
+        /// The maximum number of simulation steps per frame. Once exceeded, the remaining time is dropped so that a slow frame cannot cause an ever-growing backlog.
+        uint32_t max_fixed_steps_ = 5;
+        /// The frame time that has not yet been consumed by a simulation step.
+        float fixed_time_accumulator_ = 0.0f;
+        /// How far the current frame is between the previous and the latest simulation step, in the range [0, 1).
+        float interpolation_alpha_ = 0.0f;
+        /// The simulation time dropped since it was last reported.
+        float dropped_simulation_time_ = 0.0f;
+        float last_dropped_report_ = 0.0f;
+        /// The number of heap allocations made by the main thread in the last frame.
+        uint64_t frame_allocations_ = 0;
+        uint64_t prev_allocation_count_ = 0;
+        uint32_t frames_with_allocations_ = 0;
+        float last_allocation_report_ = 0.0f;
+        /// Advance every frame by exactly fixed_delta_time_, rather than by the time the frame took, so that runs are reproducible.
+        bool fixed_frame_time_ = false;
+        /// Records the time taken by every frame and its phases, when profiling.
+        frame_profiler profiler_;
+        /// Set with --report=<file>. Every profiled frame is written to it as CSV.
+        std::string profile_file_;
+        /// Stop the application after this many frames, set with --frames=N. 0 runs until the application is closed.
+        uint64_t max_frames_ = 0;
+        uint64_t num_frames_ = 0;
         /// A flag to exit the game loop. Set to false to quit the application.
         std::atomic_bool run_ = true;
 
@@ -22,12 +49,24 @@ namespace mkr {
         void init();
         void start();
         void update();
+        void fixed_update();
+        void report_allocations();
+        void load_memory_budgets();
         void stop();
         void exit();
 
     public:
         inline float delta_time() const { return delta_time_; }
         inline float time_elapsed() const { return time_elapsed_; }
+        inline float fixed_delta_time() const { return fixed_delta_time_; }
+        inline void set_fixed_delta_time(float _fixed_delta_time) { fixed_delta_time_ = _fixed_delta_time; }
+        inline uint32_t max_fixed_steps() const { return max_fixed_steps_; }
+        inline void set_max_fixed_steps(uint32_t _max_fixed_steps) { max_fixed_steps_ = _max_fixed_steps; }
+        inline float interpolation_alpha() const { return interpolation_alpha_; }
+        inline bool fixed_frame_time() const { return fixed_frame_time_; }
+        inline void set_fixed_frame_time(bool _fixed_frame_time) { fixed_frame_time_ = _fixed_frame_time; }
+        inline uint64_t frame_allocations() const { return frame_allocations_; }
+        inline const frame_profiler& profiler() const { return profiler_; }
         inline void terminate() { run_ = false; }
         virtual void run();
     };
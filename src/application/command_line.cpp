@@ -0,0 +1,49 @@
+#include <stdexcept>
+#include "application/command_line.h"
+
+namespace mkr {
+    void command_line::parse(int _argc, char* _argv[]) {
+        for (int i = 1; i < _argc; ++i) {
+            const std::string arg = _argv[i];
+            if (!arg.starts_with("--")) {
+                continue;
+            }
+
+            const auto separator = arg.find('=');
+            if (separator == std::string::npos) {
+                options_[arg.substr(2)] = "";
+            } else {
+                options_[arg.substr(2, separator - 2)] = arg.substr(separator + 1);
+            }
+        }
+    }
+
+    bool command_line::has(const std::string& _name) const {
+        return options_.contains(_name);
+    }
+
+    std::string command_line::get_string(const std::string& _name, const std::string& _default) const {
+        auto iter = options_.find(_name);
+        return iter == options_.end() ? _default : iter->second;
+    }
+
+    int command_line::get_int(const std::string& _name, int _default) const {
+        auto iter = options_.find(_name);
+        if (iter == options_.end()) { return _default; }
+        try {
+            return std::stoi(iter->second);
+        } catch (const std::exception&) {
+            throw std::runtime_error("invalid integer value for option --" + _name);
+        }
+    }
+
+    float command_line::get_float(const std::string& _name, float _default) const {
+        auto iter = options_.find(_name);
+        if (iter == options_.end()) { return _default; }
+        try {
+            return std::stof(iter->second);
+        } catch (const std::exception&) {
+            throw std::runtime_error("invalid float value for option --" + _name);
+        }
+    }
+} // mkr
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <common/singleton.h>
+
+namespace mkr {
+    /**
+     * The options passed to the application on the command line.
+     * Options are written as --name=value, or as --name for a flag with no value.
+     */
+    class command_line : public singleton<command_line> {
+        friend class singleton<command_line>;
+
+    private:
+        std::unordered_map<std::string, std::string> options_;
+
+        command_line() = default;
+        virtual ~command_line() = default;
+
+    public:
+        void parse(int _argc, char* _argv[]);
+
+        [[nodiscard]] bool has(const std::string& _name) const;
+        [[nodiscard]] std::string get_string(const std::string& _name, const std::string& _default = "") const;
+        [[nodiscard]] int get_int(const std::string& _name, int _default = 0) const;
+        [[nodiscard]] float get_float(const std::string& _name, float _default = 0.0f) const;
+    };
+} // mkr
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <fstream>
+#include <SDL2/SDL.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+#include <log/log.h>
+#include "application/frame_profiler.h"
+#include "memory/frame_allocator.h"
+
+namespace mkr {
+    namespace {
+        const char* phase_names[] = {"input", "simulation", "scene", "render"};
+
+        struct percentiles {
+            float p50_, p95_, p99_, max_;
+        };
+
+        /// Nearest rank percentiles. Sorts the samples.
+        percentiles get_percentiles(std::vector<float>& _samples) {
+            std::sort(_samples.begin(), _samples.end());
+            const auto rank = [&](float _p) { return _samples[static_cast<size_t>(_p * static_cast<float>(_samples.size() - 1) + 0.5f)]; };
+            return percentiles{rank(0.5f), rank(0.95f), rank(0.99f), _samples.back()};
+        }
+
+        /// The most memory the process has had resident, in bytes.
+        uint64_t peak_resident_memory() {
+#ifndef _WIN32
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) == 0) { return static_cast<uint64_t>(usage.ru_maxrss) * 1024; } // Linux reports kilobytes.
+#endif
+            return 0;
+        }
+    }
+
+    float frame_profiler::elapsed_ms(uint64_t _from, uint64_t _to) const {
+        return static_cast<float>(_to - _from) * 1000.0f / static_cast<float>(SDL_GetPerformanceFrequency());
+    }
+
+    void frame_profiler::set_enabled(bool _enabled, size_t _expected_frames) {
+        enabled_ = _enabled;
+        if (_enabled) {
+            max_frames_ = _expected_frames > 0 ? _expected_frames : rolling_window;
+            frames_.reserve(max_frames_);
+        }
+    }
+
+    void frame_profiler::begin_frame() {
+        if (!enabled_) { return; }
+        current_ = frame_record{};
+        frame_start_ = SDL_GetPerformanceCounter();
+        phase_start_ = frame_start_;
+    }
+
+    void frame_profiler::end_phase(frame_phase _phase) {
+        if (!enabled_) { return; }
+        const uint64_t now = SDL_GetPerformanceCounter();
+        current_.phase_times_ms_[static_cast<uint32_t>(_phase)] += elapsed_ms(phase_start_, now);
+        phase_start_ = now;
+    }
+
+    void frame_profiler::end_frame(uint64_t _num_allocations, const render_stats& _stats) {
+        if (!enabled_) { return; }
+        current_.frame_time_ms_ = elapsed_ms(frame_start_, SDL_GetPerformanceCounter());
+        current_.frame_ = _stats.frame_;
+        current_.gpu_time_ms_ = _stats.gpu_time_ms_;
+        current_.resolution_scale_ = _stats.resolution_scale_;
+        current_.num_allocations_ = _num_allocations;
+        current_.num_draw_calls_ = _stats.num_draw_calls_;
+        current_.num_instances_ = _stats.num_instances_;
+        current_.num_triangles_ = _stats.num_triangles_;
+        if (frames_.size() < max_frames_) {
+            frames_.push_back(current_);
+        } else {
+            frames_[oldest_] = current_;
+            oldest_ = (oldest_ + 1) % max_frames_;
+        }
+    }
+
+    void frame_profiler::log() const {
+        if (frames_.empty()) { return; }
+
+        std::vector<float> samples(frames_.size());
+        for (size_t i = 0; i < frames_.size(); ++i) { samples[i] = frames_[i].frame_time_ms_; }
+        const auto frame_times = get_percentiles(samples);
+        MKR_CORE_INFO("Frame profile: {} frames, frame time p50 {:.3f}ms, p95 {:.3f}ms, p99 {:.3f}ms, max {:.3f}ms",
+                      frames_.size(), frame_times.p50_, frame_times.p95_, frame_times.p99_, frame_times.max_);
+
+        for (uint32_t p = 0; p < num_phases; ++p) {
+            for (size_t i = 0; i < frames_.size(); ++i) { samples[i] = frames_[i].phase_times_ms_[p]; }
+            const auto phase_times = get_percentiles(samples);
+            MKR_CORE_INFO("Frame profile: {} p50 {:.3f}ms, p95 {:.3f}ms, p99 {:.3f}ms, max {:.3f}ms",
+                          phase_names[p], phase_times.p50_, phase_times.p95_, phase_times.p99_, phase_times.max_);
+        }
+
+        double total_gpu_time = 0.0;
+        uint64_t total_allocations = 0, total_draw_calls = 0, total_instances = 0, total_triangles = 0;
+        for (const auto& f : frames_) {
+            total_gpu_time += f.gpu_time_ms_;
+            total_allocations += f.num_allocations_;
+            total_draw_calls += f.num_draw_calls_;
+            total_instances += f.num_instances_;
+            total_triangles += f.num_triangles_;
+        }
+        const double num_frames = static_cast<double>(frames_.size());
+        MKR_CORE_INFO("Frame profile: per frame avg GPU time {:.3f}ms, {:.1f} draw calls, {:.1f} instances, {:.1f} triangles, {:.1f} heap allocations",
+                      total_gpu_time / num_frames, total_draw_calls / num_frames, total_instances / num_frames, total_triangles / num_frames,
+                      total_allocations / num_frames);
+        MKR_CORE_INFO("Frame profile: peak resident memory {:.1f}MB, busiest frame arena use {} bytes",
+                      static_cast<double>(peak_resident_memory()) / (1024.0 * 1024.0), frame_arena::local().peak());
+    }
+
+    bool frame_profiler::write_csv(const std::string& _filename) const {
+        std::ofstream stream{_filename};
+        if (!stream) {
+            MKR_CORE_ERROR("failed to open frame profile {}", _filename);
+            return false;
+        }
+
+        stream << "frame,frame_time_ms";
+        for (const auto* name : phase_names) { stream << ',' << name << "_ms"; }
+        stream << ",gpu_time_ms,resolution_scale,draw_calls,instances,triangles,heap_allocations\n";
+        // Oldest first, as the rolling window wraps around.
+        for (size_t i = 0; i < frames_.size(); ++i) {
+            const auto& f = frames_[(oldest_ + i) % frames_.size()];
+            stream << f.frame_ << ',' << f.frame_time_ms_;
+            for (const auto phase_time : f.phase_times_ms_) { stream << ',' << phase_time; }
+            stream << ',' << f.gpu_time_ms_ << ',' << f.resolution_scale_ << ',' << f.num_draw_calls_ << ',' << f.num_instances_ << ','
+                   << f.num_triangles_ << ',' << f.num_allocations_ << '\n';
+        }
+        MKR_CORE_INFO("Wrote frame profile {}", _filename);
+        return static_cast<bool>(stream);
+    }
+} // mkr
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "graphics/renderer/render_stats.h"
+
+namespace mkr {
+    /// The parts of a frame that are timed on the CPU, in the order they run.
+    enum class frame_phase : uint32_t {
+        /// Pumping messages, updating the input handlers, and delivering input events.
+        input = 0,
+        /// The fixed simulation steps, and delivering simulation events.
+        simulation,
+        /// Updating the scene and submitting it to the renderer, and delivering render events.
+        scene,
+        /// Rendering and presenting the frame.
+        render,
+
+        num_frame_phases,
+    };
+
+    /**
+     * Records how long every frame of a run takes, along with its render statistics, and summarises it as percentiles at the end.
+     * Used to benchmark the engine and chart how it scales, such as with the stress scene.
+     * Enabled on the command line with --profile, and always for --frames=N, --report=<file>, headless and null graphics device runs.
+     * Runs without a frame limit keep a rolling window of the latest frames, so that recording never allocates, as the profiler also reports allocations.
+     */
+    class frame_profiler {
+    private:
+        static constexpr uint32_t num_phases = static_cast<uint32_t>(frame_phase::num_frame_phases);
+        /// The number of frames kept when the number of frames is not known up front. About 3 minutes at 60 frames per second.
+        static constexpr size_t rolling_window = 10800;
+
+        struct frame_record {
+            uint64_t frame_ = 0;
+            float frame_time_ms_ = 0.0f;
+            float phase_times_ms_[num_phases] = {};
+            /// The latest GPU time read back, which belongs to a frame a few frames earlier.
+            float gpu_time_ms_ = 0.0f;
+            float resolution_scale_ = 1.0f;
+            uint64_t num_allocations_ = 0;
+            uint32_t num_draw_calls_ = 0;
+            uint64_t num_instances_ = 0;
+            uint64_t num_triangles_ = 0;
+        };
+
+        bool enabled_ = false;
+        /// Reserved up front. Once full, the oldest frame is overwritten.
+        std::vector<frame_record> frames_;
+        size_t max_frames_ = 0;
+        /// The oldest frame, once frames_ is full.
+        size_t oldest_ = 0;
+        frame_record current_;
+        uint64_t frame_start_ = 0;
+        uint64_t phase_start_ = 0;
+
+        [[nodiscard]] float elapsed_ms(uint64_t _from, uint64_t _to) const;
+
+    public:
+        frame_profiler() = default;
+        ~frame_profiler() = default;
+
+        /**
+         * Start or stop recording frames.
+         * @param _enabled whether to record frames
+         * @param _expected_frames the number of frames the run is expected to take, to reserve space for them so that recording does not allocate.
+         *                         0 keeps a rolling window of the latest frames instead.
+         */
+        void set_enabled(bool _enabled, size_t _expected_frames = 0);
+
+        [[nodiscard]] inline bool enabled() const { return enabled_; }
+
+        /// The number of frames recorded, up to the size of the rolling window.
+        [[nodiscard]] inline size_t num_frames() const { return frames_.size(); }
+
+        void begin_frame();
+
+        /// End a phase, which began when the previous phase ended, or when the frame began.
+        void end_phase(frame_phase _phase);
+
+        /**
+         * End the frame.
+         * @param _num_allocations the number of heap allocations made in the frame
+         * @param _stats the frame's render statistics
+         */
+        void end_frame(uint64_t _num_allocations, const render_stats& _stats);
+
+        /// Log the frame time and phase time percentiles, and the averages of everything else.
+        void log() const;
+
+        /**
+         * Write every frame's times and statistics to a CSV file.
+         * @param _filename the file to write to
+         * @return true if the file was written
+         */
+        bool write_csv(const std::string& _filename) const;
+    };
+} // mkr
\ No newline at end of file
@@ -16,7 +16,7 @@ namespace mkr {
         // Otherwise, Windows will think that the application is not responding.
         sdl_event e;
         while (SDL_PollEvent(&e.sdl_event_)) {
-            event_dispatcher_.dispatch_event<sdl_event>(&e);
+            event_dispatcher_.dispatch_event(e);
         }
     }
 
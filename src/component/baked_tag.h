@@ -0,0 +1,9 @@
+#pragma once
+
+namespace mkr {
+    /**
+     * Marks a static entity whose render_mesh has been merged into one of the scene's baked chunks.
+     * The entity keeps its render_mesh, so that it is still saved with the scene, but it is not rendered, as its chunk draws it.
+     */
+    struct baked_tag {};
+} // mkr
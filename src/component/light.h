@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cmath>
+#include <limits>
 #include <maths/maths_util.h>
 #include <maths/colour.h>
+#include "graphics/lighting/lighting.h"
 
 namespace mkr {
     enum light_mode {
@@ -23,7 +26,11 @@ namespace mkr {
         float spotlight_inner_angle_ = maths_util::deg2rad * 60.0f;
         float spotlight_outer_angle_ = maths_util::deg2rad * 90.0f;
 
-        float shadow_distance_ = 50.0f; // Only for spot and point light. Maximum distance that the light can cast a shadow.
+        float shadow_distance_ = 50.0f; // Maximum distance that the light can cast a shadow. For directional light, the distance from the camera that is covered by the shadow cascades.
+        bool cast_shadows_ = true; // Only a limited number of lights can be given a shadow map each frame.
+
+        uint32_t num_cascades_ = 4; // Only for directional light. The number of shadow cascades the view is split into.
+        float cascade_split_lambda_ = 0.75f; // Only for directional light. Blends the cascade splits between uniform (0) and logarithmic (1).
 
     public:
         light() = default;
@@ -69,5 +76,35 @@ namespace mkr {
         inline float get_shadow_distance() const { return shadow_distance_; }
 
         inline void set_shadow_distance(float _distance) { shadow_distance_ = _distance; }
+
+        inline bool get_cast_shadows() const { return cast_shadows_; }
+
+        inline void set_cast_shadows(bool _cast_shadows) { cast_shadows_ = _cast_shadows; }
+
+        inline uint32_t get_num_cascades() const { return num_cascades_; }
+
+        inline void set_num_cascades(uint32_t _num_cascades) { num_cascades_ = maths_util::clamp<uint32_t>(_num_cascades, 1, lighting::max_cascades); }
+
+        inline float get_cascade_split_lambda() const { return cascade_split_lambda_; }
+
+        inline void set_cascade_split_lambda(float _lambda) { cascade_split_lambda_ = maths_util::clamp<float>(_lambda, 0.0f, 1.0f); }
+
+        /**
+         * Get the distance at which the light's contribution falls below a fraction of full intensity.
+         * The shader attenuates by 1 / max(1, c + l * d + q * d^2), so this solves c + l * d + q * d^2 = power / _cutoff for d.
+         * @param _cutoff The fraction of full intensity below which the light is considered to have no effect.
+         * @return The range of the light. Directional lights, and lights that do not attenuate, have an infinite range.
+         */
+        inline float get_range(float _cutoff) const {
+            if (mode_ == light_mode::directional) { return std::numeric_limits<float>::infinity(); }
+
+            const float k = power_ / _cutoff - attenuation_constant_;
+            if (k <= 0.0f) { return 0.0f; }
+            if (attenuation_quadratic_ > 0.0f) {
+                return (std::sqrt(attenuation_linear_ * attenuation_linear_ + 4.0f * attenuation_quadratic_ * k) - attenuation_linear_) / (2.0f * attenuation_quadratic_);
+            }
+            if (attenuation_linear_ > 0.0f) { return k / attenuation_linear_; }
+            return std::numeric_limits<float>::infinity();
+        }
     };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+#include <maths/maths_util.h>
 #include <maths/vector3.h>
 #include <maths/quaternion.h>
 #include <maths/matrix.h>
@@ -10,5 +12,86 @@ namespace mkr {
         quaternion rotation_;
         vector3 position_;
         vector3 left_, up_, forward_;
+
+        /**
+         * Spherically interpolate the rotation of two states.
+         * The relative rotation is recovered from the states' axes, so that this does not depend on the layout of the quaternion class.
+         * @param _from The state to interpolate from.
+         * @param _to The state to interpolate to.
+         * @param _alpha The interpolation factor, in the range [0, 1].
+         * @return The interpolated rotation.
+         */
+        static quaternion slerp_rotation(const local_to_world& _from, const local_to_world& _to, float _alpha) {
+            // The relative rotation, which turns _from into _to, as a matrix indexed by [column][row]. The axes are the columns of each state's rotation.
+            const vector3 from_axes[] = {_from.left_, _from.up_, _from.forward_};
+            const vector3 to_axes[] = {_to.left_, _to.up_, _to.forward_};
+            float m[3][3] = {};
+            for (auto i = 0; i < 3; ++i) {
+                const float f[] = {from_axes[i].x_, from_axes[i].y_, from_axes[i].z_};
+                const float t[] = {to_axes[i].x_, to_axes[i].y_, to_axes[i].z_};
+                for (auto col = 0; col < 3; ++col) {
+                    for (auto row = 0; row < 3; ++row) {
+                        m[col][row] += t[row] * f[col];
+                    }
+                }
+            }
+
+            // No rotation, or half a turn, which has no shortest path. Neither happens between consecutive simulation steps.
+            const vector3 axis{m[1][2] - m[2][1], m[2][0] - m[0][2], m[0][1] - m[1][0]};
+            if (axis.dot(axis) < 1e-12f) { return _alpha < 0.5f ? _from.rotation_ : _to.rotation_; }
+            const vector3 unit_axis = axis.normalised();
+            const float angle = std::acos(maths_util::clamp<float>((m[0][0] + m[1][1] + m[2][2] - 1.0f) * 0.5f, -1.0f, 1.0f));
+
+            // Do not assume the handedness of the quaternion class. Keep whichever direction turns _from onto _to.
+            auto error = [&](float _angle) {
+                const quaternion q{unit_axis, _angle};
+                const vector3 dx = quaternion::rotate(_from.left_, q) - _to.left_;
+                const vector3 dy = quaternion::rotate(_from.up_, q) - _to.up_;
+                return dx.dot(dx) + dy.dot(dy);
+            };
+            const float signed_angle = error(angle) <= error(-angle) ? angle : -angle;
+            return quaternion{unit_axis, signed_angle * _alpha} * _from.rotation_;
+        }
+
+        /**
+         * Interpolate between two simulated states for rendering.
+         * The matrix and position are blended linearly. The rotation is blended spherically, and the axes are taken from it,
+         * so that the rotation and the axes agree. The matrix blend is only a close approximation of a proper rotation blend,
+         * which holds because consecutive fixed steps are close together.
+         * @param _from The state of the previous simulation step.
+         * @param _to The state of the latest simulation step.
+         * @param _alpha The interpolation factor, in the range [0, 1].
+         * @return The interpolated state.
+         */
+        static local_to_world interpolate(const local_to_world& _from, const local_to_world& _to, float _alpha) {
+            local_to_world result = _to;
+            for (auto col = 0; col < 4; ++col) {
+                for (auto row = 0; row < 4; ++row) {
+                    result.transform_[col][row] = _from.transform_[col][row] + (_to.transform_[col][row] - _from.transform_[col][row]) * _alpha;
+                }
+            }
+            result.position_ = _from.position_ + (_to.position_ - _from.position_) * _alpha;
+            result.rotation_ = slerp_rotation(_from, _to, _alpha);
+            result.left_ = quaternion::rotate(vector3::x_axis(), result.rotation_);
+            result.up_ = quaternion::rotate(vector3::y_axis(), result.rotation_);
+            result.forward_ = quaternion::rotate(vector3::z_axis(), result.rotation_);
+            return result;
+        }
+    };
+
+    /// The local_to_world of the previous simulation step, used to interpolate rendering between simulation steps.
+    struct previous_local_to_world {
+        local_to_world transform_;
+        /// False until the first simulation step has been taken.
+        bool valid_ = false;
+
+        /**
+         * Get the transform to render with this frame.
+         * @param _current The local_to_world of the latest simulation step.
+         * @param _alpha The interpolation factor, in the range [0, 1].
+         */
+        [[nodiscard]] inline local_to_world interpolate(const local_to_world& _current, float _alpha) const {
+            return valid_ ? local_to_world::interpolate(transform_, _current, _alpha) : _current;
+        }
     };
-} // mkr
\ No newline at end of file
+} // mkr
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace mkr {
+    /**
+     * Marks an entity that never moves.
+     * When a scene bakes its static geometry, the render_mesh of every static entity is merged into a combined world space mesh, and the entity is given a baked_tag.
+     * The local_to_world of a static entity is not updated every frame, only when the scene bakes or loads its static entities.
+     */
+    struct static_tag {};
+} // mkr
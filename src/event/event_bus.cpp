@@ -0,0 +1,26 @@
+#include <log/log.h>
+#include "event/event_bus.h"
+
+namespace mkr {
+    event_bus::~event_bus() {
+        for (auto& c : channels_) { delete c.load(std::memory_order_acquire); }
+    }
+
+    void event_bus::deliver(event_phase _phase) {
+        for (auto& slot : channels_) {
+            auto* c = slot.load(std::memory_order_acquire);
+            if (!c) { continue; }
+
+            if (const auto num_dropped = c->collect(); num_dropped > 0) {
+                MKR_CORE_WARN("Event bus queue is full, {} events posted from other threads were dropped", num_dropped);
+            }
+            c->deliver(_phase);
+        }
+    }
+
+    void event_bus::end_frame() {
+        for (auto& slot : channels_) {
+            if (auto* c = slot.load(std::memory_order_acquire)) { c->end_frame(); }
+        }
+    }
+} // mkr
\ No newline at end of file
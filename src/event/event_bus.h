@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <common/singleton.h>
+#include "event/event_listener.h"
+#include "event/event_type_index.h"
+#include "util/inplace_function.h"
+#include "util/mpsc_queue.h"
+
+namespace mkr {
+    /// The points in the frame where the event bus delivers queued events.
+    enum class event_phase : uint8_t {
+        /// After input has been handled, before the simulation steps.
+        input,
+        /// After the simulation steps, before the scene update.
+        simulation,
+        /// After the scene update, before rendering.
+        render,
+        num_event_phases,
+    };
+
+    /// The function called with a batch of events of type T. Stored inline, so it may capture at most 32 bytes.
+    template<typename T>
+    using event_batch_callback = inplace_function<void(std::span<const T>), 32>;
+
+    /**
+     * Queues events in a typed array per event type, and delivers them to listeners in batches at fixed points in the frame.
+     * Each listener subscribes to an event type at one phase, and is given every event of that type posted since its last delivery as a single span.
+     * Events posted by the main thread go straight into the arrays. Other threads post into a lock free queue, which is emptied into the arrays at the start of every delivery.
+     * The arrays keep their memory between frames, so posting stops allocating once they have grown to fit the busiest frame.
+     * Everything except post_concurrent() must be called from the main thread.
+     */
+    class event_bus : public singleton<event_bus> {
+        friend class singleton<event_bus>;
+
+    public:
+        static constexpr size_t max_event_types = 64;
+        /// The most events of one type that other threads can post between two deliveries.
+        static constexpr size_t max_concurrent_events = 1024;
+
+    private:
+        struct channel_base {
+            virtual ~channel_base() = default;
+            /// Move the events posted by other threads into the array. Returns the number of events dropped because the queue was full.
+            virtual uint32_t collect() = 0;
+            virtual void deliver(event_phase _phase) = 0;
+            /// Drop the events that every listener has been given.
+            virtual void end_frame() = 0;
+        };
+
+        template<typename T>
+        struct channel : public channel_base {
+            struct subscription {
+                /// nullptr once unsubscribed during a delivery. The subscription is erased when the delivery ends.
+                event_listener* listener_;
+                event_phase phase_;
+                event_batch_callback<T> callback_;
+                /// The index of the first event the listener has not been given.
+                size_t cursor_;
+            };
+
+            std::vector<T> events_;
+            /// Events posted while events_ is being delivered, so that the span being delivered does not move.
+            std::vector<T> deferred_;
+            /// Reused to compact events_ at the end of a frame.
+            std::vector<T> spare_;
+            mpsc_queue<T, max_concurrent_events> concurrent_;
+            std::atomic<uint32_t> num_dropped_ = 0;
+
+            std::vector<subscription> subscriptions_;
+            /// Subscriptions added during a delivery, which join subscriptions_ when the delivery ends.
+            std::vector<subscription> pending_;
+            bool delivering_ = false;
+
+            void post(const T& _event) { (delivering_ ? deferred_ : events_).push_back(_event); }
+
+            uint32_t collect() override {
+                concurrent_.consume([&](T&& _event) { events_.push_back(std::move(_event)); });
+                return num_dropped_.exchange(0, std::memory_order_relaxed);
+            }
+
+            void deliver(event_phase _phase) override {
+                // subscriptions_ does not grow during a delivery, so a callback may subscribe and unsubscribe safely.
+                delivering_ = true;
+                const size_t num_subscriptions = subscriptions_.size();
+                for (size_t i = 0; i < num_subscriptions; ++i) {
+                    auto& s = subscriptions_[i];
+                    if (!s.listener_ || s.phase_ != _phase || s.cursor_ == events_.size()) { continue; }
+                    const size_t first = s.cursor_;
+                    s.cursor_ = events_.size();
+                    s.callback_(std::span<const T>{events_.data() + first, events_.size() - first});
+                }
+                delivering_ = false;
+
+                std::erase_if(subscriptions_, [](const subscription& _s) { return _s.listener_ == nullptr; });
+                for (auto& s : pending_) {
+                    s.cursor_ = events_.size();
+                    subscriptions_.push_back(std::move(s));
+                }
+                pending_.clear();
+                for (auto& e : deferred_) { events_.push_back(std::move(e)); }
+                deferred_.clear();
+            }
+
+            void end_frame() override {
+                size_t num_delivered = events_.size();
+                for (const auto& s : subscriptions_) { num_delivered = std::min(num_delivered, s.cursor_); }
+                for (auto& s : subscriptions_) { s.cursor_ -= num_delivered; }
+
+                if (num_delivered == events_.size()) {
+                    events_.clear();
+                    return;
+                }
+
+                // Some listeners have not been given the events posted after their phase. Keep those events for their next delivery.
+                spare_.clear();
+                for (size_t i = num_delivered; i < events_.size(); ++i) { spare_.push_back(std::move(events_[i])); }
+                events_.swap(spare_);
+                spare_.clear();
+            }
+        };
+
+        /// Indexed by event_type_index. Channels are created by whichever thread first uses an event type, so the slots are atomic.
+        std::array<std::atomic<channel_base*>, max_event_types> channels_ = {};
+
+        event_bus() = default;
+        virtual ~event_bus();
+
+        template<typename T>
+        channel<T>& get_channel() {
+            const size_t index = event_type_index::get<T>();
+            if (index >= max_event_types) { throw std::runtime_error("event_bus: too many event types"); }
+
+            auto* c = channels_[index].load(std::memory_order_acquire);
+            if (!c) {
+                auto* created = new channel<T>();
+                if (channels_[index].compare_exchange_strong(c, created, std::memory_order_acq_rel)) {
+                    c = created;
+                } else {
+                    // Another thread created the channel first.
+                    delete created;
+                }
+            }
+            return *static_cast<channel<T>*>(c);
+        }
+
+    public:
+        /**
+         * Queue an event to be delivered at the next phase that has listeners for it. Must be called from the main thread.
+         * @param _event The event.
+         */
+        template<typename T>
+        void post(const T& _event) requires std::is_base_of_v<mkr::event, T> {
+            get_channel<T>().post(_event);
+        }
+
+        /**
+         * Queue an event from any thread, without taking a lock.
+         * @param _event The event.
+         * @return false if too many events of this type were posted by other threads since the last delivery, and the event was dropped.
+         */
+        template<typename T>
+        bool post_concurrent(const T& _event) requires std::is_base_of_v<mkr::event, T> {
+            auto& c = get_channel<T>();
+            if (c.concurrent_.try_push(_event)) { return true; }
+            c.num_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        /**
+         * Subscribe a listener to batches of events of type T. The listener is given the events posted from now on.
+         * Subscribing a listener that is already subscribed to events of type T replaces its subscription.
+         * @param _listener The listener.
+         * @param _phase The point in the frame the events are delivered to the listener.
+         * @param _callback The function called with the events.
+         */
+        template<typename T>
+        void subscribe(event_listener* _listener, event_phase _phase, event_batch_callback<T> _callback) requires std::is_base_of_v<mkr::event, T> {
+            auto& c = get_channel<T>();
+            unsubscribe<T>(_listener);
+            (c.delivering_ ? c.pending_ : c.subscriptions_).push_back({_listener, _phase, std::move(_callback), c.events_.size()});
+        }
+
+        /**
+         * Unsubscribe a listener from events of type T.
+         * @param _listener The listener.
+         */
+        template<typename T>
+        void unsubscribe(event_listener* _listener) requires std::is_base_of_v<mkr::event, T> {
+            auto& c = get_channel<T>();
+            const auto matches = [&](const auto& _s) { return _s.listener_ == _listener; };
+            std::erase_if(c.pending_, matches);
+            if (c.delivering_) {
+                for (auto& s : c.subscriptions_) {
+                    if (matches(s)) { s.listener_ = nullptr; }
+                }
+            } else {
+                std::erase_if(c.subscriptions_, matches);
+            }
+        }
+
+        /**
+         * Deliver the queued events to the listeners subscribed at a phase.
+         * @param _phase The phase.
+         */
+        void deliver(event_phase _phase);
+
+        /// Drop the events that every listener has been given. Call once a frame, after the last phase.
+        void end_frame();
+    };
+} // mkr
\ No newline at end of file
@@ -1,23 +1,63 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
-#include <unordered_set>
+#include <type_traits>
 #include <vector>
-#include <common/type_id.h>
 #include "event/event_listener.h"
+#include "event/event_type_index.h"
 
 namespace mkr {
-    using event_id_t = mkr::type_id_t;
-    using event_id = mkr::type_id<event>;
-
     /**
         \brief An event_dispatcher is used to dispatch event(s) to event_listener(s) that are subscribed to this dispatcher. This uses the publisher-subscriber pattern.
+        The callbacks for each event type are kept in their own contiguous array, and are called with the event's real type, so dispatching needs no casts and no allocations.
+        Listeners may be added and removed from inside a callback. Removed listeners are not called again, and added listeners are called from the next dispatch.
     */
     class event_dispatcher {
     private:
-        /// The event_listener(s) added to this event_dispatcher is sorted by the event type they are subscribed to.
-        std::unordered_map<event_id_t, std::unordered_set<event_listener*>> listeners_;
+        struct channel_base {
+            virtual ~channel_base() = default;
+        };
+
+        /// The listeners subscribed to event(s) of type T.
+        template<typename T>
+        struct channel : public channel_base {
+            struct entry {
+                /// nullptr once removed during a dispatch. The entry is erased when the dispatch ends.
+                event_listener* listener_;
+                event_callback<T> callback_;
+            };
+
+            std::vector<entry> entries_;
+            /// Listeners added during a dispatch, which join entries_ when the dispatch ends.
+            std::vector<entry> pending_;
+            uint32_t dispatch_depth_ = 0;
+
+            void flush() {
+                std::erase_if(entries_, [](const entry& _entry) { return _entry.listener_ == nullptr; });
+                for (auto& e : pending_) { entries_.push_back(std::move(e)); }
+                pending_.clear();
+            }
+        };
+
+        /// Indexed by event_type_index.
+        std::vector<std::unique_ptr<channel_base>> channels_;
+
+        template<typename T>
+        channel<T>* find_channel() {
+            const size_t index = event_type_index::get<T>();
+            return (index < channels_.size()) ? static_cast<channel<T>*>(channels_[index].get()) : nullptr;
+        }
+
+        template<typename T>
+        channel<T>& get_channel() {
+            const size_t index = event_type_index::get<T>();
+            if (index >= channels_.size()) { channels_.resize(index + 1); }
+            if (!channels_[index]) { channels_[index] = std::make_unique<channel<T>>(); }
+            return *static_cast<channel<T>*>(channels_[index].get());
+        }
 
     public:
         event_dispatcher() = default;
@@ -29,19 +69,41 @@ namespace mkr {
             \param _event The event to dispatch.
         */
         template<typename T>
-        void dispatch_event(event* _event) requires std::is_base_of_v<mkr::event, T> {
-            for (auto listener : listeners_[event_id::value<T>()]) {
-                listener->invoke_callback(_event);
+        void dispatch_event(const T& _event) requires std::is_base_of_v<mkr::event, T> {
+            auto* c = find_channel<T>();
+            if (!c) { return; }
+
+            // entries_ does not grow during a dispatch, so the entries stay where they are even if a callback adds or removes listeners.
+            ++c->dispatch_depth_;
+            const size_t num_entries = c->entries_.size();
+            for (size_t i = 0; i < num_entries; ++i) {
+                const auto& e = c->entries_[i];
+                if (e.listener_) { e.callback_(_event); }
             }
+            if (--c->dispatch_depth_ == 0) { c->flush(); }
         }
 
         /**
             \brief Subscribes an event_listener to event(s) of type T from this event_dispatcher. Only event(s) of type T will be received from this event_dispatcher. It is possible use add_listener multiple times to listen for multiple types of event(s).
+            Adding a listener that is already subscribed to event(s) of type T replaces its callback.
             \param _listener The event_listener to add.
+            \param _callback The function to call when an event of type T is dispatched.
         */
         template<typename T>
-        void add_listener(event_listener* _listener) requires std::is_base_of_v<mkr::event, T> {
-            listeners_[event_id::value<T>()].insert(_listener);
+        void add_listener(event_listener* _listener, event_callback<T> _callback) requires std::is_base_of_v<mkr::event, T> {
+            auto& c = get_channel<T>();
+            for (auto* entries : {&c.entries_, &c.pending_}) {
+                auto iter = std::find_if(entries->begin(), entries->end(), [&](const auto& _entry) { return _entry.listener_ == _listener; });
+                if (iter != entries->end()) {
+                    // The callback may be running, so during a dispatch the old entry is removed and the new one waits until the dispatch ends.
+                    if (c.dispatch_depth_ == 0 || entries == &c.pending_) {
+                        iter->callback_ = std::move(_callback);
+                        return;
+                    }
+                    iter->listener_ = nullptr;
+                }
+            }
+            (c.dispatch_depth_ > 0 ? c.pending_ : c.entries_).push_back({_listener, std::move(_callback)});
         }
 
         /**
@@ -50,7 +112,17 @@ namespace mkr {
         */
         template<typename T>
         void remove_listener(event_listener* _listener) requires std::is_base_of_v<mkr::event, T> {
-            listeners_[event_id::value<T>()].erase(_listener);
+            auto* c = find_channel<T>();
+            if (!c) { return; }
+
+            std::erase_if(c->pending_, [&](const auto& _entry) { return _entry.listener_ == _listener; });
+            if (c->dispatch_depth_ > 0) {
+                for (auto& e : c->entries_) {
+                    if (e.listener_ == _listener) { e.listener_ = nullptr; }
+                }
+            } else {
+                std::erase_if(c->entries_, [&](const auto& _entry) { return _entry.listener_ == _listener; });
+            }
         }
     };
 }
\ No newline at end of file
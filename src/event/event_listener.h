@@ -1,47 +1,25 @@
 #pragma once
 
-#include <functional>
-#include <type_traits>
-#include <utility>
 #include "event/event.h"
+#include "util/inplace_function.h"
 
 namespace mkr {
+    /// The function called when an event of type T is received. Stored inline, so it may capture at most 32 bytes.
+    template<typename T>
+    using event_callback = inplace_function<void(const T&), 32>;
+
     /**
-        \brief Used to subscribe to an event_dispatcher to receive event(s) from that event_dispatcher. It is possible to subscribe to multiple EventDispatchers.
+        \brief Identifies a subscriber to event_dispatcher(s), so that its callbacks can be removed. It is possible to subscribe to multiple event types, and to multiple event_dispatchers.
+        The callbacks themselves are stored by the event_dispatcher, next to the other callbacks for the same event type.
     */
     class event_listener {
-    private:
-        /// When a event is received, the function assigned to callback_ is invoked. The event will be passed to the function as a parameter.
-        std::function<void(const ::mkr::event*)> callback_ = [](const ::mkr::event*) {};
-
     public:
         event_listener() = default;
 
         ~event_listener() = default;
 
-        /**
-            \brief Sets a function to be called when an event is received.
-            \param _callback The callback function to invoke when an event is received.
-        */
-        void set_callback(std::function<void(const ::mkr::event*)> _callback) { callback_ = std::move(_callback); }
-
-        /**
-         * Sets a function to be called when an event is received.
-         * @tparam T The event type.
-         * @param _callback The callback function to invoke when an event is received.
-         */
-        template <typename T>
-        void set_callback(std::function<void(const T*)> _callback) requires std::is_base_of_v<::mkr::event, T> {
-            callback_ = [=](const ::mkr::event* _e) {
-                auto e = dynamic_cast<const T*>(_e);
-                if (e) { _callback(e); }
-            };
-        }
-
-        /**
-            \brief Used by event_dispatcher to invoke the callback and pass the event.
-            \param _event The event that is received.
-        */
-        void invoke_callback(const ::mkr::event* _event) { std::invoke(callback_, _event); }
+        // The dispatchers refer to listeners by address.
+        event_listener(const event_listener&) = delete;
+        event_listener& operator=(const event_listener&) = delete;
     };
 }
\ No newline at end of file
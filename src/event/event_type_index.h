@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include "event/event.h"
+
+namespace mkr {
+    /// Gives every event type a small, dense index, so that dispatchers can find the listeners of an event type by indexing an array.
+    class event_type_index {
+    private:
+        inline static std::atomic<size_t> next_index_ = 0;
+
+    public:
+        event_type_index() = delete;
+
+        template<typename T>
+        static size_t get() requires std::is_base_of_v<mkr::event, T> {
+            static const size_t index = next_index_.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+    };
+}
\ No newline at end of file
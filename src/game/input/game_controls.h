@@ -25,5 +25,8 @@ namespace mkr {
 
         // Motions
         test_motion,
+
+        // Debug. Added last, so that the values of recorded actions do not change.
+        dump_memory,
     };
 } // mkr
\ No newline at end of file
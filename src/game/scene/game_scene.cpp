@@ -9,10 +9,13 @@
 #include "component/render_mesh.h"
 #include "component/light.h"
 #include "component/camera.h"
+#include "component/static_tag.h"
+#include "component/baked_tag.h"
 #include "graphics/renderer/graphics_renderer.h"
 #include "graphics/shader/forward_shader.h"
 #include "graphics/shader/geometry_shader.h"
 #include "graphics/shader/lighting_shader.h"
+#include "graphics/shader/light_volume_shader.h"
 #include "graphics/shader/alpha_weight_shader.h"
 #include "graphics/shader/alpha_blend_shader.h"
 #include "graphics/shader/post_proc_shader.h"
@@ -38,12 +41,14 @@ namespace mkr {
         init_sphere_gallery();
         init_transparency_gallery();
         // init_shadow_gallery();
+        bake_static();
     }
 
     void game_scene::pre_update() {
     }
 
     void game_scene::post_update() {
+        bcs_.clear_input();
     }
 
     void game_scene::exit() {
@@ -55,6 +60,7 @@ namespace mkr {
 
         // Register Buttons
         input_manager::instance().register_button(quit, input_context_default, controller_index_default, kc_escape);
+        input_manager::instance().register_button(dump_memory, input_context_default, controller_index_default, kc_f1);
 
         input_manager::instance().register_button(move_left, input_context_default, controller_index_default, kc_a);
         input_manager::instance().register_button(move_right, input_context_default, controller_index_default, kc_d);
@@ -89,6 +95,7 @@ namespace mkr {
     void game_scene::exit_input() {
         // Unregister Buttons
         input_manager::instance().unregister_button(quit, input_context_default, controller_index_default, kc_escape);
+        input_manager::instance().unregister_button(dump_memory, input_context_default, controller_index_default, kc_f1);
 
         input_manager::instance().unregister_button(move_left, input_context_default, controller_index_default, kc_a);
         input_manager::instance().unregister_button(move_right, input_context_default, controller_index_default, kc_d);
@@ -121,14 +128,25 @@ namespace mkr {
     }
 
     void game_scene::init_systems() {
-        world_.system<transform, const head_tag>().each([&](transform& _trans, const head_tag _head) { hcs_(_trans, _head); });
-        world_.system<transform, const body_tag>().each([&](transform& _trans, const body_tag _body) { bcs_(_trans, _body); });
-        world_.system<transform, const rotate_tag>().each([](transform& _trans, const rotate_tag _camera) { _trans.rotate(quaternion{vector3::y_axis(), 5.0f * maths_util::deg2rad * application::instance().delta_time()}); });
-
-        // Render systems.
-        world_.system<const local_to_world, const camera>().each([](const local_to_world& _transform, const camera& _camera) { graphics_renderer::instance().submit_camera(_transform, _camera); });
-        world_.system<const local_to_world, const light>().each([](const local_to_world& _transform, const light& _light) { graphics_renderer::instance().submit_light(_transform, _light); });
-        world_.system<const local_to_world, const render_mesh>().each([](const local_to_world& _transform, const render_mesh& _mesh_renderer) { graphics_renderer::instance().submit_mesh(_transform, _mesh_renderer); });
+        // Gameplay systems.
+        fixed_system<transform, const head_tag>([&](transform& _trans, const head_tag _head) { hcs_(_trans, _head); });
+        fixed_system<transform, const body_tag>([&](transform& _trans, const body_tag _body) { bcs_(_trans, _body); });
+        fixed_system<transform, const rotate_tag>([](transform& _trans, const rotate_tag _camera) { _trans.rotate(quaternion{vector3::y_axis(), 5.0f * maths_util::deg2rad * application::instance().fixed_delta_time()}); });
+
+        // Render systems. These interpolate between the last two simulation steps.
+        world_.system<const local_to_world, const previous_local_to_world, const camera>().each([](const local_to_world& _transform, const previous_local_to_world& _previous, const camera& _camera) {
+            graphics_renderer::instance().submit_camera(_previous.interpolate(_transform, application::instance().interpolation_alpha()), _camera);
+        });
+        world_.system<const local_to_world, const previous_local_to_world, const light>().each([](flecs::entity _entity, const local_to_world& _transform, const previous_local_to_world& _previous, const light& _light) {
+            graphics_renderer::instance().submit_light(_entity.id(), _previous.interpolate(_transform, application::instance().interpolation_alpha()), _light);
+        });
+        world_.system<const local_to_world, const previous_local_to_world, const render_mesh>().term<static_tag>().not_().each([](const local_to_world& _transform, const previous_local_to_world& _previous, const render_mesh& _mesh_renderer) {
+            graphics_renderer::instance().submit_mesh(_previous.interpolate(_transform, application::instance().interpolation_alpha()), _mesh_renderer, false);
+        });
+        // Static meshes never move, so there is nothing to interpolate. Baked entities are drawn by their chunk instead.
+        world_.system<const local_to_world, const render_mesh>().term<static_tag>().term<baked_tag>().not_().each([](const local_to_world& _transform, const render_mesh& _mesh_renderer) {
+            graphics_renderer::instance().submit_mesh(_transform, _mesh_renderer, true);
+        });
     }
 
     void game_scene::init_shaders() {
@@ -140,24 +158,37 @@ namespace mkr {
                                                                {"./assets/shaders/forward/forward.vert"},
                                                                {"./assets/shaders/forward/forward.frag",
                                                                 "./assets/shaders/include/parallax.frag",
+                                                                "./assets/shaders/include/gbuffer.frag",
+                                                                "./assets/shaders/include/cluster.frag",
                                                                 "./assets/shaders/include/shadow.frag",
                                                                 "./assets/shaders/include/light.frag"});
 
         shader_manager::instance().make_shader<geometry_shader>("geometry",
                                                                 {"./assets/shaders/deferred/geometry.vert"},
                                                                 {"./assets/shaders/deferred/geometry.frag",
-                                                                 "./assets/shaders/include/parallax.frag"});
+                                                                 "./assets/shaders/include/parallax.frag",
+                                                                 "./assets/shaders/include/gbuffer.frag"});
 
         shader_manager::instance().make_shader<lighting_shader>("lighting",
                                                                 {"./assets/shaders/deferred/lighting.vert"},
                                                                 {"./assets/shaders/deferred/lighting.frag",
+                                                                 "./assets/shaders/include/gbuffer.frag",
+                                                                 "./assets/shaders/include/cluster.frag",
                                                                  "./assets/shaders/include/shadow.frag",
                                                                  "./assets/shaders/include/light.frag"});
 
+        shader_manager::instance().make_shader<light_volume_shader>("light_volume",
+                                                                    {"./assets/shaders/deferred/light_volume.vert"},
+                                                                    {"./assets/shaders/deferred/light_volume.frag",
+                                                                     "./assets/shaders/include/gbuffer.frag",
+                                                                     "./assets/shaders/include/shadow.frag",
+                                                                     "./assets/shaders/include/light.frag"});
+
         shader_manager::instance().make_shader<alpha_weight_shader>("alpha_weight",
                                                                     {"./assets/shaders/alpha/alpha_weight.vert"},
                                                                     {"./assets/shaders/alpha/alpha_weight.frag",
                                                                      "./assets/shaders/include/parallax.frag",
+                                                                     "./assets/shaders/include/cluster.frag",
                                                                      "./assets/shaders/include/shadow.frag",
                                                                      "./assets/shaders/include/light.frag"});
 
@@ -171,11 +202,11 @@ namespace mkr {
 
         shader_manager::instance().make_shader<shadow_cubemap_shader>("shadow_cubemap",
                                                                       {"./assets/shaders/shadow/shadow_cubemap.vert"},
-                                                                      {"./assets/shaders/shadow/shadow_cubemap.geom"},
                                                                       {"./assets/shaders/shadow/shadow_cubemap.frag"});
 
         material::geometry_shader_ = shader_manager::instance().get_shader("geometry");
         material::light_shader_ = shader_manager::instance().get_shader("lighting");
+        material::light_volume_shader_ = shader_manager::instance().get_shader("light_volume");
         material::shadow_shader_2d_ = shader_manager::instance().get_shader("shadow_2d");
         material::shadow_shader_cube_ = shader_manager::instance().get_shader("shadow_cubemap");
     }
@@ -338,7 +369,7 @@ namespace mkr {
             render_mesh rend{};
             rend.mesh_ = mesh_manager::instance().get_mesh("plane");
             rend.material_ = material_manager::instance().get_material("tiles");
-            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>();
+            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>().add<static_tag>();
         }
 
         // Directional Light
@@ -531,7 +562,7 @@ namespace mkr {
             render_mesh rend{};
             rend.mesh_ = mesh_manager::instance().get_mesh("quad");
             rend.material_ = material_manager::instance().get_material("window");
-            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>();
+            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>().add<static_tag>();
         }
 
         {
@@ -542,7 +573,7 @@ namespace mkr {
             render_mesh rend{};
             rend.mesh_ = mesh_manager::instance().get_mesh("cube");
             rend.material_ = material_manager::instance().get_material("metal_plate");
-            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>();
+            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>().add<static_tag>();
         }
 
         {
@@ -553,7 +584,7 @@ namespace mkr {
             render_mesh rend{};
             rend.mesh_ = mesh_manager::instance().get_mesh("sphere");
             rend.material_ = material_manager::instance().get_material("rough_rock");
-            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>();
+            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>().add<static_tag>();
         }
 
         {
@@ -564,7 +595,7 @@ namespace mkr {
             render_mesh rend{};
             rend.mesh_ = mesh_manager::instance().get_mesh("cone");
             rend.material_ = material_manager::instance().get_material("red_op");
-            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>();
+            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>().add<static_tag>();
         }
 
         {
@@ -575,7 +606,7 @@ namespace mkr {
             render_mesh rend{};
             rend.mesh_ = mesh_manager::instance().get_mesh("torus");
             rend.material_ = material_manager::instance().get_material("blue_op");
-            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>();
+            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>().add<static_tag>();
         }
 
         {
@@ -586,7 +617,7 @@ namespace mkr {
             render_mesh rend{};
             rend.mesh_ = mesh_manager::instance().get_mesh("cube");
             rend.material_ = material_manager::instance().get_material("pavement");
-            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>();
+            world_.entity().set<transform>(trans).set<render_mesh>(rend).add<local_to_world>().add<static_tag>();
         }
     }
 } // mkr
\ No newline at end of file
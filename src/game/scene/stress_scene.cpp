@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <log/log.h>
+#include "graphics/mesh/mesh_manager.h"
+#include "graphics/material/material_manager.h"
+#include "graphics/shader/shader_manager.h"
+#include "component/light.h"
+#include "component/static_tag.h"
+#include "game/tag/tag.h"
+#include "game/scene/stress_scene.h"
+
+namespace mkr {
+    namespace {
+        /// The number of transparent materials the transparent instances cycle through.
+        constexpr uint32_t num_transparent_materials = 4;
+
+        /// A colour that differs from its neighbours in the sequence, so that adjacent instances can be told apart.
+        colour sequence_colour(uint32_t _index, float _alpha) {
+            const float golden_ratio = 0.618034f;
+            const float h = std::fmod(static_cast<float>(_index) * golden_ratio, 1.0f);
+            return colour{0.5f + 0.5f * std::cos(2.0f * maths_util::pi * h),
+                          0.5f + 0.5f * std::cos(2.0f * maths_util::pi * (h + 1.0f / 3.0f)),
+                          0.5f + 0.5f * std::cos(2.0f * maths_util::pi * (h + 2.0f / 3.0f)),
+                          _alpha};
+        }
+
+        std::string opaque_material_name(uint32_t _index) { return "stress_op_" + std::to_string(_index); }
+
+        std::string transparent_material_name(uint32_t _index) { return "stress_tp_" + std::to_string(_index); }
+    }
+
+    stress_scene::stress_scene(const stress_grid& _grid) : grid_(_grid) {}
+
+    stress_scene::~stress_scene() {}
+
+    void stress_scene::init() {
+        init_input();
+        init_systems();
+        init_shaders();
+        init_meshes();
+        init_materials();
+        init_stress_materials();
+        init_levels();
+        init_player();
+        init_grid();
+        init_stress_lights();
+        bake_static();
+    }
+
+    void stress_scene::init_stress_materials() {
+        for (uint32_t i = 0; i < maths_util::max<uint32_t>(grid_.num_materials_, 1); ++i) {
+            auto mat = material_manager::instance().make_material(opaque_material_name(i));
+            mat->diffuse_colour_ = sequence_colour(i, 1.0f);
+            mat->render_path_ = render_path::deferred;
+        }
+
+        for (uint32_t i = 0; i < num_transparent_materials; ++i) {
+            auto mat = material_manager::instance().make_material(transparent_material_name(i));
+            mat->diffuse_colour_ = sequence_colour(i, 0.3f);
+            mat->alpha_weight_shader_ = shader_manager::instance().get_shader("alpha_weight");
+            mat->alpha_blend_shader_ = shader_manager::instance().get_shader("alpha_blend");
+            mat->render_path_ = render_path::transparent;
+        }
+    }
+
+    void stress_scene::init_grid() {
+        mesh* meshes[] = {
+            mesh_manager::instance().get_mesh("cube"),
+            mesh_manager::instance().get_mesh("sphere"),
+            mesh_manager::instance().get_mesh("monkey"),
+            mesh_manager::instance().get_mesh("torus"),
+            mesh_manager::instance().get_mesh("cone"),
+        };
+        constexpr size_t num_meshes = sizeof(meshes) / sizeof(meshes[0]);
+
+        const uint32_t num_materials = maths_util::max<uint32_t>(grid_.num_materials_, 1);
+        std::vector<material*> opaque_materials(num_materials);
+        for (uint32_t i = 0; i < num_materials; ++i) { opaque_materials[i] = material_manager::instance().get_material(opaque_material_name(i)); }
+        material* transparent_materials[num_transparent_materials];
+        for (uint32_t i = 0; i < num_transparent_materials; ++i) { transparent_materials[i] = material_manager::instance().get_material(transparent_material_name(i)); }
+
+        // Every n-th instance is transparent, so that they are spread evenly through the grid.
+        const float transparent_ratio = maths_util::clamp<float>(grid_.transparent_ratio_, 0.0f, 1.0f);
+        const size_t transparent_interval = transparent_ratio > 0.0f ? static_cast<size_t>(std::round(1.0f / transparent_ratio)) : 0;
+
+        const size_t count = static_cast<size_t>(grid_.count_x_) * grid_.count_y_ * grid_.count_z_;
+        std::vector<transform> transforms;
+        std::vector<render_mesh> render_meshes;
+        transforms.reserve(count);
+        render_meshes.reserve(count);
+
+        // Centre the grid on the x-axis, in front of the player.
+        const float scale = 0.5f;
+        const float offset_x = static_cast<float>(grid_.count_x_ - 1) * grid_.spacing_ * 0.5f;
+        const float offset_z = 5.0f;
+        for (uint32_t x = 0; x < grid_.count_x_; ++x) {
+            for (uint32_t z = 0; z < grid_.count_z_; ++z) {
+                for (uint32_t y = 0; y < grid_.count_y_; ++y) {
+                    const size_t index = transforms.size();
+                    const quaternion rotation{vector3::y_axis(), static_cast<float>(index % 360) * maths_util::deg2rad};
+                    if (grid_.hierarchy_ && y > 0) {
+                        // The child is placed relative to its parent, and inherits its parent's scale. Rotating around the y-axis leaves the offset straight up.
+                        transforms.emplace_back(vector3{0.0f, grid_.spacing_ / scale, 0.0f}, rotation, vector3{1.0f, 1.0f, 1.0f});
+                    } else {
+                        const vector3 position{static_cast<float>(x) * grid_.spacing_ - offset_x,
+                                               static_cast<float>(y) * grid_.spacing_ + 0.5f,
+                                               static_cast<float>(z) * grid_.spacing_ + offset_z};
+                        transforms.emplace_back(position, rotation, vector3{scale, scale, scale});
+                    }
+
+                    material* mat = (transparent_interval != 0 && index % transparent_interval == 0) ?
+                                    transparent_materials[(index / transparent_interval) % num_transparent_materials] :
+                                    opaque_materials[(index / num_meshes) % num_materials];
+                    render_meshes.push_back(render_mesh{mat, meshes[index % num_meshes]});
+                }
+            }
+        }
+
+        std::vector<flecs::id_t> tags;
+        if (grid_.static_) {
+            tags.push_back(world_.component<static_tag>().id());
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto entities = spawn(transforms, render_meshes, tags);
+
+        // Columns are consecutive, from the bottom up.
+        if (grid_.hierarchy_) {
+            for (size_t i = 0; i < entities.size(); ++i) {
+                if (i % grid_.count_y_ != 0) { world_.entity(entities[i]).child_of(entities[i - 1]); }
+            }
+        }
+
+        // Every n-th column spins, from its root.
+        const float animated_ratio = grid_.static_ ? 0.0f : maths_util::clamp<float>(grid_.animated_ratio_, 0.0f, 1.0f);
+        size_t num_animated = 0;
+        if (animated_ratio > 0.0f && grid_.count_y_ > 0) {
+            const size_t animated_interval = static_cast<size_t>(std::round(1.0f / animated_ratio));
+            const size_t column_step = grid_.hierarchy_ ? grid_.count_y_ : 1;
+            for (size_t i = 0; i < entities.size(); i += column_step) {
+                if ((i / grid_.count_y_) % animated_interval == 0) {
+                    world_.entity(entities[i]).add<rotate_tag>();
+                    ++num_animated;
+                }
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        MKR_INFO("stress_scene: spawned {} instances ({} animated) in {} ms", count, num_animated, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    void stress_scene::init_stress_lights() {
+        if (grid_.num_lights_ == 0) { return; }
+
+        // Scatter the lights evenly over the grid, just above it.
+        const float width = static_cast<float>(grid_.count_x_) * grid_.spacing_;
+        const float depth = static_cast<float>(grid_.count_z_) * grid_.spacing_;
+        const float height = static_cast<float>(grid_.count_y_) * grid_.spacing_ + 1.0f;
+        const auto per_row = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(grid_.num_lights_))));
+        for (uint32_t i = 0; i < grid_.num_lights_; ++i) {
+            const float u = (static_cast<float>(i % per_row) + 0.5f) / static_cast<float>(per_row);
+            const float v = (static_cast<float>(i / per_row) + 0.5f) / static_cast<float>(per_row);
+            transform light_trans;
+            light_trans.set_position({u * width - width * 0.5f, height, v * depth + 5.0f});
+            light lt;
+            lt.set_mode(light_mode::point);
+            lt.set_colour(sequence_colour(i, 1.0f));
+            lt.set_power(0.6f);
+            lt.set_cast_shadows(false);
+            world_.entity().set<transform>(light_trans).set<light>(lt).add<local_to_world>();
+        }
+        MKR_INFO("stress_scene: spawned {} point lights", grid_.num_lights_);
+    }
+} // mkr
\ No newline at end of file
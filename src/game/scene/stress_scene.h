@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include "game/scene/game_scene.h"
+
+namespace mkr {
+    /// The size of the grid of instances spawned by the stress_scene, and what they are made of.
+    struct stress_grid {
+        uint32_t count_x_ = 100;
+        uint32_t count_y_ = 10;
+        uint32_t count_z_ = 100;
+        float spacing_ = 2.0f;
+        /// Tag the instances as static so that they are baked into combined meshes.
+        bool static_ = false;
+        /// The number of opaque materials the instances cycle through. Each is a separate batch for the renderer.
+        uint32_t num_materials_ = 5;
+        /// The fraction of instances, in [0, 1], with a transparent material.
+        float transparent_ratio_ = 0.0f;
+        /// The number of point lights scattered above the grid.
+        uint32_t num_lights_ = 0;
+        /// Make every column of the grid a chain, where each instance is the child of the one below it.
+        bool hierarchy_ = false;
+        /// The fraction of columns, in [0, 1], that spin. With a hierarchy, the whole chain spins with its root. Static grids do not spin.
+        float animated_ratio_ = 0.0f;
+    };
+
+    /**
+     * A benchmark scene which spawns a configurable grid of mesh instances on top of the game scene's level, for stress testing.
+     * The instances cycle through a set of meshes and generated materials, and are spawned with scene::spawn().
+     * Run it with --frames=N to get a frame time report, to chart how the engine scales with the number of instances.
+     */
+    class stress_scene : public game_scene {
+    private:
+        stress_grid grid_;
+
+    protected:
+        void init_stress_materials();
+        void init_grid();
+        void init_stress_lights();
+
+    public:
+        explicit stress_scene(const stress_grid& _grid);
+        virtual ~stress_scene();
+
+        void init() override;
+    };
+} // mkr
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include <maths/vector3.h>
 #include "application/application.h"
 #include "input/input_manager.h"
-#include "event/event_listener.h"
+#include "event/event_bus.h"
 #include "system/system.h"
 #include "component/transform.h"
 #include "game/tag/tag.h"
@@ -13,54 +13,42 @@ namespace mkr {
     class body_control_system {
     private:
         event_listener input_listener_;
-        vector3 rotation_, translation_;
+        vector3 rotation_;
+        /// The movement input of the current frame. Integrated every simulation step until it is cleared at the end of the frame.
+        vector3 movement_;
 
     public:
         body_control_system() {
             // Input callback.
-            input_listener_.set_callback([&](const event* _event) {
-                const float velocity = 10.0f;
-
-                /*const auto* be = dynamic_cast<const button_event*>(_event);
-                if (be && be->state_ == button_state::pressed) {
-                    if (be->action_ == move_left) { translation_.x_ += application::instance().delta_time() * velocity; }
-                    if (be->action_ == move_right) { translation_.x_ -= application::instance().delta_time() * velocity; }
-                    if (be->action_ == move_forward) { translation_.z_ += application::instance().delta_time() * velocity; }
-                    if (be->action_ == move_backward) { translation_.z_ -= application::instance().delta_time() * velocity; }
-                    if (be->action_ == look_left) { rotation_.y_ += 180.0f * application::instance().delta_time(); }
-                    if (be->action_ == look_right) { rotation_.y_ -= 180.0f * application::instance().delta_time(); }
-                }*/
-
-                const auto* ae = dynamic_cast<const axis_event*>(_event);
-                if (ae) {
+            event_bus::instance().subscribe<axis_event>(&input_listener_, event_phase::input, [this](std::span<const axis_event> _events) {
+                for (const auto& e : _events) {
                     // Look
-                    if (ae->action_ == look_horizontal) { rotation_.y_ -= ae->value_/10.0f; }
+                    if (e.action_ == look_horizontal) { rotation_.y_ -= e.value_/10.0f; }
 
                     // Move
-                    if (ae->action_ == move_forward) {
-                        translation_.z_ += application::instance().delta_time() * velocity * ae->value_;
-                    }
-                    if (ae->action_ == move_left) {
-                        translation_.x_ += application::instance().delta_time() * velocity * ae->value_;
-                    }
+                    if (e.action_ == move_forward) { movement_.z_ = e.value_; }
+                    if (e.action_ == move_left) { movement_.x_ = e.value_; }
                 }
             });
-            input_manager::instance().get_event_dispatcher()->add_listener<button_event>(&input_listener_);
-            input_manager::instance().get_event_dispatcher()->add_listener<axis_event>(&input_listener_);
         }
 
         ~body_control_system() {
-            input_manager::instance().get_event_dispatcher()->remove_listener<button_event>(&input_listener_);
+            event_bus::instance().unsubscribe<axis_event>(&input_listener_);
         }
 
+        /// Clear the movement input. Call once per frame, after the simulation steps.
+        void clear_input() { movement_ = vector3::zero(); }
+
         void operator()(transform& _transform, const body_tag& _body) {
+            const float velocity = 10.0f;
+
             _transform.rotate(quaternion{vector3::y_axis(), rotation_.y_ * maths_util::deg2rad});
             rotation_ = vector3::zero();
 
-            auto forward = _transform.forward() * translation_.z_;
-            auto left = _transform.left() * translation_.x_;
+            const float distance = application::instance().fixed_delta_time() * velocity;
+            auto forward = _transform.forward() * movement_.z_ * distance;
+            auto left = _transform.left() * movement_.x_ * distance;
             _transform.translate(forward + left);
-            translation_ = vector3::zero();
         }
     };
 } // mkr
\ No newline at end of file
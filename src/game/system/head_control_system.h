@@ -4,7 +4,8 @@
 #include <maths/vector3.h>
 #include "application/application.h"
 #include "input/input_manager.h"
-#include "event/event_listener.h"
+#include "event/event_bus.h"
+#include "memory/memory_tracker.h"
 #include "component/transform.h"
 #include "system/system.h"
 #include "game/tag/tag.h"
@@ -18,40 +19,37 @@ namespace mkr {
 
     public:
         head_control_system() {
-            // Input callback.
-            input_listener_.set_callback([&](const event* _event) {
-                const auto* be = dynamic_cast<const button_event*>(_event);
-                if (be && be->state_ == button_state::pressed) {
-                    if (be->action_ == quit) { application::instance().terminate(); }
-                    if (be->action_ == look_up) { rotation_.x_ -= 180.0f * application::instance().delta_time(); }
-                    if (be->action_ == look_down) { rotation_.x_ += 180.0f * application::instance().delta_time(); }
+            // Input callbacks, given all of the frame's input events of each type at once.
+            auto& bus = event_bus::instance();
+            bus.subscribe<button_event>(&input_listener_, event_phase::input, [this](std::span<const button_event> _events) {
+                for (const auto& e : _events) {
+                    if (e.state_ != button_state::pressed) { continue; }
+                    if (e.action_ == quit) { application::instance().terminate(); }
+                    if (e.action_ == dump_memory) { memory_tracker::dump(); }
+                    if (e.action_ == look_up) { rotation_.x_ -= 180.0f * application::instance().delta_time(); }
+                    if (e.action_ == look_down) { rotation_.x_ += 180.0f * application::instance().delta_time(); }
                 }
-
-                const auto* ae = dynamic_cast<const axis_event*>(_event);
-                if (ae) {
-                    if (ae->action_ == look_vertical) { rotation_.x_ += ae->value_/10.0f; }
+            });
+            bus.subscribe<axis_event>(&input_listener_, event_phase::input, [this](std::span<const axis_event> _events) {
+                for (const auto& e : _events) {
+                    if (e.action_ == look_vertical) { rotation_.x_ += e.value_/10.0f; }
                 }
-
-                const auto* ce = dynamic_cast<const click_event*>(_event);
-                if (ce) {
-                    if (ce->state_ == button_state::down) {
-                        if (ce->action_ == test_click) { MKR_TRACE("Down: " + ce->position_.to_string()); }
-                    }
-                    if (ce->state_ == button_state::pressed) {
-                        if (ce->action_ == test_click) { MKR_TRACE("Pressed: " + ce->position_.to_string()); }
-                    }
-                    if (ce->state_ == button_state::up) {
-                        if (ce->action_ == test_click) { MKR_TRACE("Up: " + ce->position_.to_string()); }
-                    }
+            });
+            bus.subscribe<click_event>(&input_listener_, event_phase::input, [](std::span<const click_event> _events) {
+                for (const auto& e : _events) {
+                    if (e.action_ != test_click) { continue; }
+                    if (e.state_ == button_state::down) { MKR_TRACE("Down: " + e.position_.to_string()); }
+                    if (e.state_ == button_state::pressed) { MKR_TRACE("Pressed: " + e.position_.to_string()); }
+                    if (e.state_ == button_state::up) { MKR_TRACE("Up: " + e.position_.to_string()); }
                 }
             });
-            input_manager::instance().get_event_dispatcher()->add_listener<button_event>(&input_listener_);
-            input_manager::instance().get_event_dispatcher()->add_listener<axis_event>(&input_listener_);
-            input_manager::instance().get_event_dispatcher()->add_listener<click_event>(&input_listener_);
         }
 
         ~head_control_system() {
-            input_manager::instance().get_event_dispatcher()->remove_listener<button_event>(&input_listener_);
+            auto& bus = event_bus::instance();
+            bus.unsubscribe<button_event>(&input_listener_);
+            bus.unsubscribe<axis_event>(&input_listener_);
+            bus.unsubscribe<click_event>(&input_listener_);
         }
 
         void operator()(transform& _transform, const head_tag& _head) {
@@ -3,7 +3,7 @@
 #include <log/log.h>
 #include "input/input_event.h"
 #include "input/input_manager.h"
-#include "event/event_listener.h"
+#include "event/event_bus.h"
 
 namespace mkr {
     class motion_test_system {
@@ -13,18 +13,16 @@ namespace mkr {
     public:
         motion_test_system() {
             // Input callback.
-            input_listener_.set_callback([&](const event* _event) {
-                const auto* e = dynamic_cast<const motion_event*>(_event);
-                if (!e) { return; }
-
-                std::string info = "Position: " + e->position_.to_string() + " Delta: " + e->delta_.to_string();
-                MKR_INFO(info);
+            event_bus::instance().subscribe<motion_event>(&input_listener_, event_phase::input, [](std::span<const motion_event> _events) {
+                for (const auto& e : _events) {
+                    std::string info = "Position: " + e.position_.to_string() + " Delta: " + e.delta_.to_string();
+                    MKR_INFO(info);
+                }
             });
-            input_manager::instance().get_event_dispatcher()->add_listener<motion_event>(&input_listener_);
         }
 
         ~motion_test_system() {
-            input_manager::instance().get_event_dispatcher()->remove_listener<motion_event>(&input_listener_);
+            event_bus::instance().unsubscribe<motion_event>(&input_listener_);
         }
 
         void operator()() {}
@@ -1,8 +1,7 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 
 namespace mkr {
     enum window_flags : uint32_t {
@@ -11,39 +10,18 @@ namespace mkr {
         borderless = 2,
     };
 
+    /// The surface that the renderer presents to, which owns the OpenGL context.
     class app_window {
-    private:
+    protected:
         std::string title_;
         uint32_t width_, height_;
         uint32_t flags_;
-        SDL_Window* window_;
-        SDL_GLContext gl_context_;
 
-    public:
         app_window(const std::string& _title, uint32_t _width, uint32_t _height, uint32_t _flags)
-                : title_(_title), width_(_width), height_(_height), flags_(_flags) {
-            // Create window.
-            window_ = SDL_CreateWindow(title_.c_str(),
-                                       SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-                                       static_cast<int>(width_), static_cast<int>(height_),
-                                       SDL_WINDOW_OPENGL /* | SDL_WINDOW_INPUT_GRABBED */);
-            SDL_SetWindowFullscreen(window_, is_fullscreen() ? SDL_TRUE : SDL_FALSE);
-            SDL_SetWindowBordered(window_, is_borderless() ? SDL_FALSE : SDL_TRUE);
-
-            // Query actual window size.
-            int actual_width, actual_height;
-            SDL_GetWindowSize(window_, &actual_width, &actual_height);
-            width_ = static_cast<uint32_t>(actual_width);
-            height_ = static_cast<uint32_t>(actual_height);
-
-            // Create OpenGL context.
-            gl_context_ = SDL_GL_CreateContext(window_);
-        }
-
-        ~app_window() {
-            SDL_DestroyWindow(window_);
-            SDL_GL_DeleteContext(gl_context_);
-        }
+                : title_(_title), width_(_width), height_(_height), flags_(_flags) {}
+
+    public:
+        virtual ~app_window() {}
 
         [[nodiscard]] inline bool is_fullscreen() const { return flags_ & fullscreen; }
 
@@ -55,6 +33,9 @@ namespace mkr {
 
         [[nodiscard]] inline uint32_t height() const { return height_; }
 
-        inline void swap_buffers() { SDL_GL_SwapWindow(window_); }
+        /// Whether there is a default framebuffer to present to. Without one, the renderer presents to an offscreen framebuffer instead.
+        [[nodiscard]] virtual bool has_default_framebuffer() const = 0;
+
+        virtual void swap_buffers() = 0;
     };
 }
\ No newline at end of file
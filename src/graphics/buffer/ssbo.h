@@ -0,0 +1,52 @@
+#pragma once
+
+#include <bit>
+#include <GL/glew.h>
+#include "graphics/device/graphics_device.h"
+
+namespace mkr {
+    /**
+     * A shader storage buffer object.
+     * The buffer only grows. Its storage is reallocated when the data no longer fits, and is otherwise updated in place.
+     */
+    class ssbo {
+    private:
+        /// Binding a buffer with no storage is an error, so every buffer has at least this many bytes.
+        static constexpr GLsizeiptr min_capacity_ = 256;
+
+        GLuint handle_;
+        GLsizeiptr capacity_;
+
+    public:
+        ssbo() : capacity_{min_capacity_} {
+            gfx().create_buffers(1, &handle_);
+            gfx().named_buffer_data(handle_, capacity_, nullptr, GL_DYNAMIC_DRAW);
+        }
+
+        ~ssbo() {
+            gfx().delete_buffers(1, &handle_);
+        }
+
+        GLuint handle() const {
+            return handle_;
+        }
+
+        GLsizeiptr capacity() const {
+            return capacity_;
+        }
+
+        void bind(GLuint _binding) {
+            gfx().bind_buffer_base(GL_SHADER_STORAGE_BUFFER, _binding, handle_);
+        }
+
+        void set_data(GLsizeiptr _size, const void* _data) {
+            if (_size > capacity_) {
+                capacity_ = static_cast<GLsizeiptr>(std::bit_ceil(static_cast<size_t>(_size)));
+                gfx().named_buffer_data(handle_, capacity_, nullptr, GL_DYNAMIC_DRAW);
+            }
+            if (_size > 0) {
+                gfx().named_buffer_sub_data(handle_, 0, _size, _data);
+            }
+        }
+    };
+}
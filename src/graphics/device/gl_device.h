@@ -0,0 +1,126 @@
+#pragma once
+
+#include "graphics/device/graphics_device.h"
+
+namespace mkr {
+    /// Forwards every call to OpenGL.
+    class gl_device : public graphics_device {
+    public:
+        gl_device() = default;
+        virtual ~gl_device() = default;
+
+        // State
+        inline void enable(GLenum _cap) override { glEnable(_cap); }
+        inline void disable(GLenum _cap) override { glDisable(_cap); }
+        inline void blend_func(GLenum _sfactor, GLenum _dfactor) override { glBlendFunc(_sfactor, _dfactor); }
+        inline void blend_funci(GLuint _buf, GLenum _src, GLenum _dst) override { glBlendFunci(_buf, _src, _dst); }
+        inline void color_mask(GLboolean _red, GLboolean _green, GLboolean _blue, GLboolean _alpha) override { glColorMask(_red, _green, _blue, _alpha); }
+        inline void depth_func(GLenum _func) override { glDepthFunc(_func); }
+        inline void depth_mask(GLboolean _flag) override { glDepthMask(_flag); }
+        inline void stencil_func(GLenum _func, GLint _ref, GLuint _mask) override { glStencilFunc(_func, _ref, _mask); }
+        inline void stencil_mask(GLuint _mask) override { glStencilMask(_mask); }
+        inline void stencil_op(GLenum _fail, GLenum _zfail, GLenum _zpass) override { glStencilOp(_fail, _zfail, _zpass); }
+        inline void stencil_op_separate(GLenum _face, GLenum _sfail, GLenum _dpfail, GLenum _dppass) override { glStencilOpSeparate(_face, _sfail, _dpfail, _dppass); }
+        inline void viewport(GLint _x, GLint _y, GLsizei _width, GLsizei _height) override { glViewport(_x, _y, _width, _height); }
+        inline void scissor(GLint _x, GLint _y, GLsizei _width, GLsizei _height) override { glScissor(_x, _y, _width, _height); }
+        inline void finish() override { glFinish(); }
+
+        // Buffers
+        inline void create_buffers(GLsizei _n, GLuint* _buffers) override { glCreateBuffers(_n, _buffers); }
+        inline void delete_buffers(GLsizei _n, const GLuint* _buffers) override { glDeleteBuffers(_n, _buffers); }
+        inline void bind_buffer(GLenum _target, GLuint _buffer) override { glBindBuffer(_target, _buffer); }
+        inline void bind_buffer_base(GLenum _target, GLuint _index, GLuint _buffer) override { glBindBufferBase(_target, _index, _buffer); }
+        inline void named_buffer_data(GLuint _buffer, GLsizeiptr _size, const void* _data, GLenum _usage) override { glNamedBufferData(_buffer, _size, _data, _usage); }
+        inline void named_buffer_sub_data(GLuint _buffer, GLintptr _offset, GLsizeiptr _size, const void* _data) override { glNamedBufferSubData(_buffer, _offset, _size, _data); }
+
+        // Vertex Arrays
+        inline void create_vertex_arrays(GLsizei _n, GLuint* _arrays) override { glCreateVertexArrays(_n, _arrays); }
+        inline void delete_vertex_arrays(GLsizei _n, const GLuint* _arrays) override { glDeleteVertexArrays(_n, _arrays); }
+        inline void bind_vertex_array(GLuint _array) override { glBindVertexArray(_array); }
+        inline void enable_vertex_array_attrib(GLuint _vaobj, GLuint _index) override { glEnableVertexArrayAttrib(_vaobj, _index); }
+        inline void vertex_array_attrib_binding(GLuint _vaobj, GLuint _attribindex, GLuint _bindingindex) override { glVertexArrayAttribBinding(_vaobj, _attribindex, _bindingindex); }
+        inline void vertex_array_attrib_format(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLboolean _normalized, GLuint _relativeoffset) override { glVertexArrayAttribFormat(_vaobj, _attribindex, _size, _type, _normalized, _relativeoffset); }
+        inline void vertex_array_attrib_iformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) override { glVertexArrayAttribIFormat(_vaobj, _attribindex, _size, _type, _relativeoffset); }
+        inline void vertex_array_attrib_lformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) override { glVertexArrayAttribLFormat(_vaobj, _attribindex, _size, _type, _relativeoffset); }
+        inline void vertex_array_binding_divisor(GLuint _vaobj, GLuint _bindingindex, GLuint _divisor) override { glVertexArrayBindingDivisor(_vaobj, _bindingindex, _divisor); }
+        inline void vertex_array_element_buffer(GLuint _vaobj, GLuint _buffer) override { glVertexArrayElementBuffer(_vaobj, _buffer); }
+        inline void vertex_array_vertex_buffer(GLuint _vaobj, GLuint _bindingindex, GLuint _buffer, GLintptr _offset, GLsizei _stride) override { glVertexArrayVertexBuffer(_vaobj, _bindingindex, _buffer, _offset, _stride); }
+
+        // Textures
+        inline void create_textures(GLenum _target, GLsizei _n, GLuint* _textures) override { glCreateTextures(_target, _n, _textures); }
+        inline void delete_textures(GLsizei _n, const GLuint* _textures) override { glDeleteTextures(_n, _textures); }
+        inline void bind_texture_unit(GLuint _unit, GLuint _texture) override { glBindTextureUnit(_unit, _texture); }
+        inline void texture_parameteri(GLuint _texture, GLenum _pname, GLint _param) override { glTextureParameteri(_texture, _pname, _param); }
+        inline void texture_storage_2d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height) override { glTextureStorage2D(_texture, _levels, _internalformat, _width, _height); }
+        inline void texture_storage_3d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height, GLsizei _depth) override { glTextureStorage3D(_texture, _levels, _internalformat, _width, _height, _depth); }
+        inline void texture_sub_image_2d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLsizei _width, GLsizei _height, GLenum _format, GLenum _type, const void* _pixels) override { glTextureSubImage2D(_texture, _level, _xoffset, _yoffset, _width, _height, _format, _type, _pixels); }
+        inline void texture_sub_image_3d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLint _zoffset, GLsizei _width, GLsizei _height, GLsizei _depth, GLenum _format, GLenum _type, const void* _pixels) override { glTextureSubImage3D(_texture, _level, _xoffset, _yoffset, _zoffset, _width, _height, _depth, _format, _type, _pixels); }
+        inline void generate_texture_mipmap(GLuint _texture) override { glGenerateTextureMipmap(_texture); }
+        inline void copy_image_sub_data(GLuint _src_name, GLenum _src_target, GLint _src_level, GLint _src_x, GLint _src_y, GLint _src_z, GLuint _dst_name, GLenum _dst_target, GLint _dst_level, GLint _dst_x, GLint _dst_y, GLint _dst_z, GLsizei _src_width, GLsizei _src_height, GLsizei _src_depth) override { glCopyImageSubData(_src_name, _src_target, _src_level, _src_x, _src_y, _src_z, _dst_name, _dst_target, _dst_level, _dst_x, _dst_y, _dst_z, _src_width, _src_height, _src_depth); }
+
+        // Framebuffers
+        inline void create_framebuffers(GLsizei _n, GLuint* _framebuffers) override { glCreateFramebuffers(_n, _framebuffers); }
+        inline void delete_framebuffers(GLsizei _n, const GLuint* _framebuffers) override { glDeleteFramebuffers(_n, _framebuffers); }
+        inline void bind_framebuffer(GLenum _target, GLuint _framebuffer) override { glBindFramebuffer(_target, _framebuffer); }
+        inline GLenum check_named_framebuffer_status(GLuint _framebuffer, GLenum _target) override { return glCheckNamedFramebufferStatus(_framebuffer, _target); }
+        inline void named_framebuffer_texture(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level) override { glNamedFramebufferTexture(_framebuffer, _attachment, _texture, _level); }
+        inline void named_framebuffer_texture_layer(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level, GLint _layer) override { glNamedFramebufferTextureLayer(_framebuffer, _attachment, _texture, _level, _layer); }
+        inline void named_framebuffer_draw_buffer(GLuint _framebuffer, GLenum _mode) override { glNamedFramebufferDrawBuffer(_framebuffer, _mode); }
+        inline void named_framebuffer_draw_buffers(GLuint _framebuffer, GLsizei _n, const GLenum* _bufs) override { glNamedFramebufferDrawBuffers(_framebuffer, _n, _bufs); }
+        inline void named_framebuffer_read_buffer(GLuint _framebuffer, GLenum _mode) override { glNamedFramebufferReadBuffer(_framebuffer, _mode); }
+        inline void clear_named_framebufferfv(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat* _value) override { glClearNamedFramebufferfv(_framebuffer, _buffer, _drawbuffer, _value); }
+        inline void clear_named_framebufferfi(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat _depth, GLint _stencil) override { glClearNamedFramebufferfi(_framebuffer, _buffer, _drawbuffer, _depth, _stencil); }
+        inline void blit_named_framebuffer(GLuint _read_framebuffer, GLuint _draw_framebuffer, GLint _src_x0, GLint _src_y0, GLint _src_x1, GLint _src_y1, GLint _dst_x0, GLint _dst_y0, GLint _dst_x1, GLint _dst_y1, GLbitfield _mask, GLenum _filter) override { glBlitNamedFramebuffer(_read_framebuffer, _draw_framebuffer, _src_x0, _src_y0, _src_x1, _src_y1, _dst_x0, _dst_y0, _dst_x1, _dst_y1, _mask, _filter); }
+
+        // Shaders
+        inline GLuint create_shader(GLenum _type) override { return glCreateShader(_type); }
+        inline void delete_shader(GLuint _shader) override { glDeleteShader(_shader); }
+        inline void shader_source(GLuint _shader, GLsizei _count, const GLchar* const* _string, const GLint* _length) override { glShaderSource(_shader, _count, _string, _length); }
+        inline void compile_shader(GLuint _shader) override { glCompileShader(_shader); }
+        inline void get_shaderiv(GLuint _shader, GLenum _pname, GLint* _param) override { glGetShaderiv(_shader, _pname, _param); }
+        inline void get_shader_info_log(GLuint _shader, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) override { glGetShaderInfoLog(_shader, _buf_size, _length, _info_log); }
+        inline GLuint create_program() override { return glCreateProgram(); }
+        inline void delete_program(GLuint _program) override { glDeleteProgram(_program); }
+        inline void attach_shader(GLuint _program, GLuint _shader) override { glAttachShader(_program, _shader); }
+        inline void detach_shader(GLuint _program, GLuint _shader) override { glDetachShader(_program, _shader); }
+        inline void link_program(GLuint _program) override { glLinkProgram(_program); }
+        inline void get_programiv(GLuint _program, GLenum _pname, GLint* _param) override { glGetProgramiv(_program, _pname, _param); }
+        inline void get_program_info_log(GLuint _program, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) override { glGetProgramInfoLog(_program, _buf_size, _length, _info_log); }
+        inline void use_program(GLuint _program) override { glUseProgram(_program); }
+        inline GLint get_uniform_location(GLuint _program, const GLchar* _name) override { return glGetUniformLocation(_program, _name); }
+        inline GLint get_attrib_location(GLuint _program, const GLchar* _name) override { return glGetAttribLocation(_program, _name); }
+
+        // Uniforms
+        inline void program_uniform1f(GLuint _program, GLint _location, GLfloat _x) override { glProgramUniform1f(_program, _location, _x); }
+        inline void program_uniform1i(GLuint _program, GLint _location, GLint _x) override { glProgramUniform1i(_program, _location, _x); }
+        inline void program_uniform1ui(GLuint _program, GLint _location, GLuint _x) override { glProgramUniform1ui(_program, _location, _x); }
+        inline void program_uniform2f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y) override { glProgramUniform2f(_program, _location, _x, _y); }
+        inline void program_uniform2i(GLuint _program, GLint _location, GLint _x, GLint _y) override { glProgramUniform2i(_program, _location, _x, _y); }
+        inline void program_uniform2ui(GLuint _program, GLint _location, GLuint _x, GLuint _y) override { glProgramUniform2ui(_program, _location, _x, _y); }
+        inline void program_uniform3f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z) override { glProgramUniform3f(_program, _location, _x, _y, _z); }
+        inline void program_uniform3i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z) override { glProgramUniform3i(_program, _location, _x, _y, _z); }
+        inline void program_uniform3ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z) override { glProgramUniform3ui(_program, _location, _x, _y, _z); }
+        inline void program_uniform4f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z, GLfloat _w) override { glProgramUniform4f(_program, _location, _x, _y, _z, _w); }
+        inline void program_uniform4i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z, GLint _w) override { glProgramUniform4i(_program, _location, _x, _y, _z, _w); }
+        inline void program_uniform4ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z, GLuint _w) override { glProgramUniform4ui(_program, _location, _x, _y, _z, _w); }
+        inline void program_uniform_matrix2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix2fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix2x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix2x3fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix2x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix2x4fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix3fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix3x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix3x2fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix3x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix3x4fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix4fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix4x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix4x2fv(_program, _location, _count, _transpose, _value); }
+        inline void program_uniform_matrix4x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override { glProgramUniformMatrix4x3fv(_program, _location, _count, _transpose, _value); }
+
+        // Draws
+        inline void draw_elements_instanced(GLenum _mode, GLsizei _count, GLenum _type, const void* _indices, GLsizei _primcount) override { glDrawElementsInstanced(_mode, _count, _type, _indices, _primcount); }
+
+        // Queries
+        inline void gen_queries(GLsizei _n, GLuint* _ids) override { glGenQueries(_n, _ids); }
+        inline void delete_queries(GLsizei _n, const GLuint* _ids) override { glDeleteQueries(_n, _ids); }
+        inline void query_counter(GLuint _id, GLenum _target) override { glQueryCounter(_id, _target); }
+        inline void get_query_objectiv(GLuint _id, GLenum _pname, GLint* _params) override { glGetQueryObjectiv(_id, _pname, _params); }
+        inline void get_query_objectui64v(GLuint _id, GLenum _pname, GLuint64* _params) override { glGetQueryObjectui64v(_id, _pname, _params); }
+    };
+} // mkr
\ No newline at end of file
@@ -0,0 +1,14 @@
+#include "graphics/device/graphics_device.h"
+#include "graphics/device/gl_device.h"
+
+namespace mkr {
+    namespace {
+        gl_device default_device;
+    }
+
+    graphics_device* graphics_device::current_ = &default_device;
+
+    void graphics_device::set_current(graphics_device* _device) {
+        current_ = _device ? _device : &default_device;
+    }
+} // mkr
\ No newline at end of file
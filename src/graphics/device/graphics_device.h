@@ -0,0 +1,144 @@
+#pragma once
+
+#include <GL/glew.h>
+
+namespace mkr {
+    /**
+     * The graphics API calls made by the renderer and the graphics resources, such as buffers, textures, framebuffers and shaders.
+     * Each call mirrors the OpenGL function of the same name, so that the real device can forward them as they are.
+     * Other devices can stand in for OpenGL, such as the null device, which measures the renderer's CPU cost on machines without a GPU.
+     */
+    class graphics_device {
+    private:
+        static graphics_device* current_;
+
+    public:
+        graphics_device() = default;
+        virtual ~graphics_device() = default;
+
+        /// The device that graphics calls are currently made through. Defaults to OpenGL.
+        [[nodiscard]] static inline graphics_device& current() { return *current_; }
+        /// Make graphics calls through another device. Must be set before any graphics resource is created, as resources are not moved between devices.
+        static void set_current(graphics_device* _device);
+
+        /// Called once a frame has been presented.
+        virtual void end_frame() {}
+
+        // State
+        virtual void enable(GLenum _cap) = 0;
+        virtual void disable(GLenum _cap) = 0;
+        virtual void blend_func(GLenum _sfactor, GLenum _dfactor) = 0;
+        virtual void blend_funci(GLuint _buf, GLenum _src, GLenum _dst) = 0;
+        virtual void color_mask(GLboolean _red, GLboolean _green, GLboolean _blue, GLboolean _alpha) = 0;
+        virtual void depth_func(GLenum _func) = 0;
+        virtual void depth_mask(GLboolean _flag) = 0;
+        virtual void stencil_func(GLenum _func, GLint _ref, GLuint _mask) = 0;
+        virtual void stencil_mask(GLuint _mask) = 0;
+        virtual void stencil_op(GLenum _fail, GLenum _zfail, GLenum _zpass) = 0;
+        virtual void stencil_op_separate(GLenum _face, GLenum _sfail, GLenum _dpfail, GLenum _dppass) = 0;
+        virtual void viewport(GLint _x, GLint _y, GLsizei _width, GLsizei _height) = 0;
+        virtual void scissor(GLint _x, GLint _y, GLsizei _width, GLsizei _height) = 0;
+        virtual void finish() = 0;
+
+        // Buffers
+        virtual void create_buffers(GLsizei _n, GLuint* _buffers) = 0;
+        virtual void delete_buffers(GLsizei _n, const GLuint* _buffers) = 0;
+        virtual void bind_buffer(GLenum _target, GLuint _buffer) = 0;
+        virtual void bind_buffer_base(GLenum _target, GLuint _index, GLuint _buffer) = 0;
+        virtual void named_buffer_data(GLuint _buffer, GLsizeiptr _size, const void* _data, GLenum _usage) = 0;
+        virtual void named_buffer_sub_data(GLuint _buffer, GLintptr _offset, GLsizeiptr _size, const void* _data) = 0;
+
+        // Vertex Arrays
+        virtual void create_vertex_arrays(GLsizei _n, GLuint* _arrays) = 0;
+        virtual void delete_vertex_arrays(GLsizei _n, const GLuint* _arrays) = 0;
+        virtual void bind_vertex_array(GLuint _array) = 0;
+        virtual void enable_vertex_array_attrib(GLuint _vaobj, GLuint _index) = 0;
+        virtual void vertex_array_attrib_binding(GLuint _vaobj, GLuint _attribindex, GLuint _bindingindex) = 0;
+        virtual void vertex_array_attrib_format(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLboolean _normalized, GLuint _relativeoffset) = 0;
+        virtual void vertex_array_attrib_iformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) = 0;
+        virtual void vertex_array_attrib_lformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) = 0;
+        virtual void vertex_array_binding_divisor(GLuint _vaobj, GLuint _bindingindex, GLuint _divisor) = 0;
+        virtual void vertex_array_element_buffer(GLuint _vaobj, GLuint _buffer) = 0;
+        virtual void vertex_array_vertex_buffer(GLuint _vaobj, GLuint _bindingindex, GLuint _buffer, GLintptr _offset, GLsizei _stride) = 0;
+
+        // Textures
+        virtual void create_textures(GLenum _target, GLsizei _n, GLuint* _textures) = 0;
+        virtual void delete_textures(GLsizei _n, const GLuint* _textures) = 0;
+        virtual void bind_texture_unit(GLuint _unit, GLuint _texture) = 0;
+        virtual void texture_parameteri(GLuint _texture, GLenum _pname, GLint _param) = 0;
+        virtual void texture_storage_2d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height) = 0;
+        virtual void texture_storage_3d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height, GLsizei _depth) = 0;
+        virtual void texture_sub_image_2d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLsizei _width, GLsizei _height, GLenum _format, GLenum _type, const void* _pixels) = 0;
+        virtual void texture_sub_image_3d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLint _zoffset, GLsizei _width, GLsizei _height, GLsizei _depth, GLenum _format, GLenum _type, const void* _pixels) = 0;
+        virtual void generate_texture_mipmap(GLuint _texture) = 0;
+        virtual void copy_image_sub_data(GLuint _src_name, GLenum _src_target, GLint _src_level, GLint _src_x, GLint _src_y, GLint _src_z, GLuint _dst_name, GLenum _dst_target, GLint _dst_level, GLint _dst_x, GLint _dst_y, GLint _dst_z, GLsizei _src_width, GLsizei _src_height, GLsizei _src_depth) = 0;
+
+        // Framebuffers
+        virtual void create_framebuffers(GLsizei _n, GLuint* _framebuffers) = 0;
+        virtual void delete_framebuffers(GLsizei _n, const GLuint* _framebuffers) = 0;
+        virtual void bind_framebuffer(GLenum _target, GLuint _framebuffer) = 0;
+        virtual GLenum check_named_framebuffer_status(GLuint _framebuffer, GLenum _target) = 0;
+        virtual void named_framebuffer_texture(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level) = 0;
+        virtual void named_framebuffer_texture_layer(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level, GLint _layer) = 0;
+        virtual void named_framebuffer_draw_buffer(GLuint _framebuffer, GLenum _mode) = 0;
+        virtual void named_framebuffer_draw_buffers(GLuint _framebuffer, GLsizei _n, const GLenum* _bufs) = 0;
+        virtual void named_framebuffer_read_buffer(GLuint _framebuffer, GLenum _mode) = 0;
+        virtual void clear_named_framebufferfv(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat* _value) = 0;
+        virtual void clear_named_framebufferfi(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat _depth, GLint _stencil) = 0;
+        virtual void blit_named_framebuffer(GLuint _read_framebuffer, GLuint _draw_framebuffer, GLint _src_x0, GLint _src_y0, GLint _src_x1, GLint _src_y1, GLint _dst_x0, GLint _dst_y0, GLint _dst_x1, GLint _dst_y1, GLbitfield _mask, GLenum _filter) = 0;
+
+        // Shaders
+        virtual GLuint create_shader(GLenum _type) = 0;
+        virtual void delete_shader(GLuint _shader) = 0;
+        virtual void shader_source(GLuint _shader, GLsizei _count, const GLchar* const* _string, const GLint* _length) = 0;
+        virtual void compile_shader(GLuint _shader) = 0;
+        virtual void get_shaderiv(GLuint _shader, GLenum _pname, GLint* _param) = 0;
+        virtual void get_shader_info_log(GLuint _shader, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) = 0;
+        virtual GLuint create_program() = 0;
+        virtual void delete_program(GLuint _program) = 0;
+        virtual void attach_shader(GLuint _program, GLuint _shader) = 0;
+        virtual void detach_shader(GLuint _program, GLuint _shader) = 0;
+        virtual void link_program(GLuint _program) = 0;
+        virtual void get_programiv(GLuint _program, GLenum _pname, GLint* _param) = 0;
+        virtual void get_program_info_log(GLuint _program, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) = 0;
+        virtual void use_program(GLuint _program) = 0;
+        virtual GLint get_uniform_location(GLuint _program, const GLchar* _name) = 0;
+        virtual GLint get_attrib_location(GLuint _program, const GLchar* _name) = 0;
+
+        // Uniforms
+        virtual void program_uniform1f(GLuint _program, GLint _location, GLfloat _x) = 0;
+        virtual void program_uniform1i(GLuint _program, GLint _location, GLint _x) = 0;
+        virtual void program_uniform1ui(GLuint _program, GLint _location, GLuint _x) = 0;
+        virtual void program_uniform2f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y) = 0;
+        virtual void program_uniform2i(GLuint _program, GLint _location, GLint _x, GLint _y) = 0;
+        virtual void program_uniform2ui(GLuint _program, GLint _location, GLuint _x, GLuint _y) = 0;
+        virtual void program_uniform3f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z) = 0;
+        virtual void program_uniform3i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z) = 0;
+        virtual void program_uniform3ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z) = 0;
+        virtual void program_uniform4f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z, GLfloat _w) = 0;
+        virtual void program_uniform4i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z, GLint _w) = 0;
+        virtual void program_uniform4ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z, GLuint _w) = 0;
+        virtual void program_uniform_matrix2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix2x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix2x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix3x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix3x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix4x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+        virtual void program_uniform_matrix4x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) = 0;
+
+        // Draws
+        virtual void draw_elements_instanced(GLenum _mode, GLsizei _count, GLenum _type, const void* _indices, GLsizei _primcount) = 0;
+
+        // Queries
+        virtual void gen_queries(GLsizei _n, GLuint* _ids) = 0;
+        virtual void delete_queries(GLsizei _n, const GLuint* _ids) = 0;
+        virtual void query_counter(GLuint _id, GLenum _target) = 0;
+        virtual void get_query_objectiv(GLuint _id, GLenum _pname, GLint* _params) = 0;
+        virtual void get_query_objectui64v(GLuint _id, GLenum _pname, GLuint64* _params) = 0;
+    };
+
+    /// The device that graphics calls are currently made through.
+    [[nodiscard]] inline graphics_device& gfx() { return graphics_device::current(); }
+} // mkr
\ No newline at end of file
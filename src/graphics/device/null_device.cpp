@@ -0,0 +1,527 @@
+#include <log/log.h>
+#include "graphics/device/null_device.h"
+
+namespace mkr {
+    void null_device::create_handles(GLsizei _n, GLuint* _handles) {
+        for (GLsizei i = 0; i < _n; ++i) { _handles[i] = next_handle_++; }
+        stats_.num_resources_created_ += static_cast<uint64_t>(_n);
+    }
+
+    uint64_t null_device::pixel_size(GLenum _format, GLenum _type) {
+        uint64_t num_components = 4;
+        switch (_format) {
+            case GL_RED:
+            case GL_DEPTH_COMPONENT:
+            case GL_STENCIL_INDEX:
+                num_components = 1;
+                break;
+            case GL_RG:
+            case GL_DEPTH_STENCIL:
+                num_components = 2;
+                break;
+            case GL_RGB:
+            case GL_BGR:
+                num_components = 3;
+                break;
+            default:
+                break;
+        }
+
+        switch (_type) {
+            case GL_UNSIGNED_BYTE:
+            case GL_BYTE:
+                return num_components;
+            case GL_UNSIGNED_SHORT:
+            case GL_SHORT:
+            case GL_HALF_FLOAT:
+                return num_components * 2;
+            default:
+                return num_components * 4;
+        }
+    }
+
+    void null_device::end_frame() {
+        total_stats_.num_commands_ += stats_.num_commands_;
+        total_stats_.num_draw_calls_ += stats_.num_draw_calls_;
+        total_stats_.num_instances_ += stats_.num_instances_;
+        total_stats_.num_indices_ += stats_.num_indices_;
+        total_stats_.bytes_uploaded_ += stats_.bytes_uploaded_;
+        total_stats_.num_state_changes_ += stats_.num_state_changes_;
+        total_stats_.num_uniform_updates_ += stats_.num_uniform_updates_;
+        total_stats_.num_resources_created_ += stats_.num_resources_created_;
+        ++num_frames_;
+
+        stats_ = device_stats{};
+        commands_.clear();
+    }
+
+    void null_device::log() const {
+        if (num_frames_ == 0) { return; }
+        const double num_frames = static_cast<double>(num_frames_);
+        MKR_CORE_INFO("Null device: {} frames, per frame avg {:.1f} commands, {:.1f} draw calls, {:.1f} instances, {:.1f} state changes, {:.1f} uniform updates, {:.1f} bytes uploaded",
+                      num_frames_, total_stats_.num_commands_ / num_frames, total_stats_.num_draw_calls_ / num_frames, total_stats_.num_instances_ / num_frames,
+                      total_stats_.num_state_changes_ / num_frames, total_stats_.num_uniform_updates_ / num_frames, total_stats_.bytes_uploaded_ / num_frames);
+    }
+
+    // State
+    void null_device::enable(GLenum _cap) {
+        record(device_command::enable);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::disable(GLenum _cap) {
+        record(device_command::disable);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::blend_func(GLenum _sfactor, GLenum _dfactor) {
+        record(device_command::blend_func);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::blend_funci(GLuint _buf, GLenum _src, GLenum _dst) {
+        record(device_command::blend_funci);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::color_mask(GLboolean _red, GLboolean _green, GLboolean _blue, GLboolean _alpha) {
+        record(device_command::color_mask);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::depth_func(GLenum _func) {
+        record(device_command::depth_func);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::depth_mask(GLboolean _flag) {
+        record(device_command::depth_mask);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::stencil_func(GLenum _func, GLint _ref, GLuint _mask) {
+        record(device_command::stencil_func);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::stencil_mask(GLuint _mask) {
+        record(device_command::stencil_mask);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::stencil_op(GLenum _fail, GLenum _zfail, GLenum _zpass) {
+        record(device_command::stencil_op);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::stencil_op_separate(GLenum _face, GLenum _sfail, GLenum _dpfail, GLenum _dppass) {
+        record(device_command::stencil_op_separate);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::viewport(GLint _x, GLint _y, GLsizei _width, GLsizei _height) {
+        record(device_command::viewport);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::scissor(GLint _x, GLint _y, GLsizei _width, GLsizei _height) {
+        record(device_command::scissor);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::finish() {
+        record(device_command::finish);
+    }
+
+    // Buffers
+    void null_device::create_buffers(GLsizei _n, GLuint* _buffers) {
+        record(device_command::create_buffers);
+        create_handles(_n, _buffers);
+    }
+
+    void null_device::delete_buffers(GLsizei _n, const GLuint* _buffers) {
+        record(device_command::delete_buffers);
+    }
+
+    void null_device::bind_buffer(GLenum _target, GLuint _buffer) {
+        record(device_command::bind_buffer);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::bind_buffer_base(GLenum _target, GLuint _index, GLuint _buffer) {
+        record(device_command::bind_buffer_base);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::named_buffer_data(GLuint _buffer, GLsizeiptr _size, const void* _data, GLenum _usage) {
+        record(device_command::named_buffer_data);
+        if (_data) { stats_.bytes_uploaded_ += static_cast<uint64_t>(_size); }
+    }
+
+    void null_device::named_buffer_sub_data(GLuint _buffer, GLintptr _offset, GLsizeiptr _size, const void* _data) {
+        record(device_command::named_buffer_sub_data);
+        stats_.bytes_uploaded_ += static_cast<uint64_t>(_size);
+    }
+
+    // Vertex Arrays
+    void null_device::create_vertex_arrays(GLsizei _n, GLuint* _arrays) {
+        record(device_command::create_vertex_arrays);
+        create_handles(_n, _arrays);
+    }
+
+    void null_device::delete_vertex_arrays(GLsizei _n, const GLuint* _arrays) {
+        record(device_command::delete_vertex_arrays);
+    }
+
+    void null_device::bind_vertex_array(GLuint _array) {
+        record(device_command::bind_vertex_array);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::enable_vertex_array_attrib(GLuint _vaobj, GLuint _index) {
+        record(device_command::enable_vertex_array_attrib);
+    }
+
+    void null_device::vertex_array_attrib_binding(GLuint _vaobj, GLuint _attribindex, GLuint _bindingindex) {
+        record(device_command::vertex_array_attrib_binding);
+    }
+
+    void null_device::vertex_array_attrib_format(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLboolean _normalized, GLuint _relativeoffset) {
+        record(device_command::vertex_array_attrib_format);
+    }
+
+    void null_device::vertex_array_attrib_iformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) {
+        record(device_command::vertex_array_attrib_iformat);
+    }
+
+    void null_device::vertex_array_attrib_lformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) {
+        record(device_command::vertex_array_attrib_lformat);
+    }
+
+    void null_device::vertex_array_binding_divisor(GLuint _vaobj, GLuint _bindingindex, GLuint _divisor) {
+        record(device_command::vertex_array_binding_divisor);
+    }
+
+    void null_device::vertex_array_element_buffer(GLuint _vaobj, GLuint _buffer) {
+        record(device_command::vertex_array_element_buffer);
+    }
+
+    void null_device::vertex_array_vertex_buffer(GLuint _vaobj, GLuint _bindingindex, GLuint _buffer, GLintptr _offset, GLsizei _stride) {
+        record(device_command::vertex_array_vertex_buffer);
+    }
+
+    // Textures
+    void null_device::create_textures(GLenum _target, GLsizei _n, GLuint* _textures) {
+        record(device_command::create_textures);
+        create_handles(_n, _textures);
+    }
+
+    void null_device::delete_textures(GLsizei _n, const GLuint* _textures) {
+        record(device_command::delete_textures);
+    }
+
+    void null_device::bind_texture_unit(GLuint _unit, GLuint _texture) {
+        record(device_command::bind_texture_unit);
+        ++stats_.num_state_changes_;
+    }
+
+    void null_device::texture_parameteri(GLuint _texture, GLenum _pname, GLint _param) {
+        record(device_command::texture_parameteri);
+    }
+
+    void null_device::texture_storage_2d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height) {
+        record(device_command::texture_storage_2d);
+    }
+
+    void null_device::texture_storage_3d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height, GLsizei _depth) {
+        record(device_command::texture_storage_3d);
+    }
+
+    void null_device::texture_sub_image_2d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLsizei _width, GLsizei _height, GLenum _format, GLenum _type, const void* _pixels) {
+        record(device_command::texture_sub_image_2d);
+        stats_.bytes_uploaded_ += static_cast<uint64_t>(_width) * _height * pixel_size(_format, _type);
+    }
+
+    void null_device::texture_sub_image_3d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLint _zoffset, GLsizei _width, GLsizei _height, GLsizei _depth, GLenum _format, GLenum _type, const void* _pixels) {
+        record(device_command::texture_sub_image_3d);
+        stats_.bytes_uploaded_ += static_cast<uint64_t>(_width) * _height * _depth * pixel_size(_format, _type);
+    }
+
+    void null_device::generate_texture_mipmap(GLuint _texture) {
+        record(device_command::generate_texture_mipmap);
+    }
+
+    void null_device::copy_image_sub_data(GLuint _src_name, GLenum _src_target, GLint _src_level, GLint _src_x, GLint _src_y, GLint _src_z, GLuint _dst_name, GLenum _dst_target, GLint _dst_level, GLint _dst_x, GLint _dst_y, GLint _dst_z, GLsizei _src_width, GLsizei _src_height, GLsizei _src_depth) {
+        record(device_command::copy_image_sub_data);
+    }
+
+    // Framebuffers
+    void null_device::create_framebuffers(GLsizei _n, GLuint* _framebuffers) {
+        record(device_command::create_framebuffers);
+        create_handles(_n, _framebuffers);
+    }
+
+    void null_device::delete_framebuffers(GLsizei _n, const GLuint* _framebuffers) {
+        record(device_command::delete_framebuffers);
+    }
+
+    void null_device::bind_framebuffer(GLenum _target, GLuint _framebuffer) {
+        record(device_command::bind_framebuffer);
+        ++stats_.num_state_changes_;
+    }
+
+    GLenum null_device::check_named_framebuffer_status(GLuint _framebuffer, GLenum _target) {
+        record(device_command::check_named_framebuffer_status);
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    void null_device::named_framebuffer_texture(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level) {
+        record(device_command::named_framebuffer_texture);
+    }
+
+    void null_device::named_framebuffer_texture_layer(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level, GLint _layer) {
+        record(device_command::named_framebuffer_texture_layer);
+    }
+
+    void null_device::named_framebuffer_draw_buffer(GLuint _framebuffer, GLenum _mode) {
+        record(device_command::named_framebuffer_draw_buffer);
+    }
+
+    void null_device::named_framebuffer_draw_buffers(GLuint _framebuffer, GLsizei _n, const GLenum* _bufs) {
+        record(device_command::named_framebuffer_draw_buffers);
+    }
+
+    void null_device::named_framebuffer_read_buffer(GLuint _framebuffer, GLenum _mode) {
+        record(device_command::named_framebuffer_read_buffer);
+    }
+
+    void null_device::clear_named_framebufferfv(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat* _value) {
+        record(device_command::clear_named_framebufferfv);
+    }
+
+    void null_device::clear_named_framebufferfi(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat _depth, GLint _stencil) {
+        record(device_command::clear_named_framebufferfi);
+    }
+
+    void null_device::blit_named_framebuffer(GLuint _read_framebuffer, GLuint _draw_framebuffer, GLint _src_x0, GLint _src_y0, GLint _src_x1, GLint _src_y1, GLint _dst_x0, GLint _dst_y0, GLint _dst_x1, GLint _dst_y1, GLbitfield _mask, GLenum _filter) {
+        record(device_command::blit_named_framebuffer);
+    }
+
+    // Shaders
+    GLuint null_device::create_shader(GLenum _type) {
+        record(device_command::create_shader);
+        ++stats_.num_resources_created_;
+        return next_handle_++;
+    }
+
+    void null_device::delete_shader(GLuint _shader) {
+        record(device_command::delete_shader);
+    }
+
+    void null_device::shader_source(GLuint _shader, GLsizei _count, const GLchar* const* _string, const GLint* _length) {
+        record(device_command::shader_source);
+    }
+
+    void null_device::compile_shader(GLuint _shader) {
+        record(device_command::compile_shader);
+    }
+
+    void null_device::get_shaderiv(GLuint _shader, GLenum _pname, GLint* _param) {
+        record(device_command::get_shaderiv);
+        // Every shader compiles, and there is never a log.
+        *_param = (_pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+    }
+
+    void null_device::get_shader_info_log(GLuint _shader, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) {
+        record(device_command::get_shader_info_log);
+        if (_length) { *_length = 0; }
+        if (_buf_size > 0) { _info_log[0] = '\0'; }
+    }
+
+    GLuint null_device::create_program() {
+        record(device_command::create_program);
+        ++stats_.num_resources_created_;
+        return next_handle_++;
+    }
+
+    void null_device::delete_program(GLuint _program) {
+        record(device_command::delete_program);
+    }
+
+    void null_device::attach_shader(GLuint _program, GLuint _shader) {
+        record(device_command::attach_shader);
+    }
+
+    void null_device::detach_shader(GLuint _program, GLuint _shader) {
+        record(device_command::detach_shader);
+    }
+
+    void null_device::link_program(GLuint _program) {
+        record(device_command::link_program);
+    }
+
+    void null_device::get_programiv(GLuint _program, GLenum _pname, GLint* _param) {
+        record(device_command::get_programiv);
+        *_param = (_pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+    }
+
+    void null_device::get_program_info_log(GLuint _program, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) {
+        record(device_command::get_program_info_log);
+        if (_length) { *_length = 0; }
+        if (_buf_size > 0) { _info_log[0] = '\0'; }
+    }
+
+    void null_device::use_program(GLuint _program) {
+        record(device_command::use_program);
+        ++stats_.num_state_changes_;
+    }
+
+    GLint null_device::get_uniform_location(GLuint _program, const GLchar* _name) {
+        record(device_command::get_uniform_location);
+        return 0;
+    }
+
+    GLint null_device::get_attrib_location(GLuint _program, const GLchar* _name) {
+        record(device_command::get_attrib_location);
+        return 0;
+    }
+
+    // Uniforms
+    void null_device::program_uniform1f(GLuint _program, GLint _location, GLfloat _x) {
+        record(device_command::program_uniform1f);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform1i(GLuint _program, GLint _location, GLint _x) {
+        record(device_command::program_uniform1i);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform1ui(GLuint _program, GLint _location, GLuint _x) {
+        record(device_command::program_uniform1ui);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform2f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y) {
+        record(device_command::program_uniform2f);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform2i(GLuint _program, GLint _location, GLint _x, GLint _y) {
+        record(device_command::program_uniform2i);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform2ui(GLuint _program, GLint _location, GLuint _x, GLuint _y) {
+        record(device_command::program_uniform2ui);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform3f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z) {
+        record(device_command::program_uniform3f);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform3i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z) {
+        record(device_command::program_uniform3i);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform3ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z) {
+        record(device_command::program_uniform3ui);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform4f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z, GLfloat _w) {
+        record(device_command::program_uniform4f);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform4i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z, GLint _w) {
+        record(device_command::program_uniform4i);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform4ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z, GLuint _w) {
+        record(device_command::program_uniform4ui);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix2fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix2x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix2x3fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix2x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix2x4fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix3fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix3x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix3x2fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix3x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix3x4fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix4fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix4x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix4x2fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    void null_device::program_uniform_matrix4x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) {
+        record(device_command::program_uniform_matrix4x3fv);
+        ++stats_.num_uniform_updates_;
+    }
+
+    // Draws
+    void null_device::draw_elements_instanced(GLenum _mode, GLsizei _count, GLenum _type, const void* _indices, GLsizei _primcount) {
+        record(device_command::draw_elements_instanced);
+        ++stats_.num_draw_calls_;
+        stats_.num_indices_ += static_cast<uint64_t>(_count) * _primcount;
+        stats_.num_instances_ += static_cast<uint64_t>(_primcount);
+    }
+
+    // Queries
+    void null_device::gen_queries(GLsizei _n, GLuint* _ids) {
+        record(device_command::gen_queries);
+        create_handles(_n, _ids);
+    }
+
+    void null_device::delete_queries(GLsizei _n, const GLuint* _ids) {
+        record(device_command::delete_queries);
+    }
+
+    void null_device::query_counter(GLuint _id, GLenum _target) {
+        record(device_command::query_counter);
+    }
+
+    void null_device::get_query_objectiv(GLuint _id, GLenum _pname, GLint* _params) {
+        record(device_command::get_query_objectiv);
+        // Results are always available, so that reading them never waits.
+        *_params = (_pname == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : 0;
+    }
+
+    void null_device::get_query_objectui64v(GLuint _id, GLenum _pname, GLuint64* _params) {
+        record(device_command::get_query_objectui64v);
+        *_params = 0;
+    }
+} // mkr
\ No newline at end of file
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "graphics/device/graphics_device.h"
+
+namespace mkr {
+    /// The calls that can be made to a graphics device, one for each of its functions.
+    enum class device_command : uint8_t {
+        enable,
+        disable,
+        blend_func,
+        blend_funci,
+        color_mask,
+        depth_func,
+        depth_mask,
+        stencil_func,
+        stencil_mask,
+        stencil_op,
+        stencil_op_separate,
+        viewport,
+        scissor,
+        finish,
+        create_buffers,
+        delete_buffers,
+        bind_buffer,
+        bind_buffer_base,
+        named_buffer_data,
+        named_buffer_sub_data,
+        create_vertex_arrays,
+        delete_vertex_arrays,
+        bind_vertex_array,
+        enable_vertex_array_attrib,
+        vertex_array_attrib_binding,
+        vertex_array_attrib_format,
+        vertex_array_attrib_iformat,
+        vertex_array_attrib_lformat,
+        vertex_array_binding_divisor,
+        vertex_array_element_buffer,
+        vertex_array_vertex_buffer,
+        create_textures,
+        delete_textures,
+        bind_texture_unit,
+        texture_parameteri,
+        texture_storage_2d,
+        texture_storage_3d,
+        texture_sub_image_2d,
+        texture_sub_image_3d,
+        generate_texture_mipmap,
+        copy_image_sub_data,
+        create_framebuffers,
+        delete_framebuffers,
+        bind_framebuffer,
+        check_named_framebuffer_status,
+        named_framebuffer_texture,
+        named_framebuffer_texture_layer,
+        named_framebuffer_draw_buffer,
+        named_framebuffer_draw_buffers,
+        named_framebuffer_read_buffer,
+        clear_named_framebufferfv,
+        clear_named_framebufferfi,
+        blit_named_framebuffer,
+        create_shader,
+        delete_shader,
+        shader_source,
+        compile_shader,
+        get_shaderiv,
+        get_shader_info_log,
+        create_program,
+        delete_program,
+        attach_shader,
+        detach_shader,
+        link_program,
+        get_programiv,
+        get_program_info_log,
+        use_program,
+        get_uniform_location,
+        get_attrib_location,
+        program_uniform1f,
+        program_uniform1i,
+        program_uniform1ui,
+        program_uniform2f,
+        program_uniform2i,
+        program_uniform2ui,
+        program_uniform3f,
+        program_uniform3i,
+        program_uniform3ui,
+        program_uniform4f,
+        program_uniform4i,
+        program_uniform4ui,
+        program_uniform_matrix2fv,
+        program_uniform_matrix2x3fv,
+        program_uniform_matrix2x4fv,
+        program_uniform_matrix3fv,
+        program_uniform_matrix3x2fv,
+        program_uniform_matrix3x4fv,
+        program_uniform_matrix4fv,
+        program_uniform_matrix4x2fv,
+        program_uniform_matrix4x3fv,
+        draw_elements_instanced,
+        gen_queries,
+        delete_queries,
+        query_counter,
+        get_query_objectiv,
+        get_query_objectui64v,
+    };
+
+    /// What the calls made to a null device would have cost a real one.
+    struct device_stats {
+        uint64_t num_commands_ = 0;
+        uint64_t num_draw_calls_ = 0;
+        uint64_t num_instances_ = 0;
+        uint64_t num_indices_ = 0;
+        /// Bytes copied from the CPU into buffers and textures.
+        uint64_t bytes_uploaded_ = 0;
+        /// Pipeline state changes, and bindings of buffers, textures, framebuffers and programs.
+        uint64_t num_state_changes_ = 0;
+        uint64_t num_uniform_updates_ = 0;
+        uint64_t num_resources_created_ = 0;
+    };
+
+    /**
+     * A device without a GPU. Nothing is drawn, and every call is recorded instead, so that the renderer's CPU cost can be benchmarked on any machine.
+     * Handles are unique, shaders always compile, framebuffers are always complete and GPU timers always read 0.
+     */
+    class null_device : public graphics_device {
+    private:
+        /// The calls made this frame, in order.
+        std::vector<device_command> commands_;
+        device_stats stats_;
+        device_stats total_stats_;
+        uint64_t num_frames_ = 0;
+        GLuint next_handle_ = 1;
+
+        inline void record(device_command _command) {
+            commands_.push_back(_command);
+            ++stats_.num_commands_;
+        }
+
+        void create_handles(GLsizei _n, GLuint* _handles);
+
+        /// The size in bytes of a pixel uploaded in the given format and type.
+        static uint64_t pixel_size(GLenum _format, GLenum _type);
+
+    public:
+        null_device() = default;
+        virtual ~null_device() = default;
+
+        /// The calls made since the last frame ended.
+        [[nodiscard]] inline std::span<const device_command> commands() const { return commands_; }
+        /// The cost of the calls made since the last frame ended.
+        [[nodiscard]] inline const device_stats& stats() const { return stats_; }
+        /// The cost of every call made in the frames that have ended.
+        [[nodiscard]] inline const device_stats& total_stats() const { return total_stats_; }
+        [[nodiscard]] inline uint64_t num_frames() const { return num_frames_; }
+
+        /// Add this frame's stats to the totals, and start recording the next frame. The command stream keeps its memory, so recording does not allocate once it has grown to fit a frame.
+        void end_frame() override;
+
+        /// Log the average cost of a frame.
+        void log() const;
+
+        // State
+        void enable(GLenum _cap) override;
+        void disable(GLenum _cap) override;
+        void blend_func(GLenum _sfactor, GLenum _dfactor) override;
+        void blend_funci(GLuint _buf, GLenum _src, GLenum _dst) override;
+        void color_mask(GLboolean _red, GLboolean _green, GLboolean _blue, GLboolean _alpha) override;
+        void depth_func(GLenum _func) override;
+        void depth_mask(GLboolean _flag) override;
+        void stencil_func(GLenum _func, GLint _ref, GLuint _mask) override;
+        void stencil_mask(GLuint _mask) override;
+        void stencil_op(GLenum _fail, GLenum _zfail, GLenum _zpass) override;
+        void stencil_op_separate(GLenum _face, GLenum _sfail, GLenum _dpfail, GLenum _dppass) override;
+        void viewport(GLint _x, GLint _y, GLsizei _width, GLsizei _height) override;
+        void scissor(GLint _x, GLint _y, GLsizei _width, GLsizei _height) override;
+        void finish() override;
+
+        // Buffers
+        void create_buffers(GLsizei _n, GLuint* _buffers) override;
+        void delete_buffers(GLsizei _n, const GLuint* _buffers) override;
+        void bind_buffer(GLenum _target, GLuint _buffer) override;
+        void bind_buffer_base(GLenum _target, GLuint _index, GLuint _buffer) override;
+        void named_buffer_data(GLuint _buffer, GLsizeiptr _size, const void* _data, GLenum _usage) override;
+        void named_buffer_sub_data(GLuint _buffer, GLintptr _offset, GLsizeiptr _size, const void* _data) override;
+
+        // Vertex Arrays
+        void create_vertex_arrays(GLsizei _n, GLuint* _arrays) override;
+        void delete_vertex_arrays(GLsizei _n, const GLuint* _arrays) override;
+        void bind_vertex_array(GLuint _array) override;
+        void enable_vertex_array_attrib(GLuint _vaobj, GLuint _index) override;
+        void vertex_array_attrib_binding(GLuint _vaobj, GLuint _attribindex, GLuint _bindingindex) override;
+        void vertex_array_attrib_format(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLboolean _normalized, GLuint _relativeoffset) override;
+        void vertex_array_attrib_iformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) override;
+        void vertex_array_attrib_lformat(GLuint _vaobj, GLuint _attribindex, GLint _size, GLenum _type, GLuint _relativeoffset) override;
+        void vertex_array_binding_divisor(GLuint _vaobj, GLuint _bindingindex, GLuint _divisor) override;
+        void vertex_array_element_buffer(GLuint _vaobj, GLuint _buffer) override;
+        void vertex_array_vertex_buffer(GLuint _vaobj, GLuint _bindingindex, GLuint _buffer, GLintptr _offset, GLsizei _stride) override;
+
+        // Textures
+        void create_textures(GLenum _target, GLsizei _n, GLuint* _textures) override;
+        void delete_textures(GLsizei _n, const GLuint* _textures) override;
+        void bind_texture_unit(GLuint _unit, GLuint _texture) override;
+        void texture_parameteri(GLuint _texture, GLenum _pname, GLint _param) override;
+        void texture_storage_2d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height) override;
+        void texture_storage_3d(GLuint _texture, GLsizei _levels, GLenum _internalformat, GLsizei _width, GLsizei _height, GLsizei _depth) override;
+        void texture_sub_image_2d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLsizei _width, GLsizei _height, GLenum _format, GLenum _type, const void* _pixels) override;
+        void texture_sub_image_3d(GLuint _texture, GLint _level, GLint _xoffset, GLint _yoffset, GLint _zoffset, GLsizei _width, GLsizei _height, GLsizei _depth, GLenum _format, GLenum _type, const void* _pixels) override;
+        void generate_texture_mipmap(GLuint _texture) override;
+        void copy_image_sub_data(GLuint _src_name, GLenum _src_target, GLint _src_level, GLint _src_x, GLint _src_y, GLint _src_z, GLuint _dst_name, GLenum _dst_target, GLint _dst_level, GLint _dst_x, GLint _dst_y, GLint _dst_z, GLsizei _src_width, GLsizei _src_height, GLsizei _src_depth) override;
+
+        // Framebuffers
+        void create_framebuffers(GLsizei _n, GLuint* _framebuffers) override;
+        void delete_framebuffers(GLsizei _n, const GLuint* _framebuffers) override;
+        void bind_framebuffer(GLenum _target, GLuint _framebuffer) override;
+        GLenum check_named_framebuffer_status(GLuint _framebuffer, GLenum _target) override;
+        void named_framebuffer_texture(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level) override;
+        void named_framebuffer_texture_layer(GLuint _framebuffer, GLenum _attachment, GLuint _texture, GLint _level, GLint _layer) override;
+        void named_framebuffer_draw_buffer(GLuint _framebuffer, GLenum _mode) override;
+        void named_framebuffer_draw_buffers(GLuint _framebuffer, GLsizei _n, const GLenum* _bufs) override;
+        void named_framebuffer_read_buffer(GLuint _framebuffer, GLenum _mode) override;
+        void clear_named_framebufferfv(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat* _value) override;
+        void clear_named_framebufferfi(GLuint _framebuffer, GLenum _buffer, GLint _drawbuffer, GLfloat _depth, GLint _stencil) override;
+        void blit_named_framebuffer(GLuint _read_framebuffer, GLuint _draw_framebuffer, GLint _src_x0, GLint _src_y0, GLint _src_x1, GLint _src_y1, GLint _dst_x0, GLint _dst_y0, GLint _dst_x1, GLint _dst_y1, GLbitfield _mask, GLenum _filter) override;
+
+        // Shaders
+        GLuint create_shader(GLenum _type) override;
+        void delete_shader(GLuint _shader) override;
+        void shader_source(GLuint _shader, GLsizei _count, const GLchar* const* _string, const GLint* _length) override;
+        void compile_shader(GLuint _shader) override;
+        void get_shaderiv(GLuint _shader, GLenum _pname, GLint* _param) override;
+        void get_shader_info_log(GLuint _shader, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) override;
+        GLuint create_program() override;
+        void delete_program(GLuint _program) override;
+        void attach_shader(GLuint _program, GLuint _shader) override;
+        void detach_shader(GLuint _program, GLuint _shader) override;
+        void link_program(GLuint _program) override;
+        void get_programiv(GLuint _program, GLenum _pname, GLint* _param) override;
+        void get_program_info_log(GLuint _program, GLsizei _buf_size, GLsizei* _length, GLchar* _info_log) override;
+        void use_program(GLuint _program) override;
+        GLint get_uniform_location(GLuint _program, const GLchar* _name) override;
+        GLint get_attrib_location(GLuint _program, const GLchar* _name) override;
+
+        // Uniforms
+        void program_uniform1f(GLuint _program, GLint _location, GLfloat _x) override;
+        void program_uniform1i(GLuint _program, GLint _location, GLint _x) override;
+        void program_uniform1ui(GLuint _program, GLint _location, GLuint _x) override;
+        void program_uniform2f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y) override;
+        void program_uniform2i(GLuint _program, GLint _location, GLint _x, GLint _y) override;
+        void program_uniform2ui(GLuint _program, GLint _location, GLuint _x, GLuint _y) override;
+        void program_uniform3f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z) override;
+        void program_uniform3i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z) override;
+        void program_uniform3ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z) override;
+        void program_uniform4f(GLuint _program, GLint _location, GLfloat _x, GLfloat _y, GLfloat _z, GLfloat _w) override;
+        void program_uniform4i(GLuint _program, GLint _location, GLint _x, GLint _y, GLint _z, GLint _w) override;
+        void program_uniform4ui(GLuint _program, GLint _location, GLuint _x, GLuint _y, GLuint _z, GLuint _w) override;
+        void program_uniform_matrix2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix2x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix2x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix3x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix3x4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix4fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix4x2fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+        void program_uniform_matrix4x3fv(GLuint _program, GLint _location, GLsizei _count, GLboolean _transpose, const GLfloat* _value) override;
+
+        // Draws
+        void draw_elements_instanced(GLenum _mode, GLsizei _count, GLenum _type, const void* _indices, GLsizei _primcount) override;
+
+        // Queries
+        void gen_queries(GLsizei _n, GLuint* _ids) override;
+        void delete_queries(GLsizei _n, const GLuint* _ids) override;
+        void query_counter(GLuint _id, GLenum _target) override;
+        void get_query_objectiv(GLuint _id, GLenum _pname, GLint* _params) override;
+        void get_query_objectui64v(GLuint _id, GLenum _pname, GLuint64* _params) override;
+    };
+} // mkr
\ No newline at end of file
@@ -2,8 +2,10 @@
 
 #include <cstdint>
 #include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
+    /// Depth tests transparent meshes against the opaque scene through the geometry buffer's depth, which it shares rather than copies.
     class alpha_buffer : public framebuffer {
     public:
         enum colour_attachments : int32_t {
@@ -13,21 +15,21 @@ namespace mkr {
             num_attachments,
         };
 
-        alpha_buffer(uint32_t _width, uint32_t _height) : framebuffer(_width, _height) {
+        alpha_buffer(uint32_t _width, uint32_t _height, const std::shared_ptr<texture>& _depth_stencil) : framebuffer(_width, _height) {
             // Create GL buffer.
-            glCreateFramebuffers(1, &handle_);
+            gfx().create_framebuffers(1, &handle_);
 
             // Colour attachments.
             colour_attachments_.resize(colour_attachments::num_attachments);
             colour_attachments_[colour_attachments::accumulation] = std::make_unique<texture2d>("accum", _width, _height, sized_format::rgba16f);
             colour_attachments_[colour_attachments::revealage] = std::make_unique<texture2d>("reveal", _width, _height, sized_format::r8);
             for (auto i = 0; i < colour_attachments_.size(); ++i) {
-                glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
+                gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
             }
 
             // Depth-Stencil attachments.
-            depth_stencil_attachment_ = std::make_unique<texture2d>("depth_stencil", _width, _height, sized_format::depth24_stencil8);
-            glNamedFramebufferTexture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
+            depth_stencil_attachment_ = _depth_stencil;
+            gfx().named_framebuffer_texture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
 
             // Completeness check.
             if (!is_complete()) {
@@ -36,7 +38,7 @@ namespace mkr {
         }
 
         virtual ~alpha_buffer() {
-            glDeleteFramebuffers(1, &handle_);
+            gfx().delete_framebuffers(1, &handle_);
         }
     };
 } // mkr
\ No newline at end of file
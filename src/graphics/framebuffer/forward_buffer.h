@@ -2,34 +2,35 @@
 
 #include <cstdint>
 #include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
+    /// Renders on top of the lighting buffer's colour and the geometry buffer's normals and depth, which it shares rather than copies.
     class forward_buffer : public framebuffer {
     public:
         enum colour_attachments : int32_t {
             colour = 0, // The scene rendered with geometry and lights.
-            position,
-            normal,
+            normal, // Octahedron encoded, the same as the geometry buffer. The position is reconstructed from the depth buffer.
 
             num_attachments,
         };
 
-        forward_buffer(uint32_t _width, uint32_t _height) : framebuffer(_width, _height) {
+        forward_buffer(const std::shared_ptr<texture>& _colour, const std::shared_ptr<texture>& _normal, const std::shared_ptr<texture>& _depth_stencil)
+            : framebuffer(_colour->width(), _colour->height()) {
             // Create GL buffer.
-            glCreateFramebuffers(1, &handle_);
+            gfx().create_framebuffers(1, &handle_);
 
             // Colour attachments.
             colour_attachments_.resize(colour_attachments::num_attachments);
-            colour_attachments_[colour_attachments::colour] = std::make_unique<texture2d>("colour", _width, _height, sized_format::rgba8);
-            colour_attachments_[colour_attachments::position] = std::make_unique<texture2d>("position", _width, _height, sized_format::rgb16f);
-            colour_attachments_[colour_attachments::normal] = std::make_unique<texture2d>("normal", _width, _height, sized_format::rgb16f);
+            colour_attachments_[colour_attachments::colour] = _colour;
+            colour_attachments_[colour_attachments::normal] = _normal;
             for (auto i = 0; i < colour_attachments_.size(); ++i) {
-                glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
+                gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
             }
 
             // Depth-Stencil attachments.
-            depth_stencil_attachment_ = std::make_unique<texture2d>("depth_stencil", _width, _height, sized_format::depth24_stencil8);
-            glNamedFramebufferTexture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
+            depth_stencil_attachment_ = _depth_stencil;
+            gfx().named_framebuffer_texture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
 
             // Completeness check.
             if (!is_complete()) {
@@ -38,7 +39,7 @@ namespace mkr {
         }
 
         virtual ~forward_buffer() {
-            glDeleteFramebuffers(1, &handle_);
+            gfx().delete_framebuffers(1, &handle_);
         }
     };
 } // mkr
\ No newline at end of file
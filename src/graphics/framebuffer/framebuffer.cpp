@@ -1,4 +1,5 @@
 #include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
     texture* framebuffer::get_colour_attachment(int32_t _attachment) {
@@ -17,29 +18,39 @@ namespace mkr {
         return depth_stencil_attachment_.get();
     }
 
+    std::shared_ptr<texture> framebuffer::share_colour_attachment(int32_t _attachment) const {
+        return colour_attachments_[_attachment];
+    }
+
+    std::shared_ptr<texture> framebuffer::share_depth_stencil_attachment() const {
+        return depth_stencil_attachment_;
+    }
+
     bool framebuffer::is_complete() const {
-        return GL_FRAMEBUFFER_COMPLETE == glCheckNamedFramebufferStatus(handle_, GL_FRAMEBUFFER);
+        return GL_FRAMEBUFFER_COMPLETE == gfx().check_named_framebuffer_status(handle_, GL_FRAMEBUFFER);
     }
 
     void framebuffer::bind() {
-        glBindFramebuffer(GL_FRAMEBUFFER, handle_);
+        gfx().bind_framebuffer(GL_FRAMEBUFFER, handle_);
     }
 
     void framebuffer::blit_to(framebuffer* _other, bool _colour, bool _depth, bool _stencil,
                               int32_t _src_x0, int32_t _src_y0, int32_t _src_x1, int32_t _src_y1,
-                              int32_t _dst_x0, int32_t _dst_y0, int32_t _dst_x1, int32_t _dst_y1) {
+                              int32_t _dst_x0, int32_t _dst_y0, int32_t _dst_x1, int32_t _dst_y1,
+                              bool _linear_filter) {
         GLbitfield mask = (_colour ? GL_COLOR_BUFFER_BIT : 0) | (_depth ? GL_DEPTH_BUFFER_BIT : 0) | (_stencil ? GL_STENCIL_BUFFER_BIT : 0);
         // If filter is not GL_NEAREST and mask includes GL_DEPTH_BUFFER_BIT or GL_STENCIL_BUFFER_BIT, no data is transferred and a GL_INVALID_OPERATION error is generated.
-        // So for simplicity let's just use GL_NEAREST. Don't act smart and use GL_LINEAR.
-        glBlitNamedFramebuffer(handle_, _other ? _other->handle_ : 0, _src_x0, _src_y0, _src_x1, _src_y1, _dst_x0, _dst_y0, _dst_x1, _dst_y1, mask, GL_NEAREST);
+        // So GL_LINEAR is only used for colour only blits that ask for it, such as upscaling the final image.
+        const GLenum filter = (_linear_filter && !_depth && !_stencil) ? GL_LINEAR : GL_NEAREST;
+        gfx().blit_named_framebuffer(handle_, _other ? _other->handle_ : 0, _src_x0, _src_y0, _src_x1, _src_y1, _dst_x0, _dst_y0, _dst_x1, _dst_y1, mask, filter);
     }
 
     void framebuffer::set_read_colour_attachment(int32_t _attachment) {
-        glNamedFramebufferReadBuffer(handle_, GL_COLOR_ATTACHMENT0 + _attachment);
+        gfx().named_framebuffer_read_buffer(handle_, GL_COLOR_ATTACHMENT0 + _attachment);
     }
 
     void framebuffer::set_draw_colour_attachment(int32_t _attachment) {
-        glNamedFramebufferDrawBuffer(handle_, GL_COLOR_ATTACHMENT0 + _attachment);
+        gfx().named_framebuffer_draw_buffer(handle_, GL_COLOR_ATTACHMENT0 + _attachment);
     }
 
     void framebuffer::set_draw_colour_attachment_all() {
@@ -47,20 +58,20 @@ namespace mkr {
         for (auto i = 0; i < colour_attachments_.size(); ++i) {
             indices.push_back(GL_COLOR_ATTACHMENT0 + i);
         }
-        glNamedFramebufferDrawBuffers(handle_, (GLsizei)indices.size(), indices.data());
+        gfx().named_framebuffer_draw_buffers(handle_, (GLsizei)indices.size(), indices.data());
     }
 
     void framebuffer::clear_colour(int32_t _attachment, const colour& _colour) {
-        glClearNamedFramebufferfv(handle_, GL_COLOR, _attachment, (GLfloat*)&_colour.r_);
+        gfx().clear_named_framebufferfv(handle_, GL_COLOR, _attachment, (GLfloat*)&_colour.r_);
     }
 
     void framebuffer::clear_colour_all(const colour& _colour) {
         for (auto i = 0; i < colour_attachments_.size(); ++i) {
-            glClearNamedFramebufferfv(handle_, GL_COLOR, i, (GLfloat*)&_colour.r_);
+            gfx().clear_named_framebufferfv(handle_, GL_COLOR, i, (GLfloat*)&_colour.r_);
         }
     }
 
     void framebuffer::clear_depth_stencil(float _depth, int32_t _stencil) {
-        glClearNamedFramebufferfi(handle_, GL_DEPTH_STENCIL, 0, _depth, _stencil);
+        gfx().clear_named_framebufferfi(handle_, GL_DEPTH_STENCIL, 0, _depth, _stencil);
     }
 }
\ No newline at end of file
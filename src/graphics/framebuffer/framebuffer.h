@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <GL/glew.h>
+#include "graphics/device/graphics_device.h"
 #include "maths/colour.h"
 #include "graphics/texture/texture.h"
 
@@ -12,8 +13,9 @@ namespace mkr {
     class framebuffer {
     protected:
         GLuint handle_ = 0;
-        std::vector<std::unique_ptr<texture>> colour_attachments_;
-        std::unique_ptr<texture> depth_stencil_attachment_;
+        // Attachments can be shared between framebuffers, so that passes render on top of each other's output without copying it.
+        std::vector<std::shared_ptr<texture>> colour_attachments_;
+        std::shared_ptr<texture> depth_stencil_attachment_;
         const uint32_t width_, height_;
 
         framebuffer(uint32_t _width, uint32_t _height) : width_(_width), height_(_height) {}
@@ -35,11 +37,18 @@ namespace mkr {
 
         const texture* get_depth_stencil_attachment() const;
 
+        /// Get a colour attachment to attach to another framebuffer.
+        std::shared_ptr<texture> share_colour_attachment(int32_t _attachment) const;
+
+        /// Get the depth-stencil attachment to attach to another framebuffer.
+        std::shared_ptr<texture> share_depth_stencil_attachment() const;
+
         void bind();
 
         void blit_to(framebuffer* _other, bool _colour, bool _depth, bool _stencil,
                      int32_t _src_x0, int32_t _src_y0, int32_t _src_x1, int32_t _src_y1,
-                     int32_t _dst_x0, int32_t _dst_y0, int32_t _dst_x1, int32_t _dst_y1);
+                     int32_t _dst_x0, int32_t _dst_y0, int32_t _dst_x1, int32_t _dst_y1,
+                     bool _linear_filter = false);
 
         virtual void set_read_colour_attachment(int32_t _attachment);
 
@@ -53,10 +62,10 @@ namespace mkr {
 
         virtual void clear_depth_stencil(float _depth = 1.0f, int32_t _stencil = 0);
 
-        static void bind_default_buffer() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+        static void bind_default_buffer() { gfx().bind_framebuffer(GL_FRAMEBUFFER, 0); }
 
-        static void clear_default_buffer_colour(const colour& _colour = colour::black()) { glClearNamedFramebufferfv(0, GL_COLOR, 0, (GLfloat*)&_colour.r_); }
+        static void clear_default_buffer_colour(const colour& _colour = colour::black()) { gfx().clear_named_framebufferfv(0, GL_COLOR, 0, (GLfloat*)&_colour.r_); }
 
-        static void clear_default_depth_stencil(float _depth = 1.0f, int32_t _stencil = 0) { glClearNamedFramebufferfi(0, GL_DEPTH_STENCIL, 0, _depth, _stencil); }
+        static void clear_default_depth_stencil(float _depth = 1.0f, int32_t _stencil = 0) { gfx().clear_named_framebufferfi(0, GL_DEPTH_STENCIL, 0, _depth, _stencil); }
     };
 }
\ No newline at end of file
@@ -2,38 +2,38 @@
 
 #include <cstdint>
 #include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
     class geometry_buffer : public framebuffer {
     public:
+        /// The position is not stored, as it is reconstructed from the depth buffer with the inverse projection matrix.
         enum colour_attachments : int32_t {
-            position = 0,
-            normal,
-            diffuse,
-            specular,
+            normal = 0, // Octahedron encoded, see gbuffer.frag.
+            diffuse, // Diffuse colour and alpha.
+            specular, // Specular colour and gloss.
             num_attachments,
         };
 
         geometry_buffer(uint32_t _width, uint32_t _height) : framebuffer(_width, _height) {
             // Create GL buffer.
-            glCreateFramebuffers(1, &handle_);
+            gfx().create_framebuffers(1, &handle_);
 
             // Colour attachments.
-            /* Be careful when using GL_RGB16F over GL_RGBA16F as GPUs generally prefer 4-component formats to 3-component formats due to byte alignment.
-               Some drivers may fail to complete the framebuffer. [https://www.khronos.org/opengl/wiki/Image_Format#Texture_and_Renderbuffer]
-               It should be fine since we're using textures, but some of these formats may not be supported by renderbuffers. */
+            /* Every attachment is 4 bytes per pixel, 16 bytes including the depth-stencil, down from 28 bytes with a rgb16f position and normal
+               (which drivers pad to rgba16f). [https://www.khronos.org/opengl/wiki/Image_Format#Texture_and_Renderbuffer]
+               The normal uses rg16 rather than rg16_snorm, as snorm formats are not required to be colour-renderable. */
             colour_attachments_.resize(colour_attachments::num_attachments);
-            colour_attachments_[colour_attachments::position] = std::make_unique<texture2d>("position", _width, _height, sized_format::rgb16f);
-            colour_attachments_[colour_attachments::normal] = std::make_unique<texture2d>("normal", _width, _height, sized_format::rgb16f);
+            colour_attachments_[colour_attachments::normal] = std::make_unique<texture2d>("normal", _width, _height, sized_format::rg16);
             colour_attachments_[colour_attachments::diffuse] = std::make_unique<texture2d>("diffuse", _width, _height, sized_format::rgba8);
             colour_attachments_[colour_attachments::specular] = std::make_unique<texture2d>("specular", _width, _height, sized_format::rgba8);
             for (auto i = 0; i < colour_attachments_.size(); ++i) {
-                glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
+                gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
             }
 
             // Depth-Stencil attachments.
             depth_stencil_attachment_ = std::make_unique<texture2d>("depth_stencil", _width, _height, sized_format::depth24_stencil8);
-            glNamedFramebufferTexture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
+            gfx().named_framebuffer_texture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
 
             // Completeness check.
             if (!is_complete()) {
@@ -42,7 +42,7 @@ namespace mkr {
         }
 
         virtual ~geometry_buffer() {
-            glDeleteFramebuffers(1, &handle_);
+            gfx().delete_framebuffers(1, &handle_);
         }
     };
 } // mkr
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
     class lighting_buffer : public framebuffer {
@@ -11,8 +12,8 @@ namespace mkr {
            Then we add the results together, and write to the diffuse and specular buffers again.
            In order to do that, we will need 2 diffuse and specular buffers to prevent read and writing to the same buffer in the same run.
            Otherwise, this will result in a read-write race condition and produce artifacts as multiple fragments are reading and writing to the same buffers. */
-        std::unique_ptr<texture> diffuse_back_;
-        std::unique_ptr<texture> specular_back_;
+        std::shared_ptr<texture> diffuse_back_;
+        std::shared_ptr<texture> specular_back_;
 
     public:
         enum colour_attachments : int32_t {
@@ -22,9 +23,14 @@ namespace mkr {
             num_attachments,
         };
 
-        lighting_buffer(uint32_t _width, uint32_t _height) : framebuffer(_width, _height) {
+        /**
+         * @param _width The width of the buffer.
+         * @param _height The height of the buffer.
+         * @param _depth_stencil Whether to create the depth-stencil attachment. Only the light volume pass needs it.
+         */
+        lighting_buffer(uint32_t _width, uint32_t _height, bool _depth_stencil) : framebuffer(_width, _height) {
             // Create GL buffer.
-            glCreateFramebuffers(1, &handle_);
+            gfx().create_framebuffers(1, &handle_);
 
             // Colour attachments.
             colour_attachments_.resize(colour_attachments::num_attachments);
@@ -32,9 +38,12 @@ namespace mkr {
             colour_attachments_[colour_attachments::diffuse] = std::make_unique<texture2d>("diffuse", _width, _height, sized_format::rgba8);
             colour_attachments_[colour_attachments::specular] = std::make_unique<texture2d>("specular", _width, _height, sized_format::rgba8);
             for (auto i = 0; i < colour_attachments_.size(); ++i) {
-                glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
+                gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
             }
 
+            // Depth-Stencil attachments.
+            set_depth_stencil(_depth_stencil);
+
             // Back buffers.
             diffuse_back_ = std::make_unique<texture2d>("diffuse", _width, _height, sized_format::rgba8);
             specular_back_ = std::make_unique<texture2d>("specular", _width, _height, sized_format::rgba8);
@@ -46,14 +55,31 @@ namespace mkr {
         }
 
         virtual ~lighting_buffer() {
-            glDeleteFramebuffers(1, &handle_);
+            gfx().delete_framebuffers(1, &handle_);
+        }
+
+        /**
+         * Create or release the depth-stencil attachment. It is a copy of the geometry buffer's depth, used to find the pixels inside light volumes,
+         * so it is only kept while lighting with light volumes, rather than taking up a full resolution target in clustered mode.
+         * It cannot be shared with the geometry buffer, as the light volume shader samples the geometry buffer's depth while stencil testing against this one.
+         * @param _enabled Whether the buffer should have a depth-stencil attachment.
+         */
+        void set_depth_stencil(bool _enabled) {
+            if (_enabled == (depth_stencil_attachment_ != nullptr)) { return; }
+            if (_enabled) {
+                depth_stencil_attachment_ = std::make_unique<texture2d>("depth_stencil", width_, height_, sized_format::depth24_stencil8);
+                gfx().named_framebuffer_texture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
+            } else {
+                gfx().named_framebuffer_texture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, 0, 0);
+                depth_stencil_attachment_.reset();
+            }
         }
 
         virtual void swap_buffers() {
             colour_attachments_[colour_attachments::diffuse].swap(diffuse_back_);
             colour_attachments_[colour_attachments::specular].swap(specular_back_);
-            glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + colour_attachments::diffuse, colour_attachments_[colour_attachments::diffuse]->handle(), 0);
-            glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + colour_attachments::specular, colour_attachments_[colour_attachments::specular]->handle(), 0);
+            gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + colour_attachments::diffuse, colour_attachments_[colour_attachments::diffuse]->handle(), 0);
+            gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + colour_attachments::specular, colour_attachments_[colour_attachments::specular]->handle(), 0);
         }
     };
 } // mkr
\ No newline at end of file
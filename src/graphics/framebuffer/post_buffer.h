@@ -2,11 +2,12 @@
 
 #include <cstdint>
 #include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
     class post_buffer : public framebuffer {
     protected:
-        std::unique_ptr<texture> colour_back_;
+        std::shared_ptr<texture> colour_back_;
 
     public:
         enum colour_attachments : int32_t {
@@ -16,13 +17,13 @@ namespace mkr {
 
         post_buffer(uint32_t _width, uint32_t _height) : framebuffer(_width, _height) {
             // Create GL buffer.
-            glCreateFramebuffers(1, &handle_);
+            gfx().create_framebuffers(1, &handle_);
 
             // Colour attachments.
             colour_attachments_.resize(colour_attachments::num_attachments);
             colour_attachments_[colour_attachments::colour] = std::make_unique<texture2d>("colour", _width, _height, sized_format::rgba8);
             for (auto i = 0; i < colour_attachments_.size(); ++i) {
-                glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
+                gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + i, colour_attachments_[i]->handle(), 0);
             }
 
             colour_back_ = std::make_unique<texture2d>("colour", _width, _height, sized_format::rgba8);
@@ -34,12 +35,12 @@ namespace mkr {
         }
 
         virtual ~post_buffer() {
-            glDeleteFramebuffers(1, &handle_);
+            gfx().delete_framebuffers(1, &handle_);
         }
 
         virtual void swap_buffers() {
             colour_attachments_[colour_attachments::colour].swap(colour_back_);
-            glNamedFramebufferTexture(handle_, GL_COLOR_ATTACHMENT0 + colour_attachments::colour, colour_attachments_[colour_attachments::colour]->handle(), 0);
+            gfx().named_framebuffer_texture(handle_, GL_COLOR_ATTACHMENT0 + colour_attachments::colour, colour_attachments_[colour_attachments::colour]->handle(), 0);
         }
     };
 } // mkr
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
+
+namespace mkr {
+    /// A single large depth texture, which the shadow maps of spot and directional lights are rendered into as square tiles.
+    class shadow_atlas_buffer : public framebuffer {
+    public:
+        shadow_atlas_buffer(uint32_t _size) : framebuffer(_size, _size) {
+            // Create GL buffer.
+            gfx().create_framebuffers(1, &handle_);
+
+            // No colour attachments.
+            gfx().named_framebuffer_draw_buffer(handle_, GL_NONE);
+            gfx().named_framebuffer_read_buffer(handle_, GL_NONE);
+
+            // Depth-Stencil attachments.
+            depth_stencil_attachment_ = std::make_unique<texture2d>("shadow_atlas", _size, _size, sized_format::depth24_stencil8);
+            gfx().named_framebuffer_texture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
+
+            // Completeness check.
+            if (!is_complete()) {
+                throw std::runtime_error("incomplete shadow atlas buffer");
+            }
+        }
+
+        virtual ~shadow_atlas_buffer() {
+            gfx().delete_framebuffers(1, &handle_);
+        }
+
+        /**
+         * Bind the buffer, and restrict rendering to a tile. Clears only affect the tile while GL_SCISSOR_TEST is enabled.
+         * @param _x The left of the tile in texels.
+         * @param _y The bottom of the tile in texels.
+         * @param _size The width and height of the tile in texels.
+         */
+        void bind_tile(uint32_t _x, uint32_t _y, uint32_t _size) {
+            bind();
+            gfx().viewport((GLint) _x, (GLint) _y, (GLsizei) _size, (GLsizei) _size);
+            gfx().scissor((GLint) _x, (GLint) _y, (GLsizei) _size, (GLsizei) _size);
+        }
+
+        /// Copy a region of the depth-stencil attachment into the same region of another atlas, without a draw call.
+        void copy_region_to(shadow_atlas_buffer* _other, uint32_t _x, uint32_t _y, uint32_t _width, uint32_t _height) const {
+            gfx().copy_image_sub_data(depth_stencil_attachment_->handle(), GL_TEXTURE_2D, 0, (GLint) _x, (GLint) _y, 0,
+                               _other->depth_stencil_attachment_->handle(), GL_TEXTURE_2D, 0, (GLint) _x, (GLint) _y, 0,
+                               (GLsizei) _width, (GLsizei) _height, 1);
+        }
+    };
+} // mkr
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include "graphics/framebuffer/framebuffer.h"
+#include "graphics/device/graphics_device.h"
+
+namespace mkr {
+    /// A cubemap array, with one layer per point light shadow map.
+    class shadow_cubemap_array_buffer : public framebuffer {
+    private:
+        const uint32_t layers_;
+
+    public:
+        shadow_cubemap_array_buffer(uint32_t _size, uint32_t _layers) : framebuffer(_size, _size), layers_(_layers) {
+            // Create GL buffer.
+            gfx().create_framebuffers(1, &handle_);
+
+            // No colour attachments.
+            gfx().named_framebuffer_read_buffer(handle_, GL_NONE);
+            gfx().named_framebuffer_draw_buffer(handle_, GL_NONE);
+
+            // Depth-Stencil attachments.
+            depth_stencil_attachment_ = std::make_unique<cubemap_array>("shadow_cubemaps", _size, _layers, sized_format::depth24_stencil8);
+            gfx().named_framebuffer_texture(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0);
+
+            // Completeness check.
+            if (!is_complete()) {
+                throw std::runtime_error("incomplete shadow cubemap array buffer");
+            }
+        }
+
+        virtual ~shadow_cubemap_array_buffer() {
+            gfx().delete_framebuffers(1, &handle_);
+        }
+
+        [[nodiscard]] inline uint32_t layers() const { return layers_; }
+
+        /**
+         * Bind a single face of a layer as the render target. Faces are in the order +x, -x, +y, -y, +z, -z.
+         * @param _layer The layer to render to.
+         * @param _face The face to render to.
+         */
+        void bind_face(uint32_t _layer, uint32_t _face) {
+            gfx().named_framebuffer_texture_layer(handle_, GL_DEPTH_STENCIL_ATTACHMENT, depth_stencil_attachment_->handle(), 0, (GLint) (_layer * num_cubemap_sides + _face));
+            bind();
+        }
+
+        /// Copy all 6 faces of a range of layers into the same layers of another array of the same size, without a draw call.
+        void copy_layers_to(shadow_cubemap_array_buffer* _other, uint32_t _first_layer, uint32_t _num_layers) const {
+            gfx().copy_image_sub_data(depth_stencil_attachment_->handle(), GL_TEXTURE_CUBE_MAP_ARRAY, 0, 0, 0, (GLint) (_first_layer * num_cubemap_sides),
+                               _other->depth_stencil_attachment_->handle(), GL_TEXTURE_CUBE_MAP_ARRAY, 0, 0, 0, (GLint) (_first_layer * num_cubemap_sides),
+                               (GLsizei) width_, (GLsizei) height_, (GLsizei) (_num_layers * num_cubemap_sides));
+        }
+    };
+} // mkr
\ No newline at end of file
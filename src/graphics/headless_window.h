@@ -0,0 +1,85 @@
+#pragma once
+
+#ifdef MKR_ENABLE_HEADLESS
+
+#include <stdexcept>
+#include <string>
+#include <GL/glew.h>
+#include "graphics/device/graphics_device.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include "graphics/app_window.h"
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+namespace mkr {
+    /**
+     * A window without a display, for running the renderer on machines with no display server, such as CI containers.
+     * The OpenGL context is created through EGL without a surface, so there is no default framebuffer, and the renderer presents to an offscreen framebuffer instead.
+     * With Mesa, this runs on the GPU if there is one, and on llvmpipe if there is not.
+     */
+    class headless_window : public app_window {
+    private:
+        EGLDisplay display_ = EGL_NO_DISPLAY;
+        EGLContext context_ = EGL_NO_CONTEXT;
+
+    public:
+        headless_window(const std::string& _title, uint32_t _width, uint32_t _height)
+                : app_window(_title, _width, _height, window_flags::none) {
+            // Prefer the surfaceless platform, which does not need a display server at all, and fall back to the default display.
+            const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (get_platform_display) { display_ = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr); }
+            if (display_ == EGL_NO_DISPLAY) { display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY); }
+
+            EGLint major_version, minor_version;
+            if (display_ == EGL_NO_DISPLAY || !eglInitialize(display_, &major_version, &minor_version)) {
+                throw std::runtime_error("eglInitialize failed");
+            }
+            if (!eglBindAPI(EGL_OPENGL_API)) {
+                eglTerminate(display_);
+                throw std::runtime_error("eglBindAPI failed");
+            }
+
+            const EGLint config_attribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+            EGLConfig config;
+            EGLint num_configs = 0;
+            if (!eglChooseConfig(display_, config_attribs, &config, 1, &num_configs) || num_configs == 0) {
+                eglTerminate(display_);
+                throw std::runtime_error("eglChooseConfig failed");
+            }
+
+            // Create an OpenGL 4.6 core context, the same as the windowed renderer asks for.
+            const EGLint context_attribs[] = {EGL_CONTEXT_MAJOR_VERSION, 4,
+                                              EGL_CONTEXT_MINOR_VERSION, 6,
+                                              EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                              EGL_NONE};
+            context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, context_attribs);
+            if (context_ == EGL_NO_CONTEXT) {
+                eglTerminate(display_);
+                throw std::runtime_error("eglCreateContext failed");
+            }
+
+            // Needs EGL_KHR_surfaceless_context.
+            if (!eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_)) {
+                eglDestroyContext(display_, context_);
+                eglTerminate(display_);
+                throw std::runtime_error("eglMakeCurrent failed");
+            }
+        }
+
+        virtual ~headless_window() {
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(display_, context_);
+            eglTerminate(display_);
+        }
+
+        [[nodiscard]] bool has_default_framebuffer() const override { return false; }
+
+        /// There is nothing to present, so wait for the frame to finish instead, so that frame times include the GPU's work rather than only how fast commands are queued.
+        inline void swap_buffers() override { gfx().finish(); }
+    };
+}
+
+#endif // MKR_ENABLE_HEADLESS
\ No newline at end of file
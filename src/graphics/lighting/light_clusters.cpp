@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cmath>
+#include "graphics/lighting/light_clusters.h"
+#include "graphics/shader/storage_binding.h"
+
+namespace mkr {
+    light_clusters::light_clusters()
+        : min_x_(num_clusters), min_y_(num_clusters), min_z_(num_clusters),
+          max_x_(num_clusters), max_y_(num_clusters), max_z_(num_clusters),
+          overlaps_(clusters_per_slice), counts_(num_clusters), grid_(num_clusters * 2) {}
+
+    bool light_clusters::bounds_match(const camera& _camera) const {
+        return bounds_valid_ &&
+               bounds_camera_.mode_ == _camera.mode_ &&
+               bounds_camera_.near_plane_ == _camera.near_plane_ &&
+               bounds_camera_.far_plane_ == _camera.far_plane_ &&
+               bounds_camera_.aspect_ratio_ == _camera.aspect_ratio_ &&
+               bounds_camera_.fov_ == _camera.fov_ &&
+               bounds_camera_.ortho_size_ == _camera.ortho_size_;
+    }
+
+    void light_clusters::build_bounds(const camera& _camera) {
+        const float near = _camera.near_plane_;
+        const float far = _camera.far_plane_;
+        const bool is_perspective = _camera.mode_ == projection_mode::perspective;
+
+        // The half extents of the view volume, at a depth of 1 for a perspective camera, or at any depth for an orthographic camera.
+        const float half_height = is_perspective ? std::tan(_camera.fov_ * 0.5f) : _camera.ortho_size_ * 0.5f;
+        const float half_width = half_height * _camera.aspect_ratio_;
+
+        for (uint32_t z = 0; z < num_clusters_z; ++z) {
+            const float slice_near = near * std::pow(far / near, static_cast<float>(z) / static_cast<float>(num_clusters_z));
+            const float slice_far = near * std::pow(far / near, static_cast<float>(z + 1) / static_cast<float>(num_clusters_z));
+            const float scale_near = is_perspective ? slice_near : 1.0f;
+            const float scale_far = is_perspective ? slice_far : 1.0f;
+
+            for (uint32_t y = 0; y < num_clusters_y; ++y) {
+                const float ndc_y0 = -1.0f + 2.0f * static_cast<float>(y) / static_cast<float>(num_clusters_y);
+                const float ndc_y1 = -1.0f + 2.0f * static_cast<float>(y + 1) / static_cast<float>(num_clusters_y);
+
+                for (uint32_t x = 0; x < num_clusters_x; ++x) {
+                    const float ndc_x0 = -1.0f + 2.0f * static_cast<float>(x) / static_cast<float>(num_clusters_x);
+                    const float ndc_x1 = -1.0f + 2.0f * static_cast<float>(x + 1) / static_cast<float>(num_clusters_x);
+
+                    // In OpenGL convention, the camera looks down the -z axis.
+                    const uint32_t index = x + y * num_clusters_x + z * clusters_per_slice;
+                    min_x_[index] = std::min(ndc_x0 * half_width * scale_near, ndc_x0 * half_width * scale_far);
+                    max_x_[index] = std::max(ndc_x1 * half_width * scale_near, ndc_x1 * half_width * scale_far);
+                    min_y_[index] = std::min(ndc_y0 * half_height * scale_near, ndc_y0 * half_height * scale_far);
+                    max_y_[index] = std::max(ndc_y1 * half_height * scale_near, ndc_y1 * half_height * scale_far);
+                    min_z_[index] = -slice_far;
+                    max_z_[index] = -slice_near;
+                }
+            }
+        }
+
+        bounds_camera_ = _camera;
+        bounds_valid_ = true;
+    }
+
+    void light_clusters::build(std::span<const gpu_light> _lights, uint32_t _num_directional, const camera& _camera, uint32_t _width, uint32_t _height) {
+        if (!bounds_match(_camera)) { build_bounds(_camera); }
+
+        const float near = _camera.near_plane_;
+        const float far = _camera.far_plane_;
+        const float log_depth_ratio = std::log(far / near);
+        const float slice_scale = static_cast<float>(num_clusters_z) / log_depth_ratio;
+        const float slice_bias = static_cast<float>(num_clusters_z) * std::log(near) / log_depth_ratio;
+        const auto get_slice = [&](float _depth) -> uint32_t {
+            const float slice = std::floor(std::log(std::clamp(_depth, near, far)) * slice_scale - slice_bias);
+            return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(num_clusters_z - 1)));
+        };
+
+        std::fill(counts_.begin(), counts_.end(), 0);
+        hits_.clear();
+
+        // Point and spot lights are bounded by a sphere of their range. Spotlights could be bounded tighter by a cone, but a sphere is conservative.
+        for (uint32_t i = _num_directional; i < _lights.size(); ++i) {
+            const auto& light = _lights[i];
+            const float radius = light.range_;
+            const float px = light.position_[0];
+            const float py = light.position_[1];
+            const float pz = light.position_[2];
+            const float depth = -pz;
+            if (radius <= 0.0f || depth + radius < near || far < depth - radius) { continue; }
+
+            const float radius_sqr = radius * radius;
+            const uint32_t first_slice = get_slice(depth - radius);
+            const uint32_t last_slice = get_slice(depth + radius);
+            for (uint32_t slice = first_slice; slice <= last_slice; ++slice) {
+                const uint32_t base = slice * clusters_per_slice;
+                const float* min_x = min_x_.data() + base;
+                const float* min_y = min_y_.data() + base;
+                const float* min_z = min_z_.data() + base;
+                const float* max_x = max_x_.data() + base;
+                const float* max_y = max_y_.data() + base;
+                const float* max_z = max_z_.data() + base;
+                uint8_t* overlaps = overlaps_.data();
+
+                // Sphere-box test against every cluster in the slice. Branchless, so that the compiler can vectorise it.
+                for (uint32_t c = 0; c < clusters_per_slice; ++c) {
+                    const float dx = std::max(min_x[c] - px, 0.0f) + std::max(px - max_x[c], 0.0f);
+                    const float dy = std::max(min_y[c] - py, 0.0f) + std::max(py - max_y[c], 0.0f);
+                    const float dz = std::max(min_z[c] - pz, 0.0f) + std::max(pz - max_z[c], 0.0f);
+                    overlaps[c] = (dx * dx + dy * dy + dz * dz) <= radius_sqr;
+                }
+
+                for (uint32_t c = 0; c < clusters_per_slice; ++c) {
+                    if (overlaps[c]) {
+                        ++counts_[base + c];
+                        hits_.emplace_back(base + c, i);
+                    }
+                }
+            }
+        }
+
+        // Lay the light lists out back to back.
+        uint32_t offset = 0;
+        for (uint32_t c = 0; c < num_clusters; ++c) {
+            grid_[c * 2] = offset;
+            grid_[c * 2 + 1] = 0;
+            offset += counts_[c];
+        }
+        indices_.resize(offset);
+        for (const auto& [cluster, light] : hits_) {
+            indices_[grid_[cluster * 2] + grid_[cluster * 2 + 1]++] = light;
+        }
+
+        const cluster_info info{
+            {num_clusters_x, num_clusters_y, num_clusters_z, _num_directional},
+            {static_cast<float>(_width) / static_cast<float>(num_clusters_x), static_cast<float>(_height) / static_cast<float>(num_clusters_y), slice_scale, slice_bias},
+        };
+        info_buffer_.set_data(sizeof(cluster_info), &info);
+        light_buffer_.set_data(static_cast<GLsizeiptr>(sizeof(gpu_light) * _lights.size()), _lights.data());
+        grid_buffer_.set_data(static_cast<GLsizeiptr>(sizeof(uint32_t) * grid_.size()), grid_.data());
+        index_buffer_.set_data(static_cast<GLsizeiptr>(sizeof(uint32_t) * indices_.size()), indices_.data());
+    }
+
+    void light_clusters::bind() {
+        info_buffer_.bind(storage_binding::light_cluster_info);
+        light_buffer_.bind(storage_binding::light_list);
+        grid_buffer_.bind(storage_binding::light_grid);
+        index_buffer_.bind(storage_binding::light_index_list);
+    }
+} // mkr
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <utility>
+#include "component/camera.h"
+#include "graphics/buffer/ssbo.h"
+
+namespace mkr {
+    /// A light as stored in the light list storage buffer. Must match the std430 layout of the light struct in light.frag!
+    struct gpu_light {
+        float colour_[4];
+        float position_[3]; // View space.
+        float power_;
+        float direction_[3]; // View space.
+        int32_t mode_;
+        float attenuation_constant_;
+        float attenuation_linear_;
+        float attenuation_quadratic_;
+        float range_;
+        float spotlight_inner_cosine_;
+        float spotlight_outer_cosine_;
+        float shadow_distance_;
+        int32_t shadow_index_; // -1 if the light has no shadow map.
+        float view_projection_matrix_[16]; // Column major.
+    };
+    static_assert(sizeof(gpu_light) == 144, "gpu_light must match the std430 layout of the light struct in light.frag");
+
+    /**
+     * Clustered light culling.
+     * The camera's view volume is divided into a grid of clusters, made of tiles in screen space and exponentially distributed slices in depth.
+     * Every point and spot light is tested against the clusters that its bounding sphere can overlap, and the resulting per-cluster light lists are uploaded to storage buffers.
+     * Shaders then only evaluate the lights in the cluster of the fragment being shaded.
+     * Directional lights affect every cluster, so they are kept at the front of the light list rather than being binned.
+     */
+    class light_clusters {
+    public:
+        static constexpr uint32_t num_clusters_x = 16;
+        static constexpr uint32_t num_clusters_y = 9;
+        static constexpr uint32_t num_clusters_z = 24;
+        static constexpr uint32_t clusters_per_slice = num_clusters_x * num_clusters_y;
+        static constexpr uint32_t num_clusters = clusters_per_slice * num_clusters_z;
+
+    private:
+        /// Must match the light_cluster_info buffer in light.frag!
+        struct cluster_info {
+            uint32_t dims_[4]; // Number of clusters in x, y and z, and the number of directional lights.
+            float params_[4]; // Tile width and height in pixels, depth slice scale and bias.
+        };
+
+        // The view space bounds of every cluster. Kept as separate arrays so that testing a light against a slice of clusters vectorises.
+        std::vector<float> min_x_, min_y_, min_z_;
+        std::vector<float> max_x_, max_y_, max_z_;
+
+        // The camera that the bounds were built for.
+        camera bounds_camera_;
+        bool bounds_valid_ = false;
+
+        // Working memory, kept between frames so that it is not reallocated.
+        std::vector<uint8_t> overlaps_;
+        std::vector<uint32_t> counts_;
+        std::vector<std::pair<uint32_t, uint32_t>> hits_; // (cluster, light)
+        std::vector<uint32_t> grid_; // (offset, count) per cluster.
+        std::vector<uint32_t> indices_;
+
+        ssbo info_buffer_;
+        ssbo light_buffer_;
+        ssbo grid_buffer_;
+        ssbo index_buffer_;
+
+        [[nodiscard]] bool bounds_match(const camera& _camera) const;
+        void build_bounds(const camera& _camera);
+
+    public:
+        light_clusters();
+        ~light_clusters() = default;
+
+        /**
+         * Bin the lights into the clusters of a camera, and upload the results.
+         * @param _lights The lights, in view space. Directional lights must come first.
+         * @param _num_directional The number of directional lights at the front of _lights.
+         * @param _camera The camera.
+         * @param _width The width of the render target in pixels.
+         * @param _height The height of the render target in pixels.
+         */
+        void build(std::span<const gpu_light> _lights, uint32_t _num_directional, const camera& _camera, uint32_t _width, uint32_t _height);
+
+        /// Bind the storage buffers to their binding points.
+        void bind();
+
+        /// The total number of light references across all clusters in the last build.
+        [[nodiscard]] inline size_t num_light_indices() const { return indices_.size(); }
+    };
+} // mkr
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "graphics/lighting/light_ranking.h"
+#include "graphics/lighting/lighting.h"
+#include "memory/frame_allocator.h"
+
+namespace mkr {
+    float light_ranking::score(const local_to_world& _light_trans, const light& _light, const matrix4x4& _view_matrix, const camera& _camera) {
+        if (_light.get_mode() == light_mode::directional) { return std::numeric_limits<float>::infinity(); }
+
+        const auto& colour = _light.get_colour();
+        const float brightness = _light.get_power() * maths_util::max<float>(colour.r_, maths_util::max<float>(colour.g_, colour.b_));
+        if (brightness <= 0.0f) { return 0.0f; }
+
+        // Test the light's bounding sphere against the camera's frustum. In OpenGL convention, the camera looks down the -z axis.
+        const float range = maths_util::min<float>(_light.get_range(lighting::light_cutoff), _camera.far_plane_);
+        const vector3 centre = _view_matrix * _light_trans.position_;
+        const float depth = -centre.z_;
+        if (depth + range < _camera.near_plane_ || depth - range > _camera.far_plane_) { return 0.0f; }
+
+        float coverage = 1.0f;
+        if (_camera.mode_ == projection_mode::perspective) {
+            const float tan_half_height = std::tan(_camera.fov_ * 0.5f);
+            const float tan_half_width = tan_half_height * _camera.aspect_ratio_;
+            // The distance of the sphere's centre outside each pair of side planes.
+            const float dist_x = (std::abs(centre.x_) - depth * tan_half_width) / std::sqrt(1.0f + tan_half_width * tan_half_width);
+            const float dist_y = (std::abs(centre.y_) - depth * tan_half_height) / std::sqrt(1.0f + tan_half_height * tan_half_height);
+            if (dist_x > range || dist_y > range) { return 0.0f; }
+
+            // Estimate the fraction of the screen's height that the light's range covers. A camera inside the range is covered completely.
+            const float distance = std::sqrt(centre.dot(centre));
+            if (distance > range) { coverage = range / (distance * tan_half_height); }
+        } else {
+            const float half_height = _camera.ortho_size_ * 0.5f;
+            const float half_width = half_height * _camera.aspect_ratio_;
+            if (std::abs(centre.x_) > half_width + range || std::abs(centre.y_) > half_height + range) { return 0.0f; }
+            coverage = range / half_height;
+        }
+
+        return brightness * maths_util::clamp<float>(coverage, 0.0f, 1.0f);
+    }
+
+    void light_ranking::rank(std::span<ranked_light> _lights, uint64_t _frame) {
+        // Smooth the scores. Lights that were not submitted last frame start from their current score.
+        frame_vector<history*> histories;
+        histories.reserve(_lights.size());
+        for (auto& l : _lights) {
+            auto [it, is_new] = history_.try_emplace(l.id_);
+            auto& h = it->second;
+            const bool continuing = !is_new && h.last_frame_ + 1 == _frame && !std::isinf(l.score_) && !std::isinf(h.score_);
+            h.score_ = continuing ? h.score_ * (1.0f - smoothing_) + l.score_ * smoothing_ : l.score_;
+            h.last_frame_ = _frame;
+            histories.push_back(&h);
+        }
+
+        // Sort by score, favouring the lights that were picked last frame. Ties are broken by id, so the order does not depend on the order the lights were submitted in.
+        frame_vector<size_t> order(_lights.size());
+        const auto sort_by = [&](auto _was_picked) {
+            for (size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+            std::sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+                const float score_a = histories[_a]->score_ * (_was_picked(_a) ? 1.0f + hysteresis_ : 1.0f);
+                const float score_b = histories[_b]->score_ * (_was_picked(_b) ? 1.0f + hysteresis_ : 1.0f);
+                return score_a != score_b ? score_a > score_b : _lights[_a].id_ < _lights[_b].id_;
+            });
+        };
+
+        // Pick the lights to shade. Lights that cannot be seen this frame are never shaded, whatever their smoothed score.
+        sort_by([&](size_t _i) { return histories[_i]->shaded_; });
+        uint32_t num_shaded = 0;
+        for (const auto i : order) {
+            auto& l = _lights[i];
+            const bool is_directional = std::isinf(l.score_);
+            l.shaded_ = l.score_ > 0.0f && (is_directional || num_shaded < max_shaded_lights_);
+            if (l.shaded_ && !is_directional) { ++num_shaded; }
+            histories[i]->shaded_ = l.shaded_;
+        }
+
+        // Pick the shaded lights that get shadow maps. Lights that keep their shadow keep their index, so their cached shadow maps and atlas space stay valid.
+        sort_by([&](size_t _i) { return histories[_i]->shadow_index_ >= 0; });
+        frame_vector<bool> shadowed(_lights.size(), false);
+        bool index_in_use[lighting::max_shadow_maps] = {};
+        uint32_t num_shadowed = 0;
+        for (const auto i : order) {
+            const auto& l = _lights[i];
+            shadowed[i] = l.shaded_ && l.cast_shadows_ && num_shadowed < lighting::max_shadow_maps;
+            if (shadowed[i]) { ++num_shadowed; }
+            if (!shadowed[i]) { histories[i]->shadow_index_ = -1; }
+            if (histories[i]->shadow_index_ >= 0) { index_in_use[histories[i]->shadow_index_] = true; }
+        }
+        for (const auto i : order) {
+            auto& h = *histories[i];
+            if (shadowed[i] && h.shadow_index_ < 0) {
+                for (int32_t j = 0; j < static_cast<int32_t>(lighting::max_shadow_maps); ++j) {
+                    if (!index_in_use[j]) {
+                        index_in_use[j] = true;
+                        h.shadow_index_ = j;
+                        break;
+                    }
+                }
+            }
+            _lights[i].shadow_index_ = h.shadow_index_;
+        }
+
+        // Forget the lights that have gone.
+        std::erase_if(history_, [&](const auto& _entry) { return _entry.second.last_frame_ != _frame; });
+    }
+} // mkr
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <maths/maths_util.h>
+#include <maths/matrix.h>
+#include "component/camera.h"
+#include "component/light.h"
+#include "component/local_to_world.h"
+
+namespace mkr {
+    /// A light taking part in this frame's ranking.
+    struct ranked_light {
+        /// Identifies the light between frames.
+        uint64_t id_;
+        /// How much the light matters to the cameras this frame. 0 if no camera can see anything it lights.
+        float score_;
+        bool cast_shadows_;
+        /// Output, whether the light is shaded this frame.
+        bool shaded_ = false;
+        /// Output, the index of the light's shadow map, or -1 if it has none.
+        int32_t shadow_index_ = -1;
+    };
+
+    /**
+     * Picks the lights that are shaded, and the lights that get shadow maps, from the lights submitted each frame.
+     * Lights are ranked by their score, smoothed over a few frames. A light that was picked last frame has its score raised by the hysteresis factor,
+     * so that two lights with similar scores do not swap places every frame, and a light keeps the same shadow map index for as long as it keeps its shadow.
+     */
+    class light_ranking {
+    private:
+        struct history {
+            float score_ = 0.0f;
+            bool shaded_ = false;
+            int32_t shadow_index_ = -1;
+            uint64_t last_frame_ = 0;
+        };
+
+        std::unordered_map<uint64_t, history> history_;
+        uint32_t max_shaded_lights_ = 256;
+        float hysteresis_ = 0.25f;
+        float smoothing_ = 0.25f;
+
+    public:
+        /**
+         * Score a light by how much it contributes to what a camera sees.
+         * Directional lights light everything, and always rank first.
+         * Point and spot lights that are outside the camera's frustum score 0. Otherwise, the score is the light's brightness scaled by an estimate of the fraction of the screen its range covers.
+         * @param _light_trans The light's transform.
+         * @param _light The light.
+         * @param _view_matrix The camera's view matrix.
+         * @param _camera The camera.
+         * @return The light's score.
+         */
+        static float score(const local_to_world& _light_trans, const light& _light, const matrix4x4& _view_matrix, const camera& _camera);
+
+        /**
+         * Rank this frame's lights, and pick the ones that are shaded and the ones that get shadow maps.
+         * Lights that are not in _lights are forgotten.
+         * @param _lights The lights, with their scores for this frame. Their outputs are written.
+         * @param _frame The frame number.
+         */
+        void rank(std::span<ranked_light> _lights, uint64_t _frame);
+
+        [[nodiscard]] inline uint32_t max_shaded_lights() const { return max_shaded_lights_; }
+        /// The most point and spot lights shaded each frame. Directional lights are always shaded.
+        inline void set_max_shaded_lights(uint32_t _max) { max_shaded_lights_ = _max; }
+
+        [[nodiscard]] inline float hysteresis() const { return hysteresis_; }
+        /// How much higher a light's score must be to take the place of a light that was picked last frame, as a fraction of that light's score.
+        inline void set_hysteresis(float _hysteresis) { hysteresis_ = maths_util::max<float>(_hysteresis, 0.0f); }
+
+        [[nodiscard]] inline float smoothing() const { return smoothing_; }
+        /// How quickly a light's smoothed score follows its score, between 0 (never) and 1 (immediately).
+        inline void set_smoothing(float _smoothing) { smoothing_ = maths_util::clamp<float>(_smoothing, 0.0f, 1.0f); }
+    };
+} // mkr
\ No newline at end of file
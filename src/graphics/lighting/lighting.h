@@ -8,7 +8,11 @@ namespace mkr {
     public:
         lighting() = delete;
 
-        static constexpr uint32_t max_lights = 4; // Must match shader!
+        /// Shadow maps are allocated from the shadow atlas as they are needed, so this only bounds the per-light bookkeeping.
+        static constexpr uint32_t max_shadow_maps = 16;
+        static constexpr uint32_t max_cascades = 4; // Must match shader!
+        /// A light's range ends where its contribution falls below this fraction of full intensity.
+        static constexpr float light_cutoff = 1.0f / 256.0f;
 
         static colour ambient_light_;
     };
@@ -3,6 +3,7 @@
 namespace mkr {
     shader_program* material::geometry_shader_;
     shader_program* material::light_shader_;
+    shader_program* material::light_volume_shader_;
     std::vector<shader_program*> material::post_proc_shaders_;
     shader_program* material::shadow_shader_2d_;
     shader_program* material::shadow_shader_cube_;
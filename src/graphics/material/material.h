@@ -17,7 +17,7 @@ namespace mkr {
         shader_program *alpha_weight_shader_, *alpha_blend_shader_; // Forward Transparent (Per Material)
 
         static shader_program *shadow_shader_2d_, *shadow_shader_cube_; // Shadow Mapping (Shared)
-        static shader_program* geometry_shader_, *light_shader_; // Deferred Shading (Shared)
+        static shader_program* geometry_shader_, *light_shader_, *light_volume_shader_; // Deferred Shading (Shared)
         static std::vector<shader_program*> post_proc_shaders_; // Post-Processing (Shared)
 
         // Phong Shading
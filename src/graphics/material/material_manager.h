@@ -23,6 +23,14 @@ namespace mkr {
             return (iter == materials_.end()) ? nullptr : iter->second.get();
         }
 
+        /// Get the name of a material, or an empty string if the material is not owned by the manager.
+        std::string get_name(const material* _material) const {
+            for (const auto& iter : materials_) {
+                if (iter.second.get() == _material) { return iter.first; }
+            }
+            return "";
+        }
+
         material* make_material(const std::string& _name) {
             if (materials_.contains(_name)) { throw std::runtime_error("duplicate material name"); }
             materials_[_name] = std::make_unique<material>();;
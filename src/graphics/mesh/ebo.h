@@ -1,20 +1,26 @@
 #pragma once
 
 #include <GL/glew.h>
+#include "graphics/device/graphics_device.h"
+#include "memory/memory_tracker.h"
 
 namespace mkr {
     class ebo {
     private:
         GLuint handle_;
+        /// The size of the buffer's storage in bytes.
+        GLsizeiptr size_;
 
     public:
-        ebo(GLsizeiptr _size, void* _data) {
-            glCreateBuffers(1, &handle_);
-            glNamedBufferData(handle_, _size, _data, GL_STATIC_DRAW);
+        ebo(GLsizeiptr _size, void* _data) : size_{_size} {
+            gfx().create_buffers(1, &handle_);
+            gfx().named_buffer_data(handle_, _size, _data, GL_STATIC_DRAW);
+            memory_tracker::gpu_allocate(gpu_memory_tag::index_buffer, static_cast<size_t>(size_));
         }
 
         ~ebo() {
-            glDeleteBuffers(1, &handle_);
+            gfx().delete_buffers(1, &handle_);
+            memory_tracker::gpu_deallocate(gpu_memory_tag::index_buffer, static_cast<size_t>(size_));
         }
 
         GLuint handle() const {
@@ -23,7 +29,7 @@ namespace mkr {
 
         void bind() {
             // Must be bound only after VAO has been bound as this function modifies the VAO state. (https://www.khronos.org/opengl/wiki/Vertex_Specification, Vertex Array Object Section)
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, handle_);
+            gfx().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, handle_);
         }
     };
 }
\ No newline at end of file
@@ -3,9 +3,11 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <maths/maths_util.h>
 #include "graphics/mesh/vertex.h"
 #include "graphics/mesh/mesh_instance_data.h"
 #include "graphics/mesh/vao.h"
+#include "graphics/shadow/bounding_box.h"
 
 namespace mkr {
     class mesh {
@@ -14,10 +16,24 @@ namespace mkr {
         std::unique_ptr<vao> vao_;
         const std::vector<vertex> vertices_;
         const std::vector<uint32_t> indices_;
+        /// The object space bounds of the vertices.
+        const bounding_box bounds_;
+
+        static bounding_box calculate_bounds(const std::vector<vertex>& _vertices) {
+            if (_vertices.empty()) { return bounding_box{vector3::zero(), vector3::zero()}; }
+
+            vector3 min = _vertices[0].position_;
+            vector3 max = _vertices[0].position_;
+            for (const auto& v : _vertices) {
+                min = vector3{maths_util::min(min.x_, v.position_.x_), maths_util::min(min.y_, v.position_.y_), maths_util::min(min.z_, v.position_.z_)};
+                max = vector3{maths_util::max(max.x_, v.position_.x_), maths_util::max(max.y_, v.position_.y_), maths_util::max(max.z_, v.position_.z_)};
+            }
+            return bounding_box{min, max};
+        }
 
     public:
         mesh(const std::string& _name, const std::vector<vertex>& _vertices, const std::vector<uint32_t>& _indices)
-            : name_{_name}, vertices_{_vertices}, indices_{_indices} {
+            : name_{_name}, vertices_{_vertices}, indices_{_indices}, bounds_{calculate_bounds(_vertices)} {
             // VAO
             vao_ = std::make_unique<vao>();
 
@@ -51,6 +67,14 @@ namespace mkr {
             return name_;
         }
 
+        const std::vector<vertex>& vertices() const {
+            return vertices_;
+        }
+
+        const bounding_box& bounds() const {
+            return bounds_;
+        }
+
         const std::vector<uint32_t>& indices() const {
             return indices_;
         }
@@ -63,8 +87,8 @@ namespace mkr {
             vao_->bind();
         }
 
-        void set_instance_data(const std::vector<mesh_instance_data>& _instances) {
-            vao_->get_vbo(vbo_index::instance_data)->set_data(sizeof(mesh_instance_data) * _instances.size(), (void*) _instances.data(), GL_STREAM_DRAW);
+        void set_instance_data(const mesh_instance_data* _instances, size_t _num_instances) {
+            vao_->get_vbo(vbo_index::instance_data)->set_data(sizeof(mesh_instance_data) * _num_instances, (void*) _instances, GL_STREAM_DRAW);
         }
     };
 }
\ No newline at end of file
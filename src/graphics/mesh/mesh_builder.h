@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <SDL2/SDL_image.h>
@@ -226,6 +227,100 @@ namespace mkr {
             return std::make_unique<mesh>(_name, vertices, indices);
         }
 
+        /**
+         * Make a low poly sphere, to be used as the light volume of a point light.
+         * The vertices are pushed out so that the faces enclose the unit sphere, rather than being enclosed by it.
+         * @param _name The name of the mesh.
+         * @param _slices The number of segments around the sphere.
+         * @param _stacks The number of segments from pole to pole.
+         */
+        static std::unique_ptr<mesh> make_light_sphere(const std::string& _name, uint32_t _slices = 16, uint32_t _stacks = 8) {
+            std::vector<vertex> vertices;
+            std::vector<uint32_t> indices;
+
+            const float radius = 1.0f / (std::cos(maths_util::pi / static_cast<float>(_slices)) * std::cos(maths_util::pi * 0.5f / static_cast<float>(_stacks)));
+            for (uint32_t stack = 0; stack <= _stacks; ++stack) {
+                const float phi = maths_util::pi * static_cast<float>(stack) / static_cast<float>(_stacks);
+                for (uint32_t slice = 0; slice <= _slices; ++slice) {
+                    const float theta = 2.0f * maths_util::pi * static_cast<float>(slice) / static_cast<float>(_slices);
+                    vertex v;
+                    v.normal_ = {std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta)};
+                    v.position_ = v.normal_ * radius;
+                    v.tex_coord_ = {static_cast<float>(slice) / static_cast<float>(_slices), static_cast<float>(stack) / static_cast<float>(_stacks)};
+                    v.tangent_ = {-std::sin(theta), 0.0f, std::cos(theta)};
+                    vertices.push_back(v);
+                }
+            }
+
+            for (uint32_t stack = 0; stack < _stacks; ++stack) {
+                for (uint32_t slice = 0; slice < _slices; ++slice) {
+                    const uint32_t top = stack * (_slices + 1) + slice;
+                    const uint32_t bottom = top + _slices + 1;
+                    indices.push_back(top);
+                    indices.push_back(top + 1);
+                    indices.push_back(bottom);
+                    indices.push_back(bottom);
+                    indices.push_back(top + 1);
+                    indices.push_back(bottom + 1);
+                }
+            }
+
+            return std::make_unique<mesh>(_name, vertices, indices);
+        }
+
+        /**
+         * Make a low poly cone, to be used as the light volume of a spot light.
+         * The apex is at the origin, and the base is a circle of radius 1 at z = 1. The base is pushed out so that it encloses the circle.
+         * @param _name The name of the mesh.
+         * @param _slices The number of segments around the cone.
+         */
+        static std::unique_ptr<mesh> make_light_cone(const std::string& _name, uint32_t _slices = 16) {
+            std::vector<vertex> vertices;
+            std::vector<uint32_t> indices;
+
+            const float radius = 1.0f / std::cos(maths_util::pi / static_cast<float>(_slices));
+
+            // Apex and base centre.
+            vertex apex;
+            apex.position_ = {0.0f, 0.0f, 0.0f};
+            apex.normal_ = {0.0f, 0.0f, -1.0f};
+            apex.tangent_ = {1.0f, 0.0f, 0.0f};
+            vertices.push_back(apex);
+
+            vertex base_centre;
+            base_centre.position_ = {0.0f, 0.0f, 1.0f};
+            base_centre.normal_ = {0.0f, 0.0f, 1.0f};
+            base_centre.tangent_ = {1.0f, 0.0f, 0.0f};
+            vertices.push_back(base_centre);
+
+            // Base ring.
+            for (uint32_t slice = 0; slice < _slices; ++slice) {
+                const float theta = 2.0f * maths_util::pi * static_cast<float>(slice) / static_cast<float>(_slices);
+                vertex v;
+                v.position_ = {radius * std::cos(theta), radius * std::sin(theta), 1.0f};
+                v.normal_ = vector3{std::cos(theta), std::sin(theta), -1.0f}.normalised();
+                v.tangent_ = {-std::sin(theta), std::cos(theta), 0.0f};
+                vertices.push_back(v);
+            }
+
+            for (uint32_t slice = 0; slice < _slices; ++slice) {
+                const uint32_t current = 2 + slice;
+                const uint32_t next = 2 + (slice + 1) % _slices;
+
+                // Side
+                indices.push_back(0);
+                indices.push_back(next);
+                indices.push_back(current);
+
+                // Base
+                indices.push_back(1);
+                indices.push_back(current);
+                indices.push_back(next);
+            }
+
+            return std::make_unique<mesh>(_name, vertices, indices);
+        }
+
         static std::unique_ptr<mesh> load_obj(const std::string &_name, const std::string &_file) {
             // Vertex Data and Index Data
             std::vector<vertex> vertices;
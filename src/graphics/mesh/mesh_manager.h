@@ -7,6 +7,7 @@
 #include "graphics/mesh/mesh.h"
 #include "graphics/mesh/mesh_builder.h"
 #include "util/file_util.h"
+#include "memory/memory_tracker.h"
 
 namespace mkr {
     class mesh_manager : public singleton<mesh_manager> {
@@ -28,8 +29,17 @@ namespace mkr {
         // For now, we only support .obj files.
         mesh* make_mesh(const std::string& _name, const std::string& _file) {
             if (meshes_.contains(_name)) { throw std::runtime_error("duplicate mesh name"); }
+            memory_scope scope{memory_tag::mesh};
             meshes_[_name] = mesh_builder::load_obj(_name, _file);
             return meshes_[_name].get();
         }
+
+        /// Register a mesh built in code, such as by mesh_builder, so that it can be found by name.
+        mesh* add_mesh(std::unique_ptr<mesh> _mesh) {
+            const std::string name = _mesh->name();
+            if (meshes_.contains(name)) { throw std::runtime_error("duplicate mesh name"); }
+            meshes_[name] = std::move(_mesh);
+            return meshes_[name].get();
+        }
     };
 }
\ No newline at end of file
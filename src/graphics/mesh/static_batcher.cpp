@@ -0,0 +1,71 @@
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <maths/matrix_util.h>
+#include "graphics/mesh/static_batcher.h"
+#include "memory/memory_tracker.h"
+
+namespace mkr {
+    vector3 static_batcher::transform_point(const matrix4x4& _matrix, const vector3& _point) {
+        return vector3{_matrix[0][0] * _point.x_ + _matrix[1][0] * _point.y_ + _matrix[2][0] * _point.z_ + _matrix[3][0],
+                       _matrix[0][1] * _point.x_ + _matrix[1][1] * _point.y_ + _matrix[2][1] * _point.z_ + _matrix[3][1],
+                       _matrix[0][2] * _point.x_ + _matrix[1][2] * _point.y_ + _matrix[2][2] * _point.z_ + _matrix[3][2]};
+    }
+
+    vector3 static_batcher::transform_direction(const matrix4x4& _matrix, const vector3& _direction) {
+        return vector3{_matrix[0][0] * _direction.x_ + _matrix[1][0] * _direction.y_ + _matrix[2][0] * _direction.z_,
+                       _matrix[0][1] * _direction.x_ + _matrix[1][1] * _direction.y_ + _matrix[2][1] * _direction.z_,
+                       _matrix[0][2] * _direction.x_ + _matrix[1][2] * _direction.y_ + _matrix[2][2] * _direction.z_};
+    }
+
+    std::vector<std::unique_ptr<mesh>> static_batcher::bake(const std::string& _name, const std::vector<static_instance>& _instances, float _chunk_size, size_t _max_vertices) {
+        memory_scope scope{memory_tag::mesh};
+
+        // Group the instances by the grid cell that the centre of their world space bounds falls in.
+        using cell = std::tuple<int32_t, int32_t, int32_t>;
+        std::map<cell, std::vector<const static_instance*>> chunks;
+        for (const auto& instance : _instances) {
+            const vector3 centre = transform_point(instance.model_matrix_, instance.mesh_->bounds().centre());
+            chunks[cell{static_cast<int32_t>(std::floor(centre.x_ / _chunk_size)),
+                        static_cast<int32_t>(std::floor(centre.y_ / _chunk_size)),
+                        static_cast<int32_t>(std::floor(centre.z_ / _chunk_size))}].push_back(&instance);
+        }
+
+        std::vector<std::unique_ptr<mesh>> meshes;
+        std::vector<vertex> vertices;
+        std::vector<uint32_t> indices;
+        auto flush = [&]() {
+            if (vertices.empty()) { return; }
+            meshes.push_back(std::make_unique<mesh>(_name + "_" + std::to_string(meshes.size()), vertices, indices));
+            vertices.clear();
+            indices.clear();
+        };
+
+        for (const auto& chunk : chunks) {
+            for (const auto* instance : chunk.second) {
+                const auto& src_vertices = instance->mesh_->vertices();
+                const auto& src_indices = instance->mesh_->indices();
+                if (!vertices.empty() && vertices.size() + src_vertices.size() > _max_vertices) { flush(); }
+
+                // Normals are transformed by the inverse transpose so that non-uniform scaling does not skew them.
+                const matrix4x4& model_matrix = instance->model_matrix_;
+                const matrix4x4 normal_matrix = matrix_util::inverse_matrix(model_matrix).value_or(matrix4x4::identity()).transposed();
+
+                const auto base_index = static_cast<uint32_t>(vertices.size());
+                for (const auto& src : src_vertices) {
+                    vertex v = src;
+                    v.position_ = transform_point(model_matrix, src.position_);
+                    v.normal_ = transform_direction(normal_matrix, src.normal_).normalised();
+                    v.tangent_ = transform_direction(model_matrix, src.tangent_).normalised();
+                    vertices.push_back(v);
+                }
+                for (auto index : src_indices) {
+                    indices.push_back(base_index + index);
+                }
+            }
+            flush();
+        }
+
+        return meshes;
+    }
+} // mkr
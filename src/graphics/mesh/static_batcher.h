@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <maths/matrix.h>
+#include "graphics/mesh/mesh.h"
+
+namespace mkr {
+    /// A mesh placed in the world, to be merged into a static batch.
+    struct static_instance {
+        const mesh* mesh_;
+        matrix4x4 model_matrix_;
+    };
+
+    /**
+     * Merges static mesh instances into combined meshes whose vertices are already in world space.
+     * Instances are grouped into spatial chunks so that each combined mesh has tight bounds,
+     * and a chunk is split further if it would exceed the vertex limit.
+     */
+    class static_batcher {
+    private:
+        static vector3 transform_point(const matrix4x4& _matrix, const vector3& _point);
+        static vector3 transform_direction(const matrix4x4& _matrix, const vector3& _direction);
+
+    public:
+        /// The default size of the world space grid that instances are chunked by.
+        static constexpr float default_chunk_size = 32.0f;
+        /// The default maximum number of vertices in a single combined mesh.
+        static constexpr size_t default_max_vertices = 65536;
+
+        static_batcher() = delete;
+
+        /**
+         * Bake static instances into combined meshes.
+         * @param _name The name prefix of the combined meshes.
+         * @param _instances The instances to combine. They should all share the same material.
+         * @param _chunk_size The size of the world space grid that instances are chunked by.
+         * @param _max_vertices The maximum number of vertices in a single combined mesh.
+         * @return The combined meshes.
+         */
+        static std::vector<std::unique_ptr<mesh>> bake(const std::string& _name, const std::vector<static_instance>& _instances,
+                                                       float _chunk_size = default_chunk_size, size_t _max_vertices = default_max_vertices);
+    };
+} // mkr
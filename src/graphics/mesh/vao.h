@@ -4,6 +4,7 @@
 #include <vector>
 #include "graphics/mesh/vbo.h"
 #include "graphics/mesh/ebo.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
     class vao {
@@ -13,11 +14,11 @@ namespace mkr {
         std::unique_ptr<vbo> vbos_[vbo_index::num_vbo];
 
     public:
-        vao() { glCreateVertexArrays(1, &handle_); }
+        vao() { gfx().create_vertex_arrays(1, &handle_); }
 
-        ~vao() { glDeleteVertexArrays(1, &handle_); }
+        ~vao() { gfx().delete_vertex_arrays(1, &handle_); }
 
-        inline void bind() { glBindVertexArray(handle_); }
+        inline void bind() { gfx().bind_vertex_array(handle_); }
 
         [[nodiscard]] inline const ebo* get_ebo() const { return ebo_.get(); }
 
@@ -25,7 +26,7 @@ namespace mkr {
 
         void set_ebo(std::unique_ptr<ebo> _ebo) {
             ebo_ = std::move(_ebo);
-            glVertexArrayElementBuffer(handle_, ebo_->handle());
+            gfx().vertex_array_element_buffer(handle_, ebo_->handle());
         }
 
         [[nodiscard]] inline const vbo* get_vbo(vbo_index _type) const { return vbos_[_type].get(); }
@@ -34,8 +35,8 @@ namespace mkr {
 
         void set_vbo(vbo_index _type, std::unique_ptr<vbo> _vbo) {
             const vbo_layout& layout = _vbo->layout();
-            glVertexArrayVertexBuffer(handle_, _type, _vbo->handle(), 0, layout.bytes());
-            glVertexArrayBindingDivisor(handle_, _type, _vbo->divisor());
+            gfx().vertex_array_vertex_buffer(handle_, _type, _vbo->handle(), 0, layout.bytes());
+            gfx().vertex_array_binding_divisor(handle_, _type, _vbo->divisor());
 
             GLuint offset = 0;
             for (size_t i = 0; i < layout.num_elements(); ++i) {
@@ -43,19 +44,19 @@ namespace mkr {
                 switch (e.type_) {
                     case GL_INT:
                     case GL_UNSIGNED_INT:
-                        glVertexArrayAttribIFormat(handle_, e.attrib_, e.count_, e.type_, offset);
+                        gfx().vertex_array_attrib_iformat(handle_, e.attrib_, e.count_, e.type_, offset);
                         break;
                     case GL_FLOAT:
-                        glVertexArrayAttribFormat(handle_, e.attrib_, e.count_, e.type_, e.normalised_, offset);
+                        gfx().vertex_array_attrib_format(handle_, e.attrib_, e.count_, e.type_, e.normalised_, offset);
                         break;
                     case GL_DOUBLE:
-                        glVertexArrayAttribLFormat(handle_, e.attrib_, e.count_, e.type_, offset);
+                        gfx().vertex_array_attrib_lformat(handle_, e.attrib_, e.count_, e.type_, offset);
                         break;
                     default:
                         throw std::runtime_error("invalid vbo element type");
                 }
-                glVertexArrayAttribBinding(handle_, e.attrib_, _type);
-                glEnableVertexArrayAttrib(handle_, e.attrib_);
+                gfx().vertex_array_attrib_binding(handle_, e.attrib_, _type);
+                gfx().enable_vertex_array_attrib(handle_, e.attrib_);
                 offset += e.bytes_;
             }
 
@@ -3,6 +3,8 @@
 #include <vector>
 #include <memory>
 #include <GL/glew.h>
+#include "graphics/device/graphics_device.h"
+#include "memory/memory_tracker.h"
 
 namespace mkr {
     /** A VAO can store up to 16 vertex attributes.
@@ -95,16 +97,20 @@ namespace mkr {
         GLuint handle_;
         GLuint divisor_;
         vbo_layout layout_;
+        /// The size of the buffer's storage in bytes.
+        GLsizeiptr size_;
 
     public:
         vbo(GLsizeiptr _size, void* _data, GLenum _usage, vbo_layout _layout, GLuint _divisor)
-                : divisor_{_divisor}, layout_{_layout} {
-            glCreateBuffers(1, &handle_);
-            glNamedBufferData(handle_, _size, _data, _usage);
+                : divisor_{_divisor}, layout_{_layout}, size_{_size} {
+            gfx().create_buffers(1, &handle_);
+            gfx().named_buffer_data(handle_, _size, _data, _usage);
+            memory_tracker::gpu_allocate(gpu_memory_tag::vertex_buffer, static_cast<size_t>(size_));
         }
 
         ~vbo() {
-            glDeleteBuffers(1, &handle_);
+            gfx().delete_buffers(1, &handle_);
+            memory_tracker::gpu_deallocate(gpu_memory_tag::vertex_buffer, static_cast<size_t>(size_));
         }
 
         GLuint handle() const {
@@ -120,15 +126,19 @@ namespace mkr {
         }
 
         void bind() {
-            glBindBuffer(GL_ARRAY_BUFFER, handle_);
+            gfx().bind_buffer(GL_ARRAY_BUFFER, handle_);
         }
 
+        /// Replaces the buffer's storage, so the old storage is released.
         void set_data(GLsizeiptr _size, void* _data, GLenum _usage) {
-            glNamedBufferData(handle_, _size, _data, _usage);
+            gfx().named_buffer_data(handle_, _size, _data, _usage);
+            memory_tracker::gpu_deallocate(gpu_memory_tag::vertex_buffer, static_cast<size_t>(size_));
+            size_ = _size;
+            memory_tracker::gpu_allocate(gpu_memory_tag::vertex_buffer, static_cast<size_t>(size_));
         }
 
         void set_sub_data(GLintptr _offset, GLsizeiptr _size, void* _data) {
-            glNamedBufferSubData(handle_, _offset, _size, _data);
+            gfx().named_buffer_sub_data(handle_, _offset, _size, _data);
         }
     };
 }
\ No newline at end of file
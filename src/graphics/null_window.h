@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include "graphics/app_window.h"
+
+namespace mkr {
+    /// A window for the null graphics device, which has no OpenGL context to own and nothing to present.
+    class null_window : public app_window {
+    public:
+        null_window(const std::string& _title, uint32_t _width, uint32_t _height)
+                : app_window(_title, _width, _height, window_flags::none) {}
+
+        virtual ~null_window() {}
+
+        [[nodiscard]] bool has_default_framebuffer() const override { return true; }
+
+        inline void swap_buffers() override {}
+    };
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "graphics/renderer/gpu_timer.h"
+#include "graphics/device/graphics_device.h"
+
+namespace mkr {
+    gpu_timer::gpu_timer() {
+        for (auto& frame : frames_) {
+            gfx().gen_queries(max_markers + 1, frame.queries_);
+        }
+    }
+
+    gpu_timer::~gpu_timer() {
+        for (auto& frame : frames_) {
+            gfx().delete_queries(max_markers + 1, frame.queries_);
+        }
+    }
+
+    bool gpu_timer::is_available(const frame_queries& _frame) const {
+        GLint available = GL_FALSE;
+        gfx().get_query_objectiv(_frame.queries_[_frame.num_markers_], GL_QUERY_RESULT_AVAILABLE, &available);
+        return available == GL_TRUE;
+    }
+
+    void gpu_timer::read_back(frame_queries& _frame) {
+        result timings;
+        timings.frame_ = _frame.frame_;
+
+        GLuint64 start = 0;
+        gfx().get_query_objectui64v(_frame.queries_[0], GL_QUERY_RESULT, &start);
+        GLuint64 previous = start;
+        for (uint32_t i = 0; i < _frame.num_markers_; ++i) {
+            GLuint64 timestamp = 0;
+            gfx().get_query_objectui64v(_frame.queries_[i + 1], GL_QUERY_RESULT, &timestamp);
+            timings.pass_times_ms_[static_cast<size_t>(_frame.passes_[i])] += static_cast<float>(timestamp - previous) * 1.0e-6f; // Nanoseconds to milliseconds.
+            previous = timestamp;
+        }
+        timings.frame_time_ms_ = static_cast<float>(previous - start) * 1.0e-6f;
+
+        _frame.pending_ = false;
+        latest_ = timings;
+    }
+
+    void gpu_timer::begin_frame(uint64_t _frame) {
+        // The GPU is more than max_frames_in_flight frames behind, so wait for the oldest results rather than overwrite them.
+        auto& frame = frames_[current_];
+        if (frame.pending_) { read_back(frame); }
+
+        frame.frame_ = _frame;
+        frame.num_markers_ = 0;
+        gfx().query_counter(frame.queries_[0], GL_TIMESTAMP);
+    }
+
+    void gpu_timer::mark(gpu_pass _pass) {
+        auto& frame = frames_[current_];
+        if (frame.num_markers_ == max_markers) { return; }
+        frame.passes_[frame.num_markers_++] = _pass;
+        gfx().query_counter(frame.queries_[frame.num_markers_], GL_TIMESTAMP);
+    }
+
+    void gpu_timer::end_frame() {
+        frames_[current_].pending_ = true;
+        current_ = (current_ + 1) % max_frames_in_flight;
+
+        // Frames finish in order, so read them back oldest first, and stop at the first that is not done.
+        for (uint32_t i = 0; i < max_frames_in_flight; ++i) {
+            auto& frame = frames_[(current_ + i) % max_frames_in_flight];
+            if (!frame.pending_) { continue; }
+            if (!is_available(frame)) { break; }
+            read_back(frame);
+        }
+    }
+} // mkr
\ No newline at end of file
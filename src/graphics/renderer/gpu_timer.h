@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <GL/glew.h>
+#include "graphics/renderer/render_stats.h"
+
+namespace mkr {
+    /**
+     * Measures how long the GPU spends on each group of render passes, with timestamp queries written between the passes.
+     * Every frame uses its own set of queries, and results are only read once the GPU has finished the frame, so that reading them never stalls the CPU.
+     */
+    class gpu_timer {
+    public:
+        static constexpr uint32_t max_frames_in_flight = 4;
+        static constexpr uint32_t max_markers = 64;
+
+        /// The timings of a finished frame.
+        struct result {
+            uint64_t frame_ = 0;
+            float frame_time_ms_ = 0.0f;
+            float pass_times_ms_[num_gpu_passes] = {};
+        };
+
+    private:
+        struct frame_queries {
+            /// The first query is written at the start of the frame, and one more after every marked pass.
+            GLuint queries_[max_markers + 1] = {};
+            gpu_pass passes_[max_markers] = {};
+            uint32_t num_markers_ = 0;
+            uint64_t frame_ = 0;
+            bool pending_ = false;
+        };
+
+        frame_queries frames_[max_frames_in_flight];
+        uint32_t current_ = 0;
+        std::optional<result> latest_;
+
+        [[nodiscard]] bool is_available(const frame_queries& _frame) const;
+        void read_back(frame_queries& _frame);
+
+    public:
+        gpu_timer();
+        ~gpu_timer();
+
+        /**
+         * Start timing a frame.
+         * @param _frame The index of the frame, returned with its timings.
+         */
+        void begin_frame(uint64_t _frame);
+
+        /// Mark the end of a pass. The time since the previous mark is added to the pass's group.
+        void mark(gpu_pass _pass);
+
+        /// Finish timing the frame, and read back the timings of any earlier frames that the GPU has finished.
+        void end_frame();
+
+        /// The timings of the most recent frame that the GPU has finished, if there is one.
+        [[nodiscard]] inline const std::optional<result>& latest() const { return latest_; }
+    };
+} // mkr
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include <cmath>
+#include <bit>
 #include <GL/glew.h>
 #include <SDL2/SDL.h>
 #include <log/log.h>
@@ -7,106 +9,263 @@
 #include "graphics/shader/shadow_cubemap_shader.h"
 #include "graphics/shader/geometry_shader.h"
 #include "graphics/shader/lighting_shader.h"
+#include "graphics/shader/light_volume_shader.h"
 #include "graphics/shader/forward_shader.h"
 #include "graphics/shader/alpha_weight_shader.h"
 #include "graphics/shader/alpha_blend_shader.h"
 #include "graphics/shader/skybox_shader.h"
 #include "graphics/shader/post_proc_shader.h"
 #include "graphics/mesh/mesh_builder.h"
-#include "graphics/shadow/shadow_bounds.h"
+#include "application/command_line.h"
+#include "graphics/sdl_window.h"
+#include "graphics/headless_window.h"
+#include "graphics/null_window.h"
+#include "graphics/shader/storage_binding.h"
+#include "graphics/shadow/bounding_sphere.h"
+#include "graphics/shadow/shadow_culling.h"
+#include "graphics/device/graphics_device.h"
+#include "graphics/device/null_device.h"
+#include "memory/memory_tracker.h"
 
 namespace mkr {
+    namespace {
+        /// Scramble the bits of a key, so that summed keys rarely collide.
+        uint64_t mix_key(uint64_t _key) {
+            _key ^= _key >> 30;
+            _key *= 0xbf58476d1ce4e5b9ULL;
+            _key ^= _key >> 27;
+            _key *= 0x94d049bb133111ebULL;
+            _key ^= _key >> 31;
+            return _key;
+        }
+
+        /// Get the world space bounding sphere of a mesh instance.
+        bounding_sphere caster_sphere(const mesh* _mesh, const matrix4x4& _model_matrix) {
+            const auto& m = _model_matrix;
+            const auto& bounds = _mesh->bounds();
+            const vector3 half_extents = (bounds.max() - bounds.min()) * 0.5f;
+            float max_scale_sqr = 0.0f;
+            for (auto col = 0; col < 3; ++col) {
+                const vector3 axis{m[col][0], m[col][1], m[col][2]};
+                max_scale_sqr = maths_util::max<float>(max_scale_sqr, axis.dot(axis));
+            }
+            const vector3& c = bounds.centre();
+            const vector3 centre{m[0][0] * c.x_ + m[1][0] * c.y_ + m[2][0] * c.z_ + m[3][0],
+                                 m[0][1] * c.x_ + m[1][1] * c.y_ + m[2][1] * c.z_ + m[3][1],
+                                 m[0][2] * c.x_ + m[1][2] * c.y_ + m[2][2] * c.z_ + m[3][2]};
+            return bounding_sphere{centre, std::sqrt(half_extents.dot(half_extents) * max_scale_sqr)};
+        }
+
+        /// Copy a matrix into a column major array, as expected by the shaders.
+        void to_column_major(const matrix4x4& _matrix, float* _out) {
+            for (auto col = 0; col < 4; ++col) {
+                for (auto row = 0; row < 4; ++row) {
+                    _out[col * 4 + row] = _matrix[col][row];
+                }
+            }
+        }
+
+        /// Get the offset (xy) and scale (zw) that map a square region's [0, 1] texture coordinates into the whole atlas.
+        void to_tile_rect(uint32_t _x, uint32_t _y, uint32_t _size, uint32_t _atlas_size, float* _out) {
+            const float atlas_size = static_cast<float>(_atlas_size);
+            _out[0] = static_cast<float>(_x) / atlas_size;
+            _out[1] = static_cast<float>(_y) / atlas_size;
+            _out[2] = static_cast<float>(_size) / atlas_size;
+            _out[3] = static_cast<float>(_size) / atlas_size;
+        }
+
+        /// The null device outlives the renderer, as graphics resources held elsewhere, such as by scenes, are released after the renderer is destroyed.
+        null_device& null_graphics_device() {
+            static null_device device;
+            return device;
+        }
+    }
+
     void graphics_renderer::init() {
-        // Initialise SDL video subsystem.
-        if (0 != SDL_InitSubSystem(SDL_INIT_VIDEO)) {
-            const std::string err_msg = "SDL_INIT_VIDEO failed";
+        memory_scope scope{memory_tag::renderer};
+        const auto& cmd = command_line::instance();
+
+        // With --headless, render without a display, such as on CI machines. Needs a build with MKR_ENABLE_HEADLESS.
+        headless_ = cmd.has("headless");
+
+        // With --graphics-device=null, graphics calls are recorded rather than made, to benchmark the renderer's CPU cost on machines without a GPU.
+        const std::string device_name = cmd.get_string("graphics-device", "gl");
+        if (device_name != "gl" && device_name != "null") { MKR_CORE_WARN("unknown graphics device {}, using gl", device_name); }
+
+        if (device_name == "null") {
+            null_device_ = &null_graphics_device();
+            graphics_device::set_current(null_device_);
+            app_window_ = std::make_unique<null_window>("mkr_engine", window_width_, window_height_);
+            MKR_CORE_INFO("Rendering to the null graphics device at {}x{}", window_width_, window_height_);
+        } else if (headless_) {
+#ifdef MKR_ENABLE_HEADLESS
+            app_window_ = std::make_unique<headless_window>("mkr_engine", window_width_, window_height_);
+            MKR_CORE_INFO("Rendering headless at {}x{}", window_width_, window_height_);
+#else
+            const std::string err_msg = "--headless needs a build with MKR_ENABLE_HEADLESS";
             MKR_CORE_ERROR(err_msg);
             throw std::runtime_error(err_msg);
-        }
+#endif
+        } else {
+            // Initialise SDL video subsystem.
+            if (0 != SDL_InitSubSystem(SDL_INIT_VIDEO)) {
+                const std::string err_msg = "SDL_INIT_VIDEO failed";
+                MKR_CORE_ERROR(err_msg);
+                throw std::runtime_error(err_msg);
+            }
 
-        // Enable Multisampling
-        SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
+            // Enable Multisampling
+            SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
 
-        // Set Double Buffering
-        SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+            // Set Double Buffering
+            SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 
-        // Set OpenGL Version
-        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
-        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 6);
-        int majorVersion, minorVersion;
-        SDL_GL_GetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, &majorVersion);
-        SDL_GL_GetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, &minorVersion);
-        MKR_CORE_INFO("OpenGL Version: {}.{}", majorVersion, minorVersion);
+            // Set OpenGL Version
+            SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+            SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 6);
+            int majorVersion, minorVersion;
+            SDL_GL_GetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, &majorVersion);
+            SDL_GL_GetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, &minorVersion);
+            MKR_CORE_INFO("OpenGL Version: {}.{}", majorVersion, minorVersion);
 
-        // Create Window
-        app_window_ = std::make_unique<app_window>("mkr_engine", window_width_, window_height_, window_flags::none);
+            // Create Window
+            app_window_ = std::make_unique<sdl_window>("mkr_engine", window_width_, window_height_, window_flags::none);
+        }
 
-        // Initialise glew.
-        if (GLEW_OK != glewInit()) {
-            throw std::runtime_error("glewInit failed");
+        // Initialise glew. Without GLX, as with an EGL context, glew still loads the OpenGL functions but reports that there is no GLX display.
+        if (!null_device_) {
+            const GLenum glew_result = glewInit();
+            if (GLEW_OK != glew_result && !(headless_ && GLEW_ERROR_NO_GLX_DISPLAY == glew_result)) {
+                throw std::runtime_error("glewInit failed");
+            }
         }
 
         skybox_cube_ = mesh_builder::make_skybox("skybox");
         screen_quad_ = mesh_builder::make_screen_quad("screen_quad");
+        light_sphere_ = mesh_builder::make_light_sphere("light_sphere");
+        light_cone_ = mesh_builder::make_light_cone("light_cone");
+
+        // The deferred lighting mode can be selected on the command line with --lighting=clustered|volumes.
+        const std::string lighting_mode = command_line::instance().get_string("lighting", "clustered");
+        if (lighting_mode == "volumes") {
+            lighting_mode_ = deferred_lighting_mode::light_volumes;
+        } else if (lighting_mode != "clustered") {
+            MKR_CORE_WARN("unknown lighting mode {}, using clustered", lighting_mode);
+        }
 
         // Framebuffers
-        for (auto i = 0; i < lighting::max_lights; ++i) {
-            s2d_buff_[i] = std::make_unique<shadow_2d_buffer>(4096);
-            scube_buff_[i] = std::make_unique<shadow_cubemap_buffer>(2048);
+        g_buff_ = std::make_unique<geometry_buffer>(app_window_->width(), app_window_->height());
+        l_buff_ = std::make_unique<lighting_buffer>(app_window_->width(), app_window_->height(), lighting_mode_ == deferred_lighting_mode::light_volumes);
+        // The forward and alpha passes render on top of the lighting output and the geometry buffer's depth, rather than copies of them.
+        f_buff_ = std::make_unique<forward_buffer>(l_buff_->share_colour_attachment(lighting_buffer::colour_attachments::colour),
+                                                   g_buff_->share_colour_attachment(geometry_buffer::colour_attachments::normal),
+                                                   g_buff_->share_depth_stencil_attachment());
+
+        a_buff_ = std::make_unique<alpha_buffer>(app_window_->width(), app_window_->height(), g_buff_->share_depth_stencil_attachment());
+
+        if (!app_window_->has_default_framebuffer()) {
+            present_buff_ = std::make_unique<post_buffer>(app_window_->width(), app_window_->height());
         }
 
-        g_buff_ = std::make_unique<geometry_buffer>(app_window_->width(), app_window_->height());
-        l_buff_ = std::make_unique<lighting_buffer>(app_window_->width(), app_window_->height());
-        f_buff_ = std::make_unique<forward_buffer>(app_window_->width(), app_window_->height());
+        // Shadow Atlas. The textures are only created once a light needs a shadow map.
+        shadow_atlas_ = std::make_unique<shadow_atlas>(8192, 1024, lighting::max_shadow_maps);
+        shadow_buffer_ = std::make_unique<ssbo>();
+
+        // Light Culling
+        light_clusters_ = std::make_unique<light_clusters>();
 
-        a_buff_ = std::make_unique<alpha_buffer>(app_window_->width(), app_window_->height());
+        // Dynamic Resolution. Enabled on the command line with --dynamic-resolution, and optionally --target-frame-ms=16.6 and --min-resolution-scale=0.5.
+        gpu_timer_ = std::make_unique<gpu_timer>();
+        resolution_controller_.set_enabled(cmd.has("dynamic-resolution"));
+        resolution_controller_.set_target_frame_time_ms(cmd.get_float("target-frame-ms", resolution_controller_.target_frame_time_ms()));
+        resolution_controller_.set_min_scale(cmd.get_float("min-resolution-scale", resolution_controller_.min_scale()));
     }
 
     void graphics_renderer::start() {
-        glEnable(GL_MULTISAMPLE);
-        glEnable(GL_CULL_FACE);
+        gfx().enable(GL_MULTISAMPLE);
+        gfx().enable(GL_CULL_FACE);
 
         // Depth
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().depth_func(GL_LESS);
 
         // Blend
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gfx().enable(GL_BLEND);
+        gfx().blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         // Stencil
-        // glEnable(GL_STENCIL_TEST);
-        // glStencilMask(0xFF); // Each bit is written to the stencil buffer as-is.
-        // glDisable(GL_STENCIL_TEST);
-        // glStencilMask(0x00);
+        // gfx().enable(GL_STENCIL_TEST);
+        // gfx().stencil_mask(0xFF); // Each bit is written to the stencil buffer as-is.
+        // gfx().disable(GL_STENCIL_TEST);
+        // gfx().stencil_mask(0x00);
     }
 
     void graphics_renderer::update() {
+        memory_scope scope{memory_tag::renderer};
+
         // Render
         render();
 
         // Swap buffer.
         app_window_->swap_buffers();
+        gfx().end_frame();
     }
 
     void graphics_renderer::exit() {
-        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        if (null_device_) { null_device_->log(); }
+
+        // The framebuffers need the context, so they are destroyed before the window.
+        present_buff_.reset();
+        if (SDL_WasInit(SDL_INIT_VIDEO)) { SDL_QuitSubSystem(SDL_INIT_VIDEO); }
     }
 
     void graphics_renderer::render() {
-        // Shadow maps for spot and point lights can be shared between cameras.
-        const auto num_lights = maths_util::min<int32_t>(lights_.size(), lighting::max_lights);
-        for (auto i = 0; i < num_lights; ++i) {
-            const auto& light = lights_[i].light_;
-            const auto& trans = lights_[i].transform_;
-            if (light.get_mode() == light_mode::point) {
-                light_view_projection_matrix_[i] = point_shadow(scube_buff_[i].get(), trans, light);
+        gpu_timer_->begin_frame(frame_count_);
+        stats_.num_draw_calls_ = 0;
+        stats_.num_instances_ = 0;
+        stats_.num_triangles_ = 0;
+        update_resolution_scale();
+
+        // There are only a limited number of shadow maps, which are given to the lights that matter most to the cameras.
+        rank_lights();
+        allocate_shadow_maps();
+
+        // Shadow maps for spot and point lights can be shared between cameras, and are kept between frames until they are out of date.
+        bool gathered_casters = false;
+        for (const auto& light_data : lights_) {
+            const auto i = light_data.shadow_index_;
+            if (i < 0) { continue; }
+            if (light_data.light_.get_mode() == light_mode::directional) {
+                // Directional shadow maps follow the camera, so they are rendered for every camera.
+                shadow_caches_[i].valid_ = false;
+                shadow_caches_[i].static_valid_ = false;
+                continue;
+            }
+            cascade_caches_[i] = cascade_cache{};
+            if (!gathered_casters) {
+                gather_dynamic_casters();
+                gathered_casters = true;
             }
-            else if (light.get_mode() == light_mode::spot) {
-                light_view_projection_matrix_[i] = spot_shadow(s2d_buff_[i].get(), trans, light);
+            update_shadow_map(i, light_data, static_caster_key_);
+
+            auto& data = shadow_data_[i];
+            const auto& allocation = shadow_allocations_[i];
+            if (allocation.layer_) {
+                data.num_cascades_ = 0;
+                data.cubemap_layer_ = static_cast<int32_t>(*allocation.layer_);
+            } else {
+                const auto& tile = *allocation.tile_;
+                data.num_cascades_ = 1;
+                data.cubemap_layer_ = -1;
+                to_column_major(light_view_projection_matrix_[i], data.view_projection_matrices_[0]);
+                to_tile_rect(tile.x_, tile.y_, tile.size_, shadow_atlas_->size(), data.tile_rects_[0]);
             }
         }
+        gpu_timer_->mark(gpu_pass::shadows);
+
+        // Far cascades can only be kept between frames when they were rendered for the same camera.
+        const bool reuse_far_cascades = cameras_.size() == 1;
 
         // Render the scene once for every camera.
         while (!cameras_.empty()) {
@@ -114,12 +273,14 @@ namespace mkr {
             auto& trans = cameras_.top().transform_;
 
             // Shadow maps for directional lights need to be recalculated once for each camera.
-            for (auto i = 0; i < num_lights; ++i) {
-                const auto& light = lights_[i].light_;
-                if (light.get_mode() == light_mode::directional) {
-                    light_view_projection_matrix_[i] = directional_shadow(s2d_buff_[i].get(), lights_[i].transform_, light, trans, cam);
+            for (const auto& light_data : lights_) {
+                const auto i = light_data.shadow_index_;
+                if (i >= 0 && light_data.light_.get_mode() == light_mode::directional) {
+                    directional_shadow(i, light_data, trans, cam, reuse_far_cascades);
                 }
             }
+            shadow_buffer_->set_data(sizeof(shadow_data_), shadow_data_);
+            gpu_timer_->mark(gpu_pass::shadows);
 
             // In OpenGL convention, the camera looks down the -z axis.
             const auto& view_dir_x = -trans.left_;
@@ -134,226 +295,525 @@ namespace mkr {
             const auto projection_matrix = (cam.mode_ == projection_mode::perspective)
                                            ? matrix_util::perspective_matrix(cam.aspect_ratio_, cam.fov_, cam.near_plane_, cam.far_plane_)
                                            : matrix_util::orthographic_matrix(cam.aspect_ratio_, cam.ortho_size_, cam.near_plane_, cam.far_plane_);
+            const auto inv_projection_matrix = matrix_util::inverse_matrix(projection_matrix).value_or(matrix4x4::identity());
+
 
+            // Light culling.
+            build_light_clusters(view_matrix, view_dir_x, view_dir_y, view_dir_z, cam);
 
             // Render passes.
             geometry_pass(view_matrix, projection_matrix);
-            lighting_pass(view_matrix, inv_view_matrix, view_dir_x, view_dir_y, view_dir_z);
-            forward_pass(view_matrix, projection_matrix, inv_view_matrix, view_dir_x, view_dir_y, view_dir_z);
+            gpu_timer_->mark(gpu_pass::geometry);
+            lighting_pass(inv_view_matrix, inv_projection_matrix);
+            if (lighting_mode_ == deferred_lighting_mode::light_volumes) { light_volume_pass(view_matrix, projection_matrix, inv_view_matrix, inv_projection_matrix, cam); }
+            gpu_timer_->mark(gpu_pass::lighting);
+            forward_pass(view_matrix, projection_matrix, inv_view_matrix);
             skybox_pass(matrix_util::view_matrix(vector3::zero(), trans.forward_, trans.up_), projection_matrix, &cam.skybox_);
-            alpha_weight_pass(view_matrix, projection_matrix, inv_view_matrix, view_dir_x, view_dir_y, view_dir_z);
+            gpu_timer_->mark(gpu_pass::forward);
+            alpha_weight_pass(view_matrix, projection_matrix, inv_view_matrix);
             alpha_blend_pass(view_matrix, projection_matrix);
+            gpu_timer_->mark(gpu_pass::transparent);
 
-            // Blit result to default framebuffer.
-            framebuffer::bind_default_buffer();
-            framebuffer::clear_default_buffer_colour();
-            framebuffer::clear_default_depth_stencil();
+            // Blit result to default framebuffer, or the offscreen one when there is no display, upscaling the rendered region to the window.
+            if (present_buff_) {
+                present_buff_->bind();
+                present_buff_->clear_colour_all();
+            } else {
+                framebuffer::bind_default_buffer();
+                framebuffer::clear_default_buffer_colour();
+                framebuffer::clear_default_depth_stencil();
+            }
 
             f_buff_->set_read_colour_attachment(forward_buffer::colour_attachments::colour);
-            f_buff_->blit_to(nullptr, true, false, false, 0, 0, f_buff_->width(), f_buff_->height(), 0, 0, app_window_->width(), app_window_->height());
+            f_buff_->blit_to(present_buff_.get(), true, false, false, 0, 0, render_width_, render_height_, 0, 0, app_window_->width(), app_window_->height(), render_width_ != app_window_->width());
+            gpu_timer_->mark(gpu_pass::present);
 
             // Pop camera off the priority queue.
             cameras_.pop();
         }
 
         // Clear objects for next frame.
-        lights_.clear();
-        deferred_meshes_.clear();
-        forward_meshes_.clear();
-        transparent_meshes_.clear();
-    }
-
-    matrix4x4 graphics_renderer::point_shadow(shadow_cubemap_buffer* _buffer, const local_to_world& _trans, const light& _light) {
-        glDisable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
-        glViewport(0, 0, _buffer->width(), _buffer->height());
-
-        _buffer->bind();
-        _buffer->clear_depth_stencil();
-
-        matrix4x4 projection_matrix = matrix_util::perspective_matrix(1.0f, maths_util::pi / 2.0f, 0.05f, 50.0f);
-        matrix4x4 view_projection_matrices[6] = {
-            projection_matrix * matrix_util::view_matrix(_trans.position_, vector3::left(), vector3::down()),
-            projection_matrix * matrix_util::view_matrix(_trans.position_, vector3::right(), vector3::down()),
-            projection_matrix * matrix_util::view_matrix(_trans.position_, vector3::up(), vector3::forwards()),
-            projection_matrix * matrix_util::view_matrix(_trans.position_, vector3::down(), vector3::backwards()),
-            projection_matrix * matrix_util::view_matrix(_trans.position_, vector3::forwards(), vector3::down()),
-            projection_matrix * matrix_util::view_matrix(_trans.position_, vector3::backwards(), vector3::down()),
-        };
+        discard_frame();
+        gpu_timer_->end_frame();
+        ++frame_count_;
+    }
 
-        auto shader = mkr::material::shadow_shader_cube_;
-        shader->use();
+    void graphics_renderer::discard_frame() {
+        // The containers are replaced rather than cleared, as clearing would keep hold of memory that is released when the frame arena is reset.
+        // The arena is only reset after this, so the next frame's containers are reserved by its first submission instead.
+        prev_num_lights_ = lights_.size();
+        cameras_ = std::priority_queue<camera_data, frame_vector<camera_data>>{};
+        lights_ = frame_vector<light_data>{};
+        deferred_meshes_ = mesh_map{};
+        forward_meshes_ = mesh_map{};
+        transparent_meshes_ = mesh_map{};
+        static_caster_key_ = 0;
+        num_dynamic_casters_ = 0;
+        dynamic_caster_bounds_ = frame_vector<caster_bounds>{};
+    }
 
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_view_projection_matrices0, false, view_projection_matrices[0]);
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_view_projection_matrices1, false, view_projection_matrices[1]);
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_view_projection_matrices2, false, view_projection_matrices[2]);
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_view_projection_matrices3, false, view_projection_matrices[3]);
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_view_projection_matrices4, false, view_projection_matrices[4]);
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_view_projection_matrices5, false, view_projection_matrices[5]);
+    void graphics_renderer::update_resolution_scale() {
+        // Every finished frame's timings are used once, to adjust the scale of the frames that follow.
+        if (const auto& timings = gpu_timer_->latest(); timings && timings->frame_ >= next_timed_frame_) {
+            next_timed_frame_ = timings->frame_ + 1;
+            stats_.gpu_frame_ = timings->frame_;
+            stats_.gpu_time_ms_ = timings->frame_time_ms_;
+            for (size_t i = 0; i < num_gpu_passes; ++i) { stats_.gpu_pass_times_ms_[i] = timings->pass_times_ms_[i]; }
+            resolution_controller_.update(timings->frame_time_ms_, frame_scales_[timings->frame_ % gpu_timer::max_frames_in_flight]);
+        }
 
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_light_pos, _trans.position_);
-        shader->set_uniform(shadow_cubemap_shader::uniform::u_shadow_distance, _light.get_shadow_distance());
+        // The render targets are allocated at the window size, and only a scaled region of them is rendered to.
+        const float scale = resolution_controller_.scale();
+        render_width_ = maths_util::max<uint32_t>(1, static_cast<uint32_t>(std::round(static_cast<float>(g_buff_->width()) * scale)));
+        render_height_ = maths_util::max<uint32_t>(1, static_cast<uint32_t>(std::round(static_cast<float>(g_buff_->height()) * scale)));
+        frame_scales_[frame_count_ % gpu_timer::max_frames_in_flight] = scale;
 
-        const auto draw_func = [&](std::unordered_map<material*, std::unordered_map<mesh*, std::vector<matrix4x4>>>& _meshes, bool _is_transparent) -> void {
-            for (auto& material_iter : _meshes) {
-                auto material_ptr = material_iter.first;
+        stats_.frame_ = frame_count_;
+        stats_.resolution_scale_ = scale;
+        stats_.render_width_ = render_width_;
+        stats_.render_height_ = render_height_;
+    }
 
-                if (material_ptr->texture_diffuse_) { material_ptr->texture_diffuse_->bind(texture_unit::texture_diffuse); }
+    void graphics_renderer::rank_lights() {
+        // A light's score is the highest it gets from any camera. With no camera, nothing is drawn, so every light is kept.
+        frame_vector<ranked_light> ranked;
+        ranked.reserve(lights_.size());
+        for (const auto& light_data : lights_) {
+            ranked.push_back({light_data.id_, cameras_.empty() ? 1.0f : 0.0f, light_data.light_.get_cast_shadows()});
+        }
+        auto cameras = cameras_;
+        while (!cameras.empty()) {
+            const auto& trans = cameras.top().transform_;
+            const auto view_matrix = matrix_util::view_matrix(trans.position_, trans.forward_, trans.up_);
+            for (size_t i = 0; i < lights_.size(); ++i) {
+                const float score = light_ranking::score(lights_[i].transform_, lights_[i].light_, view_matrix, cameras.top().camera_);
+                ranked[i].score_ = maths_util::max<float>(ranked[i].score_, score);
+            }
+            cameras.pop();
+        }
+        light_ranking_.rank(ranked, frame_count_);
+
+        frame_vector<light_data> shaded;
+        shaded.reserve(lights_.size());
+        for (size_t i = 0; i < lights_.size(); ++i) {
+            if (!ranked[i].shaded_) { continue; }
+            lights_[i].shadow_index_ = ranked[i].shadow_index_;
+            shaded.push_back(lights_[i]);
+        }
+        lights_ = std::move(shaded);
+    }
 
-                shader->set_uniform(shadow_cubemap_shader::uniform::u_is_transparent, _is_transparent);
-                shader->set_uniform(shadow_cubemap_shader::uniform::u_texture_offset, material_ptr->texture_offset_);
-                shader->set_uniform(shadow_cubemap_shader::uniform::u_texture_scale, material_ptr->texture_scale_);
-                shader->set_uniform(shadow_cubemap_shader::uniform::u_diffuse_colour, material_ptr->diffuse_colour_);
-                shader->set_uniform(shadow_cubemap_shader::uniform::u_has_texture_diffuse, material_ptr->texture_diffuse_ != nullptr);
+    bool graphics_renderer::shadow_cache::light_matches(const local_to_world& _transform, const light& _light) const {
+        return mode_ == _light.get_mode() &&
+               position_ == _transform.position_ && forward_ == _transform.forward_ && up_ == _transform.up_ &&
+               shadow_distance_ == _light.get_shadow_distance() &&
+               spotlight_outer_angle_ == _light.get_spotlight_outer_angle();
+    }
 
-                for (auto& mesh_iter : material_iter.second) {
-                    auto mesh_ptr = mesh_iter.first;
-                    auto& model_matrices = mesh_iter.second;
+    void graphics_renderer::shadow_cache::set_light(const local_to_world& _transform, const light& _light) {
+        mode_ = _light.get_mode();
+        position_ = _transform.position_;
+        forward_ = _transform.forward_;
+        up_ = _transform.up_;
+        shadow_distance_ = _light.get_shadow_distance();
+        spotlight_outer_angle_ = _light.get_spotlight_outer_angle();
+    }
 
-                    std::vector<mesh_instance_data> batch;
-                    for (auto& model_matrix : model_matrices) {
-                        batch.push_back({model_matrix, matrix3x3::identity()});
-                    }
+    uint32_t graphics_renderer::shadow_tile_size(const light_data& _light_data, const camera_data* _camera) const {
+        const auto& light = _light_data.light_;
+
+        // Directional lights cover the whole view, and split their tile between their cascades.
+        if (light.get_mode() == light_mode::directional) { return static_cast<uint32_t>(4096.0f * shadow_quality_); }
+
+        const float max_size = 2048.0f * shadow_quality_;
+        if (!_camera) { return static_cast<uint32_t>(max_size); }
+
+        // Estimate the fraction of the screen's height that the light's shadowed area covers.
+        const auto& cam = _camera->camera_;
+        const vector3 offset = _light_data.transform_.position_ - _camera->transform_.position_;
+        const float distance = std::sqrt(offset.dot(offset));
+        const float radius = maths_util::min<float>(light.get_shadow_distance(), light.get_range(lighting::light_cutoff));
+        float coverage = 1.0f;
+        if (cam.mode_ == projection_mode::perspective) {
+            if (distance > radius) { coverage = radius / (distance * std::tan(cam.fov_ * 0.5f)); }
+        } else {
+            coverage = 2.0f * radius / cam.ortho_size_;
+        }
+        return static_cast<uint32_t>(max_size * maths_util::clamp<float>(coverage, 0.0f, 1.0f));
+    }
 
-                    mesh_ptr->bind();
-                    mesh_ptr->set_instance_data(batch);
-                    glDrawElementsInstanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, model_matrices.size());
+    void graphics_renderer::allocate_shadow_maps() {
+        // Return the shadow maps of lights that have gone, or no longer cast shadows, first, so that their space can be reused this frame.
+        bool in_use[lighting::max_shadow_maps] = {};
+        for (const auto& light_data : lights_) {
+            if (light_data.shadow_index_ >= 0) { in_use[light_data.shadow_index_] = true; }
+        }
+        for (int32_t i = 0; i < static_cast<int32_t>(lighting::max_shadow_maps); ++i) {
+            if (!in_use[i]) { free_shadow_map(i); }
+        }
+
+        // Tiles are sized for the camera that is drawn first.
+        const camera_data* camera = cameras_.empty() ? nullptr : &cameras_.top();
+        for (auto& light_data : lights_) {
+            const auto i = light_data.shadow_index_;
+            if (i < 0) { continue; }
+
+            const auto mode = light_data.light_.get_mode();
+            auto& allocation = shadow_allocations_[i];
+            if (allocation.mode_ != mode) { free_shadow_map(i); }
+            allocation.mode_ = mode;
+
+            if (mode == light_mode::point) {
+                if (!allocation.layer_) { allocation.layer_ = shadow_atlas_->allocate_layer(); }
+            } else {
+                // Only move to a new tile when the light needs a larger one, or would do with one a quarter of the size,
+                // so that a light near the boundary between two sizes does not move back and forth every frame.
+                const uint32_t size = std::bit_floor(maths_util::max<uint32_t>(shadow_tile_size(light_data, camera), shadow_atlas::min_tile_size));
+                if (allocation.tile_ && (size > allocation.requested_size_ || size * 4 <= allocation.requested_size_)) { free_shadow_map(i); }
+                if (!allocation.tile_) {
+                    allocation.tile_ = shadow_atlas_->allocate_tile(size);
+                    allocation.requested_size_ = size;
                 }
             }
-        };
 
-        draw_func(deferred_meshes_, false);
-        draw_func(forward_meshes_, false);
-        draw_func(transparent_meshes_, true);
+            // The atlas is full, so the light does not get a shadow.
+            if (allocation.empty()) { light_data.shadow_index_ = -1; }
+        }
+    }
 
-        return matrix4x4::identity();
+    void graphics_renderer::free_shadow_map(int32_t _index) {
+        auto& allocation = shadow_allocations_[_index];
+        if (allocation.empty()) { return; }
+        if (allocation.tile_) { shadow_atlas_->free_tile(*allocation.tile_); }
+        if (allocation.layer_) { shadow_atlas_->free_layer(*allocation.layer_); }
+        allocation = shadow_allocation{};
+
+        // Whatever gets this shadow map next needs to render it from scratch.
+        shadow_caches_[_index] = shadow_cache{};
+        cascade_caches_[_index] = cascade_cache{};
     }
 
-    matrix4x4 graphics_renderer::spot_shadow(shadow_2d_buffer* _buffer, const local_to_world& _trans, const light& _light) {
-        glDisable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
-        glViewport(0, 0, _buffer->width(), _buffer->height()); // Viewport size MUST be buffer size, else it won't render to the buffer correctly.
+    void graphics_renderer::gather_dynamic_casters() {
+        dynamic_caster_bounds_.reserve(num_dynamic_casters_);
+        for (const auto* meshes : {&deferred_meshes_, &forward_meshes_, &transparent_meshes_}) {
+            for (const auto& material_iter : *meshes) {
+                for (const auto& mesh_iter : material_iter.second) {
+                    for (const auto& instance : mesh_iter.second) {
+                        if (instance.is_static_) { continue; }
+                        const auto sphere = caster_sphere(mesh_iter.first, instance.model_matrix_);
+                        dynamic_caster_bounds_.push_back({sphere.centre(), sphere.radius(), mesh_iter.first, &instance.model_matrix_});
+                    }
+                }
+            }
+        }
+    }
 
-        _buffer->bind();
-        _buffer->clear_depth_stencil();
+    uint64_t graphics_renderer::dynamic_caster_key(const local_to_world& _trans, const light& _light) const {
+        // Spot and point lights only cast shadows within their shadow distance, so only the casters in range are hashed.
+        // Keys are summed, as the iteration order of the maps is not guaranteed to be the same every frame.
+        const float light_radius = _light.get_shadow_distance();
+        uint64_t key = 0;
+        for (const auto& bounds : dynamic_caster_bounds_) {
+            const float max_distance = light_radius + bounds.radius_;
+            const vector3 offset = bounds.centre_ - _trans.position_;
+            if (offset.dot(offset) > max_distance * max_distance) { continue; }
+
+            // Identifies the mesh and its transform, so that a moved caster is detected.
+            const auto& m = *bounds.model_matrix_;
+            uint64_t caster_key = mix_key(reinterpret_cast<uintptr_t>(bounds.mesh_));
+            for (auto col = 0; col < 4; ++col) {
+                for (auto row = 0; row < 4; ++row) {
+                    caster_key = mix_key(caster_key ^ std::bit_cast<uint32_t>(m[col][row]));
+                }
+            }
+            key += caster_key;
+        }
+        return key;
+    }
 
-        const auto view_matrix = matrix_util::view_matrix(_trans.position_, _trans.forward_, _trans.up_);
-        const auto projection_matrix = matrix_util::perspective_matrix(1.0f, _light.get_spotlight_outer_angle(), 0.1f, _light.get_shadow_distance());
+    void graphics_renderer::update_shadow_map(int32_t _index, const light_data& _light_data, uint64_t _static_key) {
+        auto& cache = shadow_caches_[_index];
+        const auto& allocation = shadow_allocations_[_index];
+        const auto& trans = _light_data.transform_;
+        const auto& light = _light_data.light_;
+        const bool is_point = light.get_mode() == light_mode::point;
+        const bool light_changed = !cache.light_matches(trans, light);
+        const uint64_t dynamic_key = dynamic_caster_key(trans, light);
+
+        if (!split_shadow_cache_) {
+            if (cache.valid_ && !light_changed && cache.static_key_ == _static_key && cache.dynamic_key_ == dynamic_key) { return; }
+
+            light_view_projection_matrix_[_index] = is_point ? point_shadow(shadow_atlas_->cubemaps(), *allocation.layer_, trans, light, caster_set::all)
+                                                             : spot_shadow(shadow_atlas_->buffer(), *allocation.tile_, trans, light, caster_set::all);
+            cache.static_valid_ = false;
+        } else {
+            // Static layer. The static copies of the atlas are only created once they are needed.
+            if (!cache.static_valid_ || light_changed || cache.static_key_ != _static_key) {
+                light_view_projection_matrix_[_index] = is_point ? point_shadow(shadow_atlas_->static_cubemaps(), *allocation.layer_, trans, light, caster_set::static_only)
+                                                                 : spot_shadow(shadow_atlas_->static_buffer(), *allocation.tile_, trans, light, caster_set::static_only);
+                cache.static_valid_ = true;
+                cache.valid_ = false;
+            }
 
-        auto shader = mkr::material::shadow_shader_2d_;
-        shader->use();
-        shader->set_uniform(shadow_2d_shader::uniform::u_view_matrix, false, view_matrix);
-        shader->set_uniform(shadow_2d_shader::uniform::u_projection_matrix, false, projection_matrix);
+            // Dynamic overlay. Start from a copy of the static layer, and draw the dynamic casters on top of it.
+            if (cache.valid_ && cache.dynamic_key_ == dynamic_key) { return; }
+
+            if (is_point) {
+                shadow_atlas_->static_cubemaps()->copy_layers_to(shadow_atlas_->cubemaps(), *allocation.layer_, 1);
+                point_shadow(shadow_atlas_->cubemaps(), *allocation.layer_, trans, light, caster_set::dynamic_only, false);
+            } else {
+                const auto& tile = *allocation.tile_;
+                shadow_atlas_->static_buffer()->copy_region_to(shadow_atlas_->buffer(), tile.x_, tile.y_, tile.size_, tile.size_);
+                spot_shadow(shadow_atlas_->buffer(), tile, trans, light, caster_set::dynamic_only, false);
+            }
+        }
 
-        const auto draw_func = [&](std::unordered_map<material*, std::unordered_map<mesh*, std::vector<matrix4x4>>>& _meshes, bool _is_transparent) -> void {
+        cache.valid_ = true;
+        cache.set_light(trans, light);
+        cache.static_key_ = _static_key;
+        cache.dynamic_key_ = dynamic_key;
+    }
+
+    template<typename Shader>
+    void graphics_renderer::draw_shadow_casters(shader_program* _shader, caster_set _casters) {
+        draw_shadow_casters<Shader>(_shader, _casters, [](const mesh*, const matrix4x4&) { return true; });
+    }
+
+    template<typename Shader, typename Visible>
+    void graphics_renderer::draw_shadow_casters(shader_program* _shader, caster_set _casters, const Visible& _visible) {
+        const auto draw_func = [&](const mesh_map& _meshes, bool _is_transparent) -> void {
             for (auto& material_iter : _meshes) {
                 auto material_ptr = material_iter.first;
 
                 if (material_ptr->texture_diffuse_) { material_ptr->texture_diffuse_->bind(texture_unit::texture_diffuse); }
 
-                shader->set_uniform(shadow_2d_shader::uniform::u_is_transparent, _is_transparent);
-                shader->set_uniform(shadow_2d_shader::uniform::u_texture_offset, material_ptr->texture_offset_);
-                shader->set_uniform(shadow_2d_shader::uniform::u_texture_scale, material_ptr->texture_scale_);
-                shader->set_uniform(shadow_2d_shader::uniform::u_diffuse_colour, material_ptr->diffuse_colour_);
-                shader->set_uniform(shadow_2d_shader::uniform::u_has_texture_diffuse, material_ptr->texture_diffuse_ != nullptr);
+                _shader->set_uniform(Shader::uniform::u_is_transparent, _is_transparent);
+                _shader->set_uniform(Shader::uniform::u_texture_offset, material_ptr->texture_offset_);
+                _shader->set_uniform(Shader::uniform::u_texture_scale, material_ptr->texture_scale_);
+                _shader->set_uniform(Shader::uniform::u_diffuse_colour, material_ptr->diffuse_colour_);
+                _shader->set_uniform(Shader::uniform::u_has_texture_diffuse, material_ptr->texture_diffuse_ != nullptr);
 
                 for (auto& mesh_iter : material_iter.second) {
                     auto mesh_ptr = mesh_iter.first;
-                    auto& model_matrices = mesh_iter.second;
-
-                    std::vector<mesh_instance_data> batch;
-                    for (auto& model_matrix : model_matrices) {
-                        batch.push_back({model_matrix, matrix3x3::identity()});
+                    auto& instances = mesh_iter.second;
+
+                    frame_vector<mesh_instance_data> batch;
+                    batch.reserve(instances.size());
+                    for (auto& instance : instances) {
+                        if (_casters == caster_set::static_only && !instance.is_static_) { continue; }
+                        if (_casters == caster_set::dynamic_only && instance.is_static_) { continue; }
+                        if (_visible(mesh_ptr, instance.model_matrix_)) { batch.push_back({instance.model_matrix_, matrix3x3::identity()}); }
                     }
+                    if (batch.empty()) { continue; }
 
                     mesh_ptr->bind();
-                    mesh_ptr->set_instance_data(batch);
-                    glDrawElementsInstanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, model_matrices.size());
+                    mesh_ptr->set_instance_data(batch.data(), batch.size());
+                    gfx().draw_elements_instanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, batch.size());
+                    count_draw(mesh_ptr->num_indices(), batch.size());
                 }
             }
         };
 
+        // The shadow casters are drawn straight from the meshes submitted for the camera passes.
         draw_func(deferred_meshes_, false);
         draw_func(forward_meshes_, false);
         draw_func(transparent_meshes_, true);
+    }
 
-        return projection_matrix * view_matrix;
+    matrix4x4 graphics_renderer::point_shadow(shadow_cubemap_array_buffer* _buffer, uint32_t _layer, const local_to_world& _trans, const light& _light, caster_set _casters, bool _clear) {
+        gfx().disable(GL_BLEND);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().depth_func(GL_LESS);
+        gfx().viewport(0, 0, _buffer->width(), _buffer->height());
+
+        const float shadow_distance = _light.get_shadow_distance();
+        const matrix4x4 projection_matrix = matrix_util::perspective_matrix(1.0f, maths_util::pi / 2.0f, 0.05f, shadow_distance);
+        const vector3 face_directions[6] = {vector3::left(), vector3::right(), vector3::up(), vector3::down(), vector3::forwards(), vector3::backwards()};
+        const vector3 face_ups[6] = {vector3::down(), vector3::down(), vector3::forwards(), vector3::backwards(), vector3::down(), vector3::down()};
+
+        auto shader = mkr::material::shadow_shader_cube_;
+        shader->use();
+        shader->set_uniform(shadow_cubemap_shader::uniform::u_light_pos, _trans.position_);
+        shader->set_uniform(shadow_cubemap_shader::uniform::u_shadow_distance, shadow_distance);
+
+        // Render each face as a separate pass, so that every face only draws the casters inside its own frustum.
+        for (uint32_t face = 0; face < 6; ++face) {
+            _buffer->bind_face(_layer, face);
+            if (_clear) { _buffer->clear_depth_stencil(); }
+
+            shader->set_uniform(shadow_cubemap_shader::uniform::u_view_projection_matrix, false, projection_matrix * matrix_util::view_matrix(_trans.position_, face_directions[face], face_ups[face]));
+            draw_shadow_casters<shadow_cubemap_shader>(shader, _casters, [&](const mesh* _mesh, const matrix4x4& _model_matrix) {
+                const auto sphere = caster_sphere(_mesh, _model_matrix);
+                return shadow_culling::in_sphere(sphere, _trans.position_, shadow_distance) &&
+                       shadow_culling::in_cube_face(sphere, _trans.position_, face_directions[face]);
+            });
+        }
+
+        return matrix4x4::identity();
     }
 
-    matrix4x4 graphics_renderer::directional_shadow(shadow_2d_buffer* _buffer, const local_to_world& _light_trans, const light& _light, const local_to_world& _cam_trans, const camera& _cam) {
-        glDisable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
-        glViewport(0, 0, _buffer->width(), _buffer->height()); // Viewport size MUST be buffer size, else it won't render to the buffer correctly.
-
-        _buffer->bind();
-        _buffer->clear_depth_stencil();
-
-        const auto light_view_matrix = matrix_util::view_matrix(vector3::zero(), _light_trans.forward_, _light_trans.up_);
-        const auto light_view_matrix_inverse = light_view_matrix.transposed(); // Since translation is 0, inverse equals transpose.
-        const auto bounds = shadow_bounds::get_perspective_bounds(light_view_matrix,
-                                                                  _cam_trans.position_,
-                                                                  _cam_trans.left_, _cam_trans.up_, _cam_trans.forward_,
-                                                                  _cam.near_plane_, _light.get_shadow_distance(),
-                                                                  _cam.aspect_ratio_, _cam.fov_);
-        const float width = bounds.max().x_ - bounds.min().x_;
-        const float height = bounds.max().y_ - bounds.min().y_;
-        const float near = bounds.min().z_ - bounds.centre().z_;
-        const float far = bounds.max().z_ - bounds.centre().z_;
-        const auto view_matrix = matrix_util::view_matrix(light_view_matrix_inverse * bounds.centre(), _light_trans.forward_, _light_trans.up_);
-        const auto projection_matrix = matrix_util::orthographic_matrix(width / height, height, near, far);
+    matrix4x4 graphics_renderer::spot_shadow(shadow_atlas_buffer* _buffer, const shadow_tile& _tile, const local_to_world& _trans, const light& _light, caster_set _casters, bool _clear) {
+        gfx().disable(GL_BLEND);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().depth_func(GL_LESS);
+        gfx().enable(GL_SCISSOR_TEST); // Only clear the light's tile of the atlas.
+
+        _buffer->bind_tile(_tile.x_, _tile.y_, _tile.size_);
+        if (_clear) { _buffer->clear_depth_stencil(); }
+
+        const auto view_matrix = matrix_util::view_matrix(_trans.position_, _trans.forward_, _trans.up_);
+        const auto projection_matrix = matrix_util::perspective_matrix(1.0f, _light.get_spotlight_outer_angle(), 0.1f, _light.get_shadow_distance());
 
         auto shader = mkr::material::shadow_shader_2d_;
         shader->use();
         shader->set_uniform(shadow_2d_shader::uniform::u_view_matrix, false, view_matrix);
         shader->set_uniform(shadow_2d_shader::uniform::u_projection_matrix, false, projection_matrix);
 
-        const auto draw_func = [&](std::unordered_map<material*, std::unordered_map<mesh*, std::vector<matrix4x4>>>& _meshes, bool _is_transparent) -> void {
-            for (auto& material_iter : _meshes) {
-                auto material_ptr = material_iter.first;
+        // Only draw the casters inside the light's cone.
+        const float half_angle = _light.get_spotlight_outer_angle() * 0.5f;
+        draw_shadow_casters<shadow_2d_shader>(shader, _casters, [&](const mesh* _mesh, const matrix4x4& _model_matrix) {
+            return shadow_culling::in_cone(caster_sphere(_mesh, _model_matrix), _trans.position_, _trans.forward_, half_angle, _light.get_shadow_distance());
+        });
 
-                if (material_ptr->texture_diffuse_) { material_ptr->texture_diffuse_->bind(texture_unit::texture_diffuse); }
+        gfx().disable(GL_SCISSOR_TEST);
+        return projection_matrix * view_matrix;
+    }
 
-                shader->set_uniform(shadow_2d_shader::uniform::u_is_transparent, _is_transparent);
-                shader->set_uniform(shadow_2d_shader::uniform::u_texture_offset, material_ptr->texture_offset_);
-                shader->set_uniform(shadow_2d_shader::uniform::u_texture_scale, material_ptr->texture_scale_);
-                shader->set_uniform(shadow_2d_shader::uniform::u_diffuse_colour, material_ptr->diffuse_colour_);
-                shader->set_uniform(shadow_2d_shader::uniform::u_has_texture_diffuse, material_ptr->texture_diffuse_ != nullptr);
+    void graphics_renderer::directional_shadow(int32_t _index, const light_data& _light_data, const local_to_world& _cam_trans, const camera& _cam, bool _reuse_far_cascades) {
+        auto buffer = shadow_atlas_->buffer();
+        const auto& tile = *shadow_allocations_[_index].tile_;
+        const auto& light_trans = _light_data.transform_;
+        const auto& light = _light_data.light_;
+        const uint32_t num_cascades = light.get_num_cascades();
+        const uint32_t tiles_per_side = (num_cascades > 1) ? 2 : 1;
+        const uint32_t tile_size = tile.size_ / tiles_per_side;
+
+        float split_distances[lighting::max_cascades] = {};
+        shadow_cascades::get_split_distances(_cam.near_plane_, light.get_shadow_distance(), num_cascades, light.get_cascade_split_lambda(), split_distances);
+
+        // Cascades rendered in an earlier frame can only be kept if they were rendered for the same light and splits.
+        auto& cache = cascade_caches_[_index];
+        bool cache_matches = _reuse_far_cascades && cache.num_cascades_ == num_cascades && cache.forward_ == light_trans.forward_ && cache.up_ == light_trans.up_;
+        for (uint32_t i = 0; i < num_cascades; ++i) {
+            cache_matches = cache_matches && cache.split_distances_[i] == split_distances[i];
+            cache.split_distances_[i] = split_distances[i];
+        }
+        if (!cache_matches) {
+            for (auto& valid : cache.valid_) { valid = false; }
+        }
+        cache.num_cascades_ = num_cascades;
+        cache.forward_ = light_trans.forward_;
+        cache.up_ = light_trans.up_;
 
-                for (auto& mesh_iter : material_iter.second) {
-                    auto mesh_ptr = mesh_iter.first;
-                    auto& model_matrices = mesh_iter.second;
+        gfx().disable(GL_BLEND);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().depth_func(GL_LESS);
+        gfx().enable(GL_DEPTH_CLAMP); // Casters between the light and a cascade are clamped onto its near plane, so the cascade only needs to be as deep as its bounding sphere.
+        gfx().enable(GL_SCISSOR_TEST); // Only clear the tiles of the cascades being rendered.
 
-                    std::vector<mesh_instance_data> batch;
-                    for (auto& model_matrix : model_matrices) {
-                        batch.push_back({model_matrix, matrix3x3::identity()});
-                    }
+        auto shader = mkr::material::shadow_shader_2d_;
+        shader->use();
 
-                    mesh_ptr->bind();
-                    mesh_ptr->set_instance_data(batch);
-                    glDrawElementsInstanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, model_matrices.size());
+        for (uint32_t i = 0; i < num_cascades; ++i) {
+            // Far cascades cover a large area at a low resolution, so they can be updated less often.
+            const bool update_due = i < 2 || (frame_count_ + i) % far_cascade_update_interval_ == 0;
+            if (cache.valid_[i] && !update_due) { continue; }
+
+            const float near = (i == 0) ? _cam.near_plane_ : split_distances[i - 1];
+            const auto slice = shadow_cascades::get_slice_sphere(_cam_trans.position_, _cam_trans.forward_, _cam, near, split_distances[i]);
+            const auto cascade = shadow_cascades::fit_cascade(light_trans.forward_, light_trans.up_, slice, tile_size);
+
+            buffer->bind_tile(tile.x_ + (i % tiles_per_side) * tile_size, tile.y_ + (i / tiles_per_side) * tile_size, tile_size);
+            buffer->clear_depth_stencil();
+
+            shader->set_uniform(shadow_2d_shader::uniform::u_view_matrix, false, cascade.view_matrix_);
+            shader->set_uniform(shadow_2d_shader::uniform::u_projection_matrix, false, cascade.projection_matrix_);
+
+            draw_shadow_casters<shadow_2d_shader>(shader, caster_set::all, [&](const mesh* _mesh, const matrix4x4& _model_matrix) {
+                return cascade.intersects(caster_sphere(_mesh, _model_matrix));
+            });
+
+            cache.view_projection_matrices_[i] = cascade.projection_matrix_ * cascade.view_matrix_;
+            cache.valid_[i] = true;
+        }
+
+        gfx().disable(GL_SCISSOR_TEST);
+        gfx().disable(GL_DEPTH_CLAMP);
+
+        auto& data = shadow_data_[_index];
+        data.num_cascades_ = static_cast<int32_t>(num_cascades);
+        data.cubemap_layer_ = -1;
+        for (uint32_t i = 0; i < num_cascades; ++i) {
+            data.split_distances_[i] = split_distances[i];
+            to_column_major(cache.view_projection_matrices_[i], data.view_projection_matrices_[i]);
+            to_tile_rect(tile.x_ + (i % tiles_per_side) * tile_size, tile.y_ + (i / tiles_per_side) * tile_size, tile_size, shadow_atlas_->size(), data.tile_rects_[i]);
+        }
+        light_view_projection_matrix_[_index] = cache.view_projection_matrices_[0];
+    }
+
+    void graphics_renderer::build_light_clusters(const matrix4x4& _view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z, const camera& _camera) {
+        const auto to_gpu_light = [&](const light_data& _light_data) -> gpu_light {
+            const auto& t = _light_data.transform_;
+            const auto& l = _light_data.light_;
+
+            const auto light_pos_view = _view_matrix * t.position_; // Light position in view space.
+            const auto light_dir_view = vector3{_view_dir_x.dot(t.forward_), _view_dir_y.dot(t.forward_), _view_dir_z.dot(t.forward_)}.normalised(); // Light direction in view space.
+            const auto& light_colour = l.get_colour();
+            const auto& view_projection_matrix = (_light_data.shadow_index_ < 0) ? matrix4x4::identity() : light_view_projection_matrix_[_light_data.shadow_index_];
+
+            gpu_light result{
+                {light_colour.r_, light_colour.g_, light_colour.b_, light_colour.a_},
+                {light_pos_view.x_, light_pos_view.y_, light_pos_view.z_},
+                l.get_power(),
+                {light_dir_view.x_, light_dir_view.y_, light_dir_view.z_},
+                static_cast<int32_t>(l.get_mode()),
+                l.get_attenuation_constant(),
+                l.get_attenuation_linear(),
+                l.get_attenuation_quadratic(),
+                l.get_range(lighting::light_cutoff),
+                l.get_spotlight_inner_consine(),
+                l.get_spotlight_outer_consine(),
+                l.get_shadow_distance(),
+                _light_data.shadow_index_,
+                {},
+            };
+            for (auto col = 0; col < 4; ++col) {
+                for (auto row = 0; row < 4; ++row) {
+                    result.view_projection_matrix_[col * 4 + row] = view_projection_matrix[col][row];
                 }
             }
+            return result;
         };
 
-        draw_func(deferred_meshes_, false);
-        draw_func(forward_meshes_, false);
-        draw_func(transparent_meshes_, true);
+        // Directional lights affect every cluster, and go at the front of the list.
+        frame_vector<gpu_light> gpu_lights;
+        gpu_lights.reserve(lights_.size());
+        for (const auto& light_data : lights_) {
+            if (light_data.light_.get_mode() == light_mode::directional) { gpu_lights.push_back(to_gpu_light(light_data)); }
+        }
+        const auto num_directional = static_cast<uint32_t>(gpu_lights.size());
+        for (const auto& light_data : lights_) {
+            if (light_data.light_.get_mode() != light_mode::directional) { gpu_lights.push_back(to_gpu_light(light_data)); }
+        }
 
-        return projection_matrix * view_matrix;
+        light_clusters_->build(gpu_lights, num_directional, _camera, render_width_, render_height_);
+        light_clusters_->bind();
+    }
+
+    void graphics_renderer::bind_shadow_maps() {
+        shadow_buffer_->bind(storage_binding::shadow_list);
+        shadow_atlas_->bind();
     }
 
     void graphics_renderer::geometry_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix) {
-        glDisable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
-        glViewport(0, 0, g_buff_->width(), g_buff_->height()); // Viewport size MUST be buffer size, else it won't render to the buffer correctly.
+        gfx().disable(GL_BLEND);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().depth_func(GL_LESS);
+        gfx().viewport(0, 0, render_width_, render_height_); // Only the scaled region of the render targets is rendered to.
 
         g_buff_->bind();
         g_buff_->set_draw_colour_attachment_all();
@@ -391,26 +851,29 @@ namespace mkr {
             // Draw to screen.
             for (auto& mesh_iter : material_iter.second) {
                 auto mesh_ptr = mesh_iter.first;
-                auto& model_matrices = mesh_iter.second;
+                auto& instances = mesh_iter.second;
 
-                std::vector<mesh_instance_data> batch;
-                for (auto& model_matrix : model_matrices) {
+                frame_vector<mesh_instance_data> batch;
+                batch.reserve(instances.size());
+                for (auto& instance : instances) {
+                    const auto& model_matrix = instance.model_matrix_;
                     const auto model_view_inverse = matrix_util::inverse_matrix(_view_matrix * model_matrix).value_or(matrix4x4::identity());
                     const auto normal_matrix = matrix_util::minor_matrix(model_view_inverse.transposed(), 3, 3);
                     batch.push_back({model_matrix, normal_matrix});
                 }
 
                 mesh_ptr->bind();
-                mesh_ptr->set_instance_data(batch);
-                glDrawElementsInstanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, model_matrices.size());
+                mesh_ptr->set_instance_data(batch.data(), batch.size());
+                gfx().draw_elements_instanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, instances.size());
+                count_draw(mesh_ptr->num_indices(), instances.size());
             }
         }
     }
 
-    void graphics_renderer::lighting_pass(const matrix4x4& _view_matrix, const matrix4x4& _inv_view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z) {
-        glDisable(GL_BLEND);
-        glDisable(GL_DEPTH_TEST);
-        glViewport(0, 0, l_buff_->width(), l_buff_->height());
+    void graphics_renderer::lighting_pass(const matrix4x4& _inv_view_matrix, const matrix4x4& _inv_projection_matrix) {
+        gfx().disable(GL_BLEND);
+        gfx().disable(GL_DEPTH_TEST);
+        gfx().viewport(0, 0, render_width_, render_height_);
 
         l_buff_->bind();
         l_buff_->set_draw_colour_attachment_all();
@@ -422,94 +885,142 @@ namespace mkr {
 
         // Bind mesh.
         screen_quad_->bind();
-        screen_quad_->set_instance_data({{matrix4x4::identity(), matrix3x3::identity()}});
+        const mesh_instance_data screen_quad_instance{matrix4x4::identity(), matrix3x3::identity()};
+        screen_quad_->set_instance_data(&screen_quad_instance, 1);
 
-        // Bind textures.
-        g_buff_->get_colour_attachment(geometry_buffer::colour_attachments::position)->bind(texture_unit::texture_position);
+        // Bind textures. Positions are reconstructed from the depth buffer.
+        g_buff_->get_depth_stencil_attachment()->bind(texture_unit::texture_depth);
         g_buff_->get_colour_attachment(geometry_buffer::colour_attachments::normal)->bind(texture_unit::texture_normal);
         g_buff_->get_colour_attachment(geometry_buffer::colour_attachments::diffuse)->bind(texture_unit::texture_diffuse);
         g_buff_->get_colour_attachment(geometry_buffer::colour_attachments::specular)->bind(texture_unit::texture_specular);
 
         // Bind shadow maps.
-        const auto num_lights = maths_util::min<int32_t>(lights_.size(), lighting::max_lights);
-        for (auto i = 0; i < num_lights; ++i) {
-            if (light_mode::point == lights_[i].light_.get_mode()) {
-                scube_buff_[i]->get_depth_stencil_attachment()->bind(texture_unit::cubemap_shadows0 + i);
-            } else {
-                s2d_buff_[i]->get_depth_stencil_attachment()->bind(texture_unit::texture_shadows0 + i);
-            }
-        }
+        bind_shadow_maps();
 
         // Transform
         shader->set_uniform(lighting_shader::uniform::u_inv_view_matrix, false, _inv_view_matrix);
+        shader->set_uniform(lighting_shader::uniform::u_inv_projection_matrix, false, _inv_projection_matrix);
+        shader->set_uniform(lighting_shader::uniform::u_viewport_size, vector2{static_cast<float>(render_width_), static_cast<float>(render_height_)});
 
-        // Lights.
-        shader->set_uniform(lighting_shader::uniform::u_num_lights, num_lights);
+        // Lights. The light lists are in the light cluster storage buffers.
         shader->set_uniform(lighting_shader::uniform::u_ambient_light, lighting::ambient_light_);
+        shader->set_uniform(lighting_shader::uniform::u_directional_only, lighting_mode_ == deferred_lighting_mode::light_volumes);
 
-        for (auto i = 0; i < num_lights; ++i) {
-            const auto& t = lights_[i].transform_;
-            const auto& l = lights_[i].light_;
-
-            const auto light_pos_view = _view_matrix * t.position_; // Light position in view space.
-            const auto light_dir_view = vector3{_view_dir_x.dot(t.forward_), _view_dir_y.dot(t.forward_), _view_dir_z.dot(t.forward_)}.normalised(); // Light direction in view space.
-
-            shader->set_uniform(i + lighting_shader::uniform::u_light_mode0, l.get_mode());
-            shader->set_uniform(i + lighting_shader::uniform::u_light_power0, l.get_power());
-            shader->set_uniform(i + lighting_shader::uniform::u_light_colour0, l.get_colour());
+        // Draw.
+        gfx().draw_elements_instanced(GL_TRIANGLES, screen_quad_->num_indices(), GL_UNSIGNED_INT, 0, 1);
+        count_draw(screen_quad_->num_indices(), 1);
+    }
 
-            shader->set_uniform(i + lighting_shader::uniform::u_light_attenuation_constant0, l.get_attenuation_constant());
-            shader->set_uniform(i + lighting_shader::uniform::u_light_attenuation_linear0, l.get_attenuation_linear());
-            shader->set_uniform(i + lighting_shader::uniform::u_light_attenuation_quadratic0, l.get_attenuation_quadratic());
+    void graphics_renderer::light_volume_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix, const matrix4x4& _inv_projection_matrix, const camera& _camera) {
+        // The scene's depth is needed to find the pixels that are inside each light's volume.
+        g_buff_->blit_to(l_buff_.get(), false, true, true, 0, 0, render_width_, render_height_, 0, 0, render_width_, render_height_);
 
-            shader->set_uniform(i + lighting_shader::uniform::u_light_spotlight_inner_cosine0, l.get_spotlight_inner_consine());
-            shader->set_uniform(i + lighting_shader::uniform::u_light_spotlight_outer_cosine0, l.get_spotlight_outer_consine());
+        gfx().viewport(0, 0, render_width_, render_height_);
+        l_buff_->bind();
+        l_buff_->set_draw_colour_attachment(lighting_buffer::colour_attachments::colour);
+
+        // Every light is added on top of the ambient and directional lighting.
+        gfx().enable(GL_BLEND);
+        gfx().blend_func(GL_ONE, GL_ONE);
+        gfx().enable(GL_STENCIL_TEST);
+        gfx().stencil_mask(0xFF);
+        gfx().disable(GL_CULL_FACE);
+        gfx().depth_mask(GL_FALSE);
+        gfx().depth_func(GL_LESS);
+
+        auto shader = material::light_volume_shader_;
+        shader->use();
 
-            shader->set_uniform(i + lighting_shader::uniform::u_light_position0, light_pos_view);
-            shader->set_uniform(i + lighting_shader::uniform::u_light_direction0, light_dir_view);
+        g_buff_->get_depth_stencil_attachment()->bind(texture_unit::texture_depth);
+        g_buff_->get_colour_attachment(geometry_buffer::colour_attachments::normal)->bind(texture_unit::texture_normal);
+        g_buff_->get_colour_attachment(geometry_buffer::colour_attachments::diffuse)->bind(texture_unit::texture_diffuse);
+        g_buff_->get_colour_attachment(geometry_buffer::colour_attachments::specular)->bind(texture_unit::texture_specular);
+        bind_shadow_maps();
+
+        shader->set_uniform(light_volume_shader::uniform::u_view_matrix, false, _view_matrix);
+        shader->set_uniform(light_volume_shader::uniform::u_projection_matrix, false, _projection_matrix);
+        shader->set_uniform(light_volume_shader::uniform::u_inv_view_matrix, false, _inv_view_matrix);
+        shader->set_uniform(light_volume_shader::uniform::u_inv_projection_matrix, false, _inv_projection_matrix);
+        shader->set_uniform(light_volume_shader::uniform::u_viewport_size, vector2{static_cast<float>(render_width_), static_cast<float>(render_height_)});
+
+        // Directional lights are at the front of the light list, and were drawn by the full screen pass.
+        uint32_t light_index = 0;
+        for (const auto& light_data : lights_) {
+            if (light_data.light_.get_mode() == light_mode::directional) { ++light_index; }
+        }
 
-            shader->set_uniform(i + lighting_shader::uniform::u_light_shadow_distance0, l.get_shadow_distance());
-            shader->set_uniform(i + lighting_shader::uniform::u_light_view_projection_matrix0, false, light_view_projection_matrix_[i]);
+        for (const auto& light_data : lights_) {
+            const auto& trans = light_data.transform_;
+            const auto& light = light_data.light_;
+            if (light.get_mode() == light_mode::directional) { continue; }
+
+            // Lights that do not attenuate reach the whole view.
+            float range = light.get_range(lighting::light_cutoff);
+            if (!std::isfinite(range)) { range = _camera.far_plane_; }
+
+            // Wide spot lights are better bounded by a sphere than by a very flat cone.
+            const float half_angle = light.get_spotlight_outer_angle() * 0.5f;
+            const bool use_cone = light.get_mode() == light_mode::spot && half_angle < maths_util::deg2rad * 60.0f;
+            mesh* proxy = use_cone ? light_cone_.get() : light_sphere_.get();
+
+            matrix4x4 model_matrix = matrix4x4::identity();
+            const vector3 axes[3] = {use_cone ? trans.left_ * (range * std::tan(half_angle)) : vector3{range, 0.0f, 0.0f},
+                                     use_cone ? trans.up_ * (range * std::tan(half_angle)) : vector3{0.0f, range, 0.0f},
+                                     use_cone ? trans.forward_ * range : vector3{0.0f, 0.0f, range}};
+            for (auto col = 0; col < 3; ++col) {
+                model_matrix[col][0] = axes[col].x_;
+                model_matrix[col][1] = axes[col].y_;
+                model_matrix[col][2] = axes[col].z_;
+            }
+            model_matrix[3][0] = trans.position_.x_;
+            model_matrix[3][1] = trans.position_.y_;
+            model_matrix[3][2] = trans.position_.z_;
+
+            const mesh_instance_data proxy_instance{model_matrix, matrix3x3::identity()};
+            proxy->bind();
+            proxy->set_instance_data(&proxy_instance, 1);
+
+            // Stencil pass. Count the faces of the volume that are behind the scene, up for back faces and down for front faces.
+            // Only pixels with geometry inside the volume are left non-zero. Depth clamping stops the far plane from cutting off the back of the volume.
+            gfx().color_mask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            gfx().enable(GL_DEPTH_TEST);
+            gfx().enable(GL_DEPTH_CLAMP);
+            gfx().stencil_func(GL_ALWAYS, 0, 0xFF);
+            gfx().stencil_op_separate(GL_BACK, GL_KEEP, GL_INCR_WRAP, GL_KEEP);
+            gfx().stencil_op_separate(GL_FRONT, GL_KEEP, GL_DECR_WRAP, GL_KEEP);
+            gfx().draw_elements_instanced(GL_TRIANGLES, proxy->num_indices(), GL_UNSIGNED_INT, 0, 1);
+            count_draw(proxy->num_indices(), 1);
+
+            // Light pass. Shade the marked pixels, and reset their stencil so that they are shaded once and the stencil is clear for the next light.
+            gfx().color_mask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            gfx().disable(GL_DEPTH_TEST);
+            gfx().disable(GL_DEPTH_CLAMP);
+            gfx().stencil_func(GL_NOTEQUAL, 0, 0xFF);
+            gfx().stencil_op(GL_KEEP, GL_KEEP, GL_ZERO);
+            shader->set_uniform(light_volume_shader::uniform::u_light_index, light_index++);
+            gfx().draw_elements_instanced(GL_TRIANGLES, proxy->num_indices(), GL_UNSIGNED_INT, 0, 1);
+            count_draw(proxy->num_indices(), 1);
         }
 
-        // Draw.
-        glDrawElementsInstanced(GL_TRIANGLES, screen_quad_->num_indices(), GL_UNSIGNED_INT, 0, 1);
+        gfx().disable(GL_STENCIL_TEST);
+        gfx().enable(GL_CULL_FACE);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        l_buff_->set_draw_colour_attachment_all();
     }
 
-    void graphics_renderer::forward_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z) {
-        glDisable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
+    void graphics_renderer::forward_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix) {
+        gfx().disable(GL_BLEND);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().depth_func(GL_LESS);
 
-        glViewport(0, 0, f_buff_->width(), f_buff_->height());
+        gfx().viewport(0, 0, render_width_, render_height_);
 
-        // Clear colour attachments.
+        // The forward buffer shares the lighting output and the geometry buffer's normals and depth, so it must not be cleared.
         f_buff_->bind();
         f_buff_->set_draw_colour_attachment_all();
-        f_buff_->clear_colour_all();
-        f_buff_->clear_depth_stencil();
-
-        // Blit colour.
-        l_buff_->set_read_colour_attachment(lighting_buffer::colour_attachments::colour);
-        f_buff_->set_draw_colour_attachment(forward_buffer::colour_attachments::colour);
-        l_buff_->blit_to(f_buff_.get(), true, false, false, 0, 0, l_buff_->width(), l_buff_->height(), 0, 0, f_buff_->width(), f_buff_->height());
-
-        // Blit positions.
-        g_buff_->set_read_colour_attachment(geometry_buffer::colour_attachments::position);
-        f_buff_->set_draw_colour_attachment(forward_buffer::colour_attachments::position);
-        g_buff_->blit_to(f_buff_.get(), true, false, false, 0, 0, g_buff_->width(), g_buff_->height(), 0, 0, f_buff_->width(), f_buff_->height());
-
-        // Blit normals.
-        g_buff_->set_read_colour_attachment(geometry_buffer::colour_attachments::normal);
-        f_buff_->set_draw_colour_attachment(forward_buffer::colour_attachments::normal);
-        g_buff_->blit_to(f_buff_.get(), true, false, false, 0, 0, g_buff_->width(), g_buff_->height(), 0, 0, f_buff_->width(), f_buff_->height());
-
-        // Blit depth-stencil.
-        g_buff_->blit_to(f_buff_.get(), false, true, true, 0, 0, g_buff_->width(), g_buff_->height(), 0, 0, f_buff_->width(), f_buff_->height());
-
-        // Set draw attachments.
-        f_buff_->set_draw_colour_attachment_all();
 
         for (auto& material_iter : forward_meshes_) {
             auto material_ptr = material_iter.first;
@@ -523,14 +1034,7 @@ namespace mkr {
             if (material_ptr->texture_displacement_) { material_ptr->texture_displacement_->bind(texture_unit::texture_displacement); }
 
             // Bind shadow maps.
-            const auto num_lights = maths_util::min<int32_t>(lights_.size(), lighting::max_lights);
-            for (auto i = 0; i < num_lights; ++i) {
-                if (light_mode::point == lights_[i].light_.get_mode()) {
-                    scube_buff_[i]->get_depth_stencil_attachment()->bind(texture_unit::cubemap_shadows0 + i);
-                } else {
-                    s2d_buff_[i]->get_depth_stencil_attachment()->bind(texture_unit::texture_shadows0 + i);
-                }
-            }
+            bind_shadow_maps();
 
             // Transform
             shader->set_uniform(forward_shader::uniform::u_view_matrix, false, _view_matrix);
@@ -552,71 +1056,44 @@ namespace mkr {
             shader->set_uniform(forward_shader::uniform::u_has_texture_displacement, material_ptr->texture_displacement_ != nullptr);
 
             // Lights
-            shader->set_uniform(forward_shader::uniform::u_num_lights, num_lights);
             shader->set_uniform(forward_shader::uniform::u_ambient_light, lighting::ambient_light_);
 
-            for (auto i = 0; i < num_lights; ++i) {
-                const auto& t = lights_[i].transform_;
-                const auto& l = lights_[i].light_;
-
-                const auto light_pos_view = _view_matrix * t.position_; // Light position in view space.
-                const auto light_dir_view = vector3{_view_dir_x.dot(t.forward_), _view_dir_y.dot(t.forward_), _view_dir_z.dot(t.forward_)}.normalised(); // Light direction in view space.
-
-                shader->set_uniform(i + forward_shader::uniform::u_light_mode0, l.get_mode());
-                shader->set_uniform(i + forward_shader::uniform::u_light_power0, l.get_power());
-                shader->set_uniform(i + forward_shader::uniform::u_light_colour0, l.get_colour());
-
-                shader->set_uniform(i + forward_shader::uniform::u_light_attenuation_constant0, l.get_attenuation_constant());
-                shader->set_uniform(i + forward_shader::uniform::u_light_attenuation_linear0, l.get_attenuation_linear());
-                shader->set_uniform(i + forward_shader::uniform::u_light_attenuation_quadratic0, l.get_attenuation_quadratic());
-
-                shader->set_uniform(i + forward_shader::uniform::u_light_spotlight_inner_cosine0, l.get_spotlight_inner_consine());
-                shader->set_uniform(i + forward_shader::uniform::u_light_spotlight_outer_cosine0, l.get_spotlight_outer_consine());
-
-                shader->set_uniform(i + forward_shader::uniform::u_light_position0, light_pos_view);
-                shader->set_uniform(i + forward_shader::uniform::u_light_direction0, light_dir_view);
-
-                shader->set_uniform(i + forward_shader::uniform::u_light_shadow_distance0, l.get_shadow_distance());
-                shader->set_uniform(i + forward_shader::uniform::u_light_view_projection_matrix0, false, light_view_projection_matrix_[i]);
-            }
-
             // Draw to screen.
             for (auto& mesh_iter : material_iter.second) {
                 auto mesh_ptr = mesh_iter.first;
-                auto& model_matrices = mesh_iter.second;
+                auto& instances = mesh_iter.second;
 
-                std::vector<mesh_instance_data> batch;
-                for (auto& model_matrix : model_matrices) {
+                frame_vector<mesh_instance_data> batch;
+                batch.reserve(instances.size());
+                for (auto& instance : instances) {
+                    const auto& model_matrix = instance.model_matrix_;
                     const auto model_view_inverse = matrix_util::inverse_matrix(_view_matrix * model_matrix).value_or(matrix4x4::identity());
                     const auto normal_matrix = matrix_util::minor_matrix(model_view_inverse.transposed(), 3, 3);
                     batch.push_back({model_matrix, normal_matrix});
                 }
 
                 mesh_ptr->bind();
-                mesh_ptr->set_instance_data(batch);
-                glDrawElementsInstanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, model_matrices.size());
+                mesh_ptr->set_instance_data(batch.data(), batch.size());
+                gfx().draw_elements_instanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, instances.size());
+                count_draw(mesh_ptr->num_indices(), instances.size());
             }
         }
     }
 
-    void graphics_renderer::alpha_weight_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z) {
-        glEnable(GL_BLEND);
-        glBlendFunci(alpha_buffer::colour_attachments::accumulation, GL_ONE, GL_ONE); // Accumulation blend target.
-        glBlendFunci(alpha_buffer::colour_attachments::revealage, GL_ZERO, GL_ONE_MINUS_SRC_COLOR); // Revealage blend target.
-        glEnable(GL_DEPTH_TEST); // We want to depth test against opaque objects,
-        glDepthMask(GL_FALSE); // but not transparent objects.
-        glDepthFunc(GL_LESS);
+    void graphics_renderer::alpha_weight_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix) {
+        gfx().enable(GL_BLEND);
+        gfx().blend_funci(alpha_buffer::colour_attachments::accumulation, GL_ONE, GL_ONE); // Accumulation blend target.
+        gfx().blend_funci(alpha_buffer::colour_attachments::revealage, GL_ZERO, GL_ONE_MINUS_SRC_COLOR); // Revealage blend target.
+        gfx().enable(GL_DEPTH_TEST); // We want to depth test against opaque objects,
+        gfx().depth_mask(GL_FALSE); // but not transparent objects.
+        gfx().depth_func(GL_LESS);
 
-        glViewport(0, 0, a_buff_->width(), a_buff_->height());
+        gfx().viewport(0, 0, render_width_, render_height_);
 
         a_buff_->bind();
         a_buff_->set_draw_colour_attachment_all();
         a_buff_->clear_colour(alpha_buffer::colour_attachments::accumulation, colour::black());
-        a_buff_->clear_colour(alpha_buffer::colour_attachments::revealage, colour{1.0f, 0.0f, 0.0f, 0.0f});
-        a_buff_->clear_depth_stencil();
-
-        // Blit depth-stencil.
-        f_buff_->blit_to(a_buff_.get(), false, true, true, 0, 0, f_buff_->width(), f_buff_->height(), 0, 0, a_buff_->width(), a_buff_->height());
+        a_buff_->clear_colour(alpha_buffer::colour_attachments::revealage, colour{1.0f, 0.0f, 0.0f, 0.0f}); // The depth-stencil is shared with the opaque scene, and is not cleared.
 
         for (auto& material_iter : transparent_meshes_) {
             auto material_ptr = material_iter.first;
@@ -630,14 +1107,7 @@ namespace mkr {
             if (material_ptr->texture_displacement_) { material_ptr->texture_displacement_->bind(texture_unit::texture_displacement); }
 
             // Bind shadow maps.
-            const auto num_lights = maths_util::min<int32_t>(lights_.size(), lighting::max_lights);
-            for (auto i = 0; i < num_lights; ++i) {
-                if (light_mode::point == lights_[i].light_.get_mode()) {
-                    scube_buff_[i]->get_depth_stencil_attachment()->bind(texture_unit::cubemap_shadows0 + i);
-                } else {
-                    s2d_buff_[i]->get_depth_stencil_attachment()->bind(texture_unit::texture_shadows0 + i);
-                }
-            }
+            bind_shadow_maps();
 
             // Transform
             shader->set_uniform(alpha_weight_shader::uniform::u_view_matrix, false, _view_matrix);
@@ -659,61 +1129,38 @@ namespace mkr {
             shader->set_uniform(alpha_weight_shader::uniform::u_has_texture_displacement, material_ptr->texture_displacement_ != nullptr);
 
             // Lights
-            shader->set_uniform(alpha_weight_shader::uniform::u_num_lights, num_lights);
             shader->set_uniform(alpha_weight_shader::uniform::u_ambient_light, lighting::ambient_light_);
 
-            for (auto i = 0; i < num_lights; ++i) {
-                const auto& t = lights_[i].transform_;
-                const auto& l = lights_[i].light_;
-
-                const auto light_pos_view = _view_matrix * t.position_; // Light position in view space.
-                const auto light_dir_view = vector3{_view_dir_x.dot(t.forward_), _view_dir_y.dot(t.forward_), _view_dir_z.dot(t.forward_)}.normalised(); // Light direction in view space.
-
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_mode0, l.get_mode());
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_power0, l.get_power());
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_colour0, l.get_colour());
-
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_attenuation_constant0, l.get_attenuation_constant());
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_attenuation_linear0, l.get_attenuation_linear());
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_attenuation_quadratic0, l.get_attenuation_quadratic());
-
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_spotlight_inner_cosine0, l.get_spotlight_inner_consine());
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_spotlight_outer_cosine0, l.get_spotlight_outer_consine());
-
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_position0, light_pos_view);
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_direction0, light_dir_view);
-
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_shadow_distance0, l.get_shadow_distance());
-                shader->set_uniform(i + alpha_weight_shader::uniform::u_light_view_projection_matrix0, false, light_view_projection_matrix_[i]);
-            }
-
             // Draw to screen.
             for (auto& mesh_iter : material_iter.second) {
                 auto mesh_ptr = mesh_iter.first;
-                auto& model_matrices = mesh_iter.second;
+                auto& instances = mesh_iter.second;
 
-                std::vector<mesh_instance_data> batch;
-                for (auto& model_matrix : model_matrices) {
+                frame_vector<mesh_instance_data> batch;
+                batch.reserve(instances.size());
+                for (auto& instance : instances) {
+                    const auto& model_matrix = instance.model_matrix_;
                     const auto model_view_inverse = matrix_util::inverse_matrix(_view_matrix * model_matrix).value_or(matrix4x4::identity());
                     const auto normal_matrix = matrix_util::minor_matrix(model_view_inverse.transposed(), 3, 3);
                     batch.push_back({model_matrix, normal_matrix});
                 }
 
                 mesh_ptr->bind();
-                mesh_ptr->set_instance_data(batch);
-                glDrawElementsInstanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, model_matrices.size());
+                mesh_ptr->set_instance_data(batch.data(), batch.size());
+                gfx().draw_elements_instanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, instances.size());
+                count_draw(mesh_ptr->num_indices(), instances.size());
             }
         }
     }
 
     void graphics_renderer::alpha_blend_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix) {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
+        gfx().enable(GL_BLEND);
+        gfx().blend_func(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_TRUE);
+        gfx().depth_func(GL_LESS);
 
-        glViewport(0, 0, f_buff_->width(), f_buff_->height());
+        gfx().viewport(0, 0, render_width_, render_height_);
 
         f_buff_->bind();
         f_buff_->set_draw_colour_attachment_all();
@@ -734,18 +1181,21 @@ namespace mkr {
             // Draw to screen.
             for (auto& mesh_iter : material_iter.second) {
                 auto mesh_ptr = mesh_iter.first;
-                auto& model_matrices = mesh_iter.second;
+                auto& instances = mesh_iter.second;
 
-                std::vector<mesh_instance_data> batch;
-                for (auto& model_matrix : model_matrices) {
+                frame_vector<mesh_instance_data> batch;
+                batch.reserve(instances.size());
+                for (auto& instance : instances) {
+                    const auto& model_matrix = instance.model_matrix_;
                     const auto model_view_inverse = matrix_util::inverse_matrix(_view_matrix * model_matrix).value_or(matrix4x4::identity());
                     const auto normal_matrix = matrix_util::minor_matrix(model_view_inverse.transposed(), 3, 3);
                     batch.push_back({model_matrix, normal_matrix});
                 }
 
                 mesh_ptr->bind();
-                mesh_ptr->set_instance_data(batch);
-                glDrawElementsInstanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, model_matrices.size());
+                mesh_ptr->set_instance_data(batch.data(), batch.size());
+                gfx().draw_elements_instanced(GL_TRIANGLES, mesh_ptr->num_indices(), GL_UNSIGNED_INT, 0, instances.size());
+                count_draw(mesh_ptr->num_indices(), instances.size());
             }
         }
     }
@@ -753,11 +1203,11 @@ namespace mkr {
     void graphics_renderer::skybox_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const skybox* _skybox) {
         if (!_skybox || !_skybox->shader_) { return; }
 
-        glDisable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_FALSE); // Do not write to the depth buffer.
-        glDepthFunc(GL_LEQUAL); // We'll set our depth to 1 in the fragment shader.
-        glViewport(0, 0, f_buff_->width(), f_buff_->height());
+        gfx().disable(GL_BLEND);
+        gfx().enable(GL_DEPTH_TEST);
+        gfx().depth_mask(GL_FALSE); // Do not write to the depth buffer.
+        gfx().depth_func(GL_LEQUAL); // We'll set our depth to 1 in the fragment shader.
+        gfx().viewport(0, 0, render_width_, render_height_);
 
         /* Even though the skybox shader only writes to one colour attachment, we have to disable writing to the other colour attachments, otherwise they will have some undefined values written to them.
            As long as a colour attachment to set to be drawn to it, some value will be written to it no matter what, even if the shader does not specify.
@@ -777,32 +1227,43 @@ namespace mkr {
         shader->set_uniform(skybox_shader::uniform::u_texture_skybox_enabled, _skybox->texture_ != nullptr);
 
         skybox_cube_->bind();
-        skybox_cube_->set_instance_data({{matrix4x4::identity(), matrix3x3::identity()}});
-        glDrawElementsInstanced(GL_TRIANGLES, skybox_cube_->num_indices(), GL_UNSIGNED_INT, 0, 1);
+        const mesh_instance_data skybox_instance{matrix4x4::identity(), matrix3x3::identity()};
+        skybox_cube_->set_instance_data(&skybox_instance, 1);
+        gfx().draw_elements_instanced(GL_TRIANGLES, skybox_cube_->num_indices(), GL_UNSIGNED_INT, 0, 1);
+        count_draw(skybox_cube_->num_indices(), 1);
     }
 
     void graphics_renderer::submit_camera(const local_to_world& _transform, const camera& _camera) {
         cameras_.push({_transform, _camera});
     }
 
-    void graphics_renderer::submit_light(const local_to_world& _transform, const light& _light) {
-        lights_.push_back({_transform, _light});
+    void graphics_renderer::submit_light(uint64_t _id, const local_to_world& _transform, const light& _light) {
+        if (lights_.capacity() == 0) { lights_.reserve(prev_num_lights_); }
+        lights_.push_back({_id, _transform, _light});
     }
 
-    void graphics_renderer::submit_mesh(const local_to_world& _transform, const render_mesh& _render_mesh) {
+    void graphics_renderer::submit_mesh(const local_to_world& _transform, const render_mesh& _render_mesh, bool _is_static) {
         if (_render_mesh.material_ == nullptr || _render_mesh.mesh_ == nullptr) { return; }
         switch (_render_mesh.material_->render_path_) {
             case render_path::deferred:
-                deferred_meshes_[_render_mesh.material_][_render_mesh.mesh_].push_back(_transform.transform_);
+                deferred_meshes_[_render_mesh.material_][_render_mesh.mesh_].push_back({_transform.transform_, _is_static});
                 break;
             case render_path::forward:
-                forward_meshes_[_render_mesh.material_][_render_mesh.mesh_].push_back(_transform.transform_);
+                forward_meshes_[_render_mesh.material_][_render_mesh.mesh_].push_back({_transform.transform_, _is_static});
                 break;
             case render_path::transparent:
-                transparent_meshes_[_render_mesh.material_][_render_mesh.mesh_].push_back(_transform.transform_);
+                transparent_meshes_[_render_mesh.material_][_render_mesh.mesh_].push_back({_transform.transform_, _is_static});
                 break;
             default:
-                break;
+                return;
+        }
+
+        // Static casters never move, so the static layer only goes out of date when different static meshes are submitted.
+        // Keys are summed, as the order of submission is not guaranteed to be the same every frame.
+        if (_is_static) {
+            static_caster_key_ += mix_key(mix_key(reinterpret_cast<uintptr_t>(_render_mesh.material_)) ^ reinterpret_cast<uintptr_t>(_render_mesh.mesh_));
+        } else {
+            ++num_dynamic_casters_;
         }
     }
 } // mkr
\ No newline at end of file
@@ -1,20 +1,28 @@
 #pragma once
 
 #include <functional>
+#include <initializer_list>
+#include <optional>
 #include <queue>
 #include <flecs.h>
 #include <common/singleton.h>
 #include <maths/matrix_util.h>
 #include "graphics/renderer/stencil.h"
+#include "graphics/renderer/gpu_timer.h"
+#include "graphics/renderer/resolution_controller.h"
+#include "graphics/renderer/render_stats.h"
 #include "graphics/app_window.h"
-#include "graphics/framebuffer/shadow_2d_buffer.h"
-#include "graphics/framebuffer/shadow_cubemap_buffer.h"
+#include "graphics/device/null_device.h"
 #include "graphics/framebuffer/geometry_buffer.h"
 #include "graphics/framebuffer/lighting_buffer.h"
 #include "graphics/framebuffer/forward_buffer.h"
 #include "graphics/framebuffer/alpha_buffer.h"
 #include "graphics/framebuffer/post_buffer.h"
 #include "graphics/lighting/lighting.h"
+#include "graphics/lighting/light_clusters.h"
+#include "graphics/lighting/light_ranking.h"
+#include "graphics/shadow/shadow_cascades.h"
+#include "graphics/shadow/shadow_atlas.h"
 #include "graphics/material/material.h"
 #include "graphics/mesh/mesh_instance_data.h"
 #include "component/render_mesh.h"
@@ -22,8 +30,17 @@
 #include "component/local_to_world.h"
 #include "component/camera.h"
 #include "component/light.h"
+#include "memory/frame_allocator.h"
 
 namespace mkr {
+    /// How the deferred lighting pass evaluates point and spot lights.
+    enum deferred_lighting_mode {
+        /// One full screen pass, where every pixel evaluates the lights in its cluster.
+        clustered = 0,
+        /// One proxy mesh per light, a sphere for point lights and a cone for spot lights, so that only the pixels inside the light's volume are shaded.
+        light_volumes,
+    };
+
     class graphics_renderer : public singleton<graphics_renderer> {
         friend class singleton<graphics_renderer>;
 
@@ -35,19 +52,91 @@ namespace mkr {
         };
 
         struct light_data {
+            /// Identifies the light between frames.
+            uint64_t id_;
             local_to_world transform_;
             light light_;
+            /// The index of the light's shadow map, or -1 if it has none.
+            int32_t shadow_index_ = -1;
+        };
+
+        struct mesh_instance {
+            matrix4x4 model_matrix_;
+            /// Static instances never move, so they can be cached in their own shadow map layer.
+            bool is_static_;
+        };
+
+        /// Per-frame submissions live in the frame arena, and are released at the end of every frame.
+        using mesh_map = frame_unordered_map<material*, frame_unordered_map<mesh*, frame_vector<mesh_instance>>>;
+
+        /// Which of the submitted meshes to draw into a shadow map. Every submitted mesh casts shadows.
+        enum class caster_set : uint8_t {
+            all,
+            static_only,
+            dynamic_only,
+        };
+
+        /// The world space bounding sphere of a dynamic shadow caster.
+        struct caster_bounds {
+            vector3 centre_;
+            float radius_;
+            const mesh* mesh_;
+            /// Points into the mesh maps, which do not change once rendering has started.
+            const matrix4x4* model_matrix_;
+        };
+
+        /**
+         * The state a shadow map was last rendered with.
+         * A shadow map is only re-rendered when its light, the static casters, or the dynamic casters within the light's range have changed.
+         */
+        struct shadow_cache {
+            /// The shadow map is up to date with the state below.
+            bool valid_ = false;
+            /// The static layer is up to date. Only used when the static and dynamic casters are split.
+            bool static_valid_ = false;
+            light_mode mode_ = light_mode::point;
+            vector3 position_, forward_, up_;
+            float shadow_distance_ = 0.0f;
+            float spotlight_outer_angle_ = 0.0f;
+            uint64_t static_key_ = 0;
+            uint64_t dynamic_key_ = 0;
+
+            [[nodiscard]] bool light_matches(const local_to_world& _transform, const light& _light) const;
+            void set_light(const local_to_world& _transform, const light& _light);
+        };
+
+        /// The part of the shadow atlas given to a shadow map. Spot and directional lights get a tile, point lights get a cubemap layer.
+        struct shadow_allocation {
+            light_mode mode_ = light_mode::point;
+            std::optional<shadow_tile> tile_;
+            std::optional<uint32_t> layer_;
+            /// The tile size the light asked for, which can be larger than the tile it was given when the atlas is full.
+            uint32_t requested_size_ = 0;
+
+            [[nodiscard]] inline bool empty() const { return !tile_ && !layer_; }
+        };
+
+        /// The cascades of a directional light's shadow map, as last rendered. Lets far cascades be kept for a few frames.
+        struct cascade_cache {
+            bool valid_[lighting::max_cascades] = {};
+            vector3 forward_, up_;
+            uint32_t num_cascades_ = 0;
+            float split_distances_[lighting::max_cascades] = {};
+            matrix4x4 view_projection_matrices_[lighting::max_cascades];
         };
 
         // App Window
         std::unique_ptr<app_window> app_window_;
         uint32_t window_width_ = 1920;
         uint32_t window_height_ = 1080;
+        /// Rendering without a display, selected on the command line with --headless.
+        bool headless_ = false;
+        /// Set when graphics calls are recorded by the null device rather than made.
+        null_device* null_device_ = nullptr;
+        /// Without a display, the final image is presented to this instead of the default framebuffer.
+        std::unique_ptr<post_buffer> present_buff_;
 
         // Framebuffers
-        std::unique_ptr<shadow_2d_buffer> s2d_buff_[lighting::max_lights];
-        std::unique_ptr<shadow_cubemap_buffer> scube_buff_[lighting::max_lights];
-
         std::unique_ptr<geometry_buffer> g_buff_;
         std::unique_ptr<lighting_buffer> l_buff_;
 
@@ -55,36 +144,125 @@ namespace mkr {
 
         std::unique_ptr<alpha_buffer> a_buff_;
 
-        matrix4x4 light_view_projection_matrix_[lighting::max_lights];
+        // Shadow Atlas
+        std::unique_ptr<shadow_atlas> shadow_atlas_;
+        shadow_allocation shadow_allocations_[lighting::max_shadow_maps];
+        /// Scales the size of every shadow map tile.
+        float shadow_quality_ = 1.0f;
+        gpu_shadow shadow_data_[lighting::max_shadow_maps];
+        std::unique_ptr<ssbo> shadow_buffer_;
+        matrix4x4 light_view_projection_matrix_[lighting::max_shadow_maps];
+
+        // Shadow Caching
+        shadow_cache shadow_caches_[lighting::max_shadow_maps];
+        /// When enabled, static casters are rendered into a cache layer, which is copied into the shadow map before the dynamic casters are drawn on top.
+        bool split_shadow_cache_ = false;
+
+        // Shadow Cascades
+        cascade_cache cascade_caches_[lighting::max_shadow_maps];
+        /// Cascades after the first two are re-rendered once every this many frames.
+        uint32_t far_cascade_update_interval_ = 1;
+        uint64_t frame_count_ = 0;
+
+        // Light Culling
+        std::unique_ptr<light_clusters> light_clusters_;
 
         // Screen Meshes
         std::unique_ptr<mesh> screen_quad_;
         std::unique_ptr<mesh> skybox_cube_;
 
+        // Light Volumes
+        deferred_lighting_mode lighting_mode_ = deferred_lighting_mode::clustered;
+        std::unique_ptr<mesh> light_sphere_;
+        std::unique_ptr<mesh> light_cone_;
+
+        // Dynamic Resolution
+        std::unique_ptr<gpu_timer> gpu_timer_;
+        resolution_controller resolution_controller_;
+        /// The scale that every frame still being timed was rendered at, indexed by frame number.
+        float frame_scales_[gpu_timer::max_frames_in_flight] = {};
+        uint64_t next_timed_frame_ = 0;
+        uint32_t render_width_ = 1;
+        uint32_t render_height_ = 1;
+        render_stats stats_;
+
         // Camera
-        std::priority_queue<camera_data> cameras_;
+        std::priority_queue<camera_data, frame_vector<camera_data>> cameras_;
 
         // Lights
-        std::vector<light_data> lights_;
+        frame_vector<light_data> lights_;
+        /// The number of lights submitted last frame, to reserve room for this frame's lights.
+        size_t prev_num_lights_ = 0;
+        light_ranking light_ranking_;
 
         // Meshes
-        std::unordered_map<material*, std::unordered_map<mesh*, std::vector<matrix4x4>>> deferred_meshes_;
-        std::unordered_map<material*, std::unordered_map<mesh*, std::vector<matrix4x4>>> forward_meshes_;
-        std::unordered_map<material*, std::unordered_map<mesh*, std::vector<matrix4x4>>> transparent_meshes_;
+        mesh_map deferred_meshes_;
+        mesh_map forward_meshes_;
+        mesh_map transparent_meshes_;
+
+        // Shadow Casters
+        /// Identifies the static meshes submitted this frame, so that the static shadow layers are only redrawn when they change.
+        uint64_t static_caster_key_ = 0;
+        size_t num_dynamic_casters_ = 0;
+        /// Only gathered once a shadow map is updated, as nothing else needs them.
+        frame_vector<caster_bounds> dynamic_caster_bounds_;
 
         graphics_renderer() {}
         virtual ~graphics_renderer() {}
 
         void render();
+        /// Feed the latest GPU timings to the resolution controller, and size this frame's render region.
+        void update_resolution_scale();
+        /// Score the lights against every camera, drop the lights that are not shaded this frame, and give shadow map indices to the most important shadow casting lights.
+        void rank_lights();
+        /// Count a draw call in this frame's statistics.
+        inline void count_draw(size_t _num_indices, size_t _num_instances) {
+            ++stats_.num_draw_calls_;
+            stats_.num_instances_ += _num_instances;
+            stats_.num_triangles_ += (_num_indices / 3) * _num_instances;
+        }
+
+        /**
+         * Get the size of the atlas tile that a light's shadow map needs.
+         * Directional lights cover the whole view. Spot lights are sized by how much of the screen their shadowed area covers, so that distant lights get smaller tiles.
+         * @param _light_data The light.
+         * @param _camera The camera the light is seen from, or nullptr if there is none.
+         * @return The tile size in texels.
+         */
+        [[nodiscard]] uint32_t shadow_tile_size(const light_data& _light_data, const camera_data* _camera) const;
+        /// Give every shadow casting light a shadow map from the atlas, and return the shadow maps of lights that no longer need them.
+        void allocate_shadow_maps();
+        void free_shadow_map(int32_t _index);
+
+        /// Find the bounds of every dynamic mesh submitted this frame.
+        void gather_dynamic_casters();
+        [[nodiscard]] uint64_t dynamic_caster_key(const local_to_world& _trans, const light& _light) const;
+        void update_shadow_map(int32_t _index, const light_data& _light_data, uint64_t _static_key);
+        template<typename Shader>
+        void draw_shadow_casters(shader_program* _shader, caster_set _casters);
+        template<typename Shader, typename Visible>
+        void draw_shadow_casters(shader_program* _shader, caster_set _casters, const Visible& _visible);
+
+        matrix4x4 point_shadow(shadow_cubemap_array_buffer* _buffer, uint32_t _layer, const local_to_world& _trans, const light& _light, caster_set _casters, bool _clear = true);
+        matrix4x4 spot_shadow(shadow_atlas_buffer* _buffer, const shadow_tile& _tile, const local_to_world& _trans, const light& _light, caster_set _casters, bool _clear = true);
+        /**
+         * Render the cascades of a directional light's shadow map for a camera. Each cascade is rendered into its own quarter of the light's atlas tile.
+         * @param _index The index of the light's shadow map.
+         * @param _light_data The light.
+         * @param _cam_trans The camera's transform.
+         * @param _cam The camera.
+         * @param _reuse_far_cascades Whether far cascades rendered in an earlier frame may be kept. Only valid when there is a single camera.
+         */
+        void directional_shadow(int32_t _index, const light_data& _light_data, const local_to_world& _cam_trans, const camera& _cam, bool _reuse_far_cascades);
 
-        matrix4x4 point_shadow(shadow_cubemap_buffer* _buffer, const local_to_world& _trans, const light& _light);
-        matrix4x4 spot_shadow(shadow_2d_buffer* _buffer, const local_to_world& _trans, const light& _light);
-        matrix4x4 directional_shadow(shadow_2d_buffer* _buffer, const local_to_world& _light_trans, const light& _light, const local_to_world& _cam_trans, const camera& _cam);
+        void build_light_clusters(const matrix4x4& _view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z, const camera& _camera);
+        void bind_shadow_maps();
 
         void geometry_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix);
-        void lighting_pass(const matrix4x4& _view_matrix, const matrix4x4& _inv_view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z);
-        void forward_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z);
-        void alpha_weight_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix, const vector3& _view_dir_x, const vector3& _view_dir_y, const vector3& _view_dir_z);
+        void lighting_pass(const matrix4x4& _inv_view_matrix, const matrix4x4& _inv_projection_matrix);
+        void light_volume_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix, const matrix4x4& _inv_projection_matrix, const camera& _camera);
+        void forward_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix);
+        void alpha_weight_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const matrix4x4& _inv_view_matrix);
         void alpha_blend_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix);
         void skybox_pass(const matrix4x4& _view_matrix, const matrix4x4& _projection_matrix, const skybox* _skybox);
 
@@ -95,7 +273,50 @@ namespace mkr {
         void exit();
 
         void submit_camera(const local_to_world& _transform, const camera& _camera);
-        void submit_light(const local_to_world& _transform, const light& _light);
-        void submit_mesh(const local_to_world& _transform, const render_mesh& _render_mesh);
+        /**
+         * Submit a light to be rendered this frame.
+         * @param _id Identifies the light between frames, so that its ranking and shadow map are kept.
+         * @param _transform The world transform of the light.
+         * @param _light The light.
+         */
+        void submit_light(uint64_t _id, const local_to_world& _transform, const light& _light);
+        /**
+         * Submit a mesh to be rendered this frame.
+         * @param _transform The world transform of the mesh.
+         * @param _render_mesh The mesh and its material.
+         * @param _is_static Whether the mesh never moves. Shadow maps are only re-rendered when a dynamic mesh within range changes.
+         */
+        void submit_mesh(const local_to_world& _transform, const render_mesh& _render_mesh, bool _is_static = false);
+
+        /// Drop everything submitted this frame without rendering it. Must be called before the frame arena is reset.
+        void discard_frame();
+
+        [[nodiscard]] inline bool split_shadow_cache() const { return split_shadow_cache_; }
+        /// Keep a separate cache of the static shadow casters for every shadow map. Saves redrawing static casters when only dynamic casters move, at the cost of twice the shadow map memory.
+        inline void set_split_shadow_cache(bool _split) { split_shadow_cache_ = _split; }
+
+        [[nodiscard]] inline deferred_lighting_mode lighting_mode() const { return lighting_mode_; }
+        inline void set_lighting_mode(deferred_lighting_mode _mode) {
+            lighting_mode_ = _mode;
+            if (l_buff_) { l_buff_->set_depth_stencil(_mode == deferred_lighting_mode::light_volumes); }
+        }
+
+        [[nodiscard]] inline uint32_t far_cascade_update_interval() const { return far_cascade_update_interval_; }
+        /// Re-render the far shadow cascades of directional lights once every _interval frames. Far cascades cover a large area at a low resolution, so changes in them are hard to see.
+        inline void set_far_cascade_update_interval(uint32_t _interval) { far_cascade_update_interval_ = maths_util::max<uint32_t>(_interval, 1); }
+
+        /// The statistics of the last frame rendered.
+        [[nodiscard]] inline const render_stats& stats() const { return stats_; }
+
+        /// Controls the scale that frames are rendered at, and the GPU frame time it aims for.
+        [[nodiscard]] inline resolution_controller& dynamic_resolution() { return resolution_controller_; }
+
+        [[nodiscard]] inline uint32_t max_shaded_lights() const { return light_ranking_.max_shaded_lights(); }
+        /// The most point and spot lights shaded each frame. When there are more, the ones that matter least to the cameras are dropped.
+        inline void set_max_shaded_lights(uint32_t _max) { light_ranking_.set_max_shaded_lights(_max); }
+
+        [[nodiscard]] inline float shadow_quality() const { return shadow_quality_; }
+        /// Scale the size of the shadow map tiles. Tiles are a power of two in size, so the scale is rounded down to the nearest power of two tile.
+        inline void set_shadow_quality(float _quality) { shadow_quality_ = maths_util::max<float>(_quality, 0.0f); }
     };
 } // mkr
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mkr {
+    /// The groups of render passes that are timed on the GPU.
+    enum class gpu_pass : uint32_t {
+        shadows = 0,
+        geometry,
+        lighting,
+        forward,
+        transparent,
+        present,
+
+        num_gpu_passes,
+    };
+
+    constexpr size_t num_gpu_passes = static_cast<size_t>(gpu_pass::num_gpu_passes);
+
+    /// Per frame rendering statistics, for telemetry.
+    struct render_stats {
+        /// The frame that the statistics below were last updated on.
+        uint64_t frame_ = 0;
+
+        /// The fraction of the render targets' width and height that was rendered to this frame.
+        float resolution_scale_ = 1.0f;
+        uint32_t render_width_ = 0;
+        uint32_t render_height_ = 0;
+
+        /// The draw calls made this frame, and the instances and triangles that they drew.
+        uint32_t num_draw_calls_ = 0;
+        uint64_t num_instances_ = 0;
+        uint64_t num_triangles_ = 0;
+
+        /// GPU timings are read back a few frames late, so that reading them never stalls. They belong to this frame.
+        uint64_t gpu_frame_ = 0;
+        float gpu_time_ms_ = 0.0f;
+        float gpu_pass_times_ms_[num_gpu_passes] = {};
+    };
+} // mkr
\ No newline at end of file
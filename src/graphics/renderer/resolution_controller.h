@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cmath>
+#include <maths/maths_util.h>
+
+namespace mkr {
+    /**
+     * Chooses the resolution scale to render at, so that the GPU time of a frame stays under a target.
+     * The GPU time of most passes grows with the number of pixels, which is the square of the scale.
+     * The scale drops quickly when a frame is over the target, to avoid missed frames, and recovers slowly once there is headroom, so that it does not oscillate.
+     */
+    class resolution_controller {
+    private:
+        bool enabled_ = false;
+        float target_frame_time_ms_ = 1000.0f / 60.0f;
+        float min_scale_ = 0.5f;
+        float max_scale_ = 1.0f;
+        float scale_ = 1.0f;
+
+        /// Only scale up while the GPU time is below this fraction of the target.
+        static constexpr float headroom_ = 0.85f;
+        static constexpr float down_rate_ = 0.5f;
+        static constexpr float up_rate_ = 0.05f;
+        /// Scales are rounded to this step, so that tiny changes do not move every edge in the frame.
+        static constexpr float step_ = 1.0f / 64.0f;
+
+    public:
+        /**
+         * Update the scale from the timings of a finished frame.
+         * @param _gpu_time_ms The GPU time of the frame.
+         * @param _frame_scale The scale that the frame was rendered at. Timings arrive a few frames late, so this may differ from the current scale.
+         * @return The scale to render the next frame at.
+         */
+        float update(float _gpu_time_ms, float _frame_scale) {
+            if (!enabled_ || _gpu_time_ms <= 0.0f) { return scale_; }
+
+            const float ideal_scale = _frame_scale * std::sqrt(target_frame_time_ms_ / _gpu_time_ms);
+            if (_gpu_time_ms > target_frame_time_ms_) {
+                scale_ = maths_util::min<float>(scale_, scale_ + (ideal_scale - scale_) * down_rate_);
+            } else if (_gpu_time_ms < target_frame_time_ms_ * headroom_) {
+                scale_ = maths_util::max<float>(scale_, scale_ + (ideal_scale - scale_) * up_rate_);
+            }
+            scale_ = maths_util::clamp<float>(std::round(scale_ / step_) * step_, min_scale_, max_scale_);
+            return scale_;
+        }
+
+        [[nodiscard]] inline bool enabled() const { return enabled_; }
+        inline void set_enabled(bool _enabled) { enabled_ = _enabled; }
+
+        [[nodiscard]] inline float scale() const { return scale_; }
+        /// Set the scale directly. While the controller is enabled, it carries on from this scale.
+        inline void set_scale(float _scale) { scale_ = maths_util::clamp<float>(_scale, min_scale_, max_scale_); }
+
+        [[nodiscard]] inline float target_frame_time_ms() const { return target_frame_time_ms_; }
+        inline void set_target_frame_time_ms(float _ms) { target_frame_time_ms_ = maths_util::max<float>(_ms, 1.0f); }
+
+        [[nodiscard]] inline float min_scale() const { return min_scale_; }
+        /// The smallest scale the controller may choose. The largest is 1, as the render targets are allocated at the window size.
+        inline void set_min_scale(float _scale) {
+            min_scale_ = maths_util::clamp<float>(_scale, step_, max_scale_);
+            scale_ = maths_util::max<float>(scale_, min_scale_);
+        }
+    };
+} // mkr
\ No newline at end of file
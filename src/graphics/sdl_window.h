@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include "graphics/app_window.h"
+
+namespace mkr {
+    class sdl_window : public app_window {
+    private:
+        SDL_Window* window_;
+        SDL_GLContext gl_context_;
+
+    public:
+        sdl_window(const std::string& _title, uint32_t _width, uint32_t _height, uint32_t _flags)
+                : app_window(_title, _width, _height, _flags) {
+            // Create window.
+            window_ = SDL_CreateWindow(title_.c_str(),
+                                       SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                       static_cast<int>(width_), static_cast<int>(height_),
+                                       SDL_WINDOW_OPENGL /* | SDL_WINDOW_INPUT_GRABBED */);
+            SDL_SetWindowFullscreen(window_, is_fullscreen() ? SDL_TRUE : SDL_FALSE);
+            SDL_SetWindowBordered(window_, is_borderless() ? SDL_FALSE : SDL_TRUE);
+
+            // Query actual window size.
+            int actual_width, actual_height;
+            SDL_GetWindowSize(window_, &actual_width, &actual_height);
+            width_ = static_cast<uint32_t>(actual_width);
+            height_ = static_cast<uint32_t>(actual_height);
+
+            // Create OpenGL context.
+            gl_context_ = SDL_GL_CreateContext(window_);
+        }
+
+        virtual ~sdl_window() {
+            SDL_DestroyWindow(window_);
+            SDL_GL_DeleteContext(gl_context_);
+        }
+
+        [[nodiscard]] bool has_default_framebuffer() const override { return true; }
+
+        inline void swap_buffers() override { SDL_GL_SwapWindow(window_); }
+    };
+}
\ No newline at end of file
@@ -28,28 +28,11 @@ namespace mkr {
         uniform_handles_[uniform::u_texture_displacement] = get_uniform_location("u_texture_displacement");
 
         // Shadows
-        for (auto i = 0; i < lighting::max_lights; ++i) {
-            uniform_handles_[i + uniform::u_texture_shadows0] = get_uniform_location("u_texture_shadows[" + std::to_string(i) + "]");
-            uniform_handles_[i + uniform::u_cubemap_shadows0] = get_uniform_location("u_cubemap_shadows[" + std::to_string(i) + "]");
-        }
+        uniform_handles_[uniform::u_shadow_atlas] = get_uniform_location("u_shadow_atlas");
+        uniform_handles_[uniform::u_shadow_cubemaps] = get_uniform_location("u_shadow_cubemaps");
 
         // Lights
         uniform_handles_[uniform::u_ambient_light] = get_uniform_location("u_ambient_light");
-        uniform_handles_[uniform::u_num_lights] = get_uniform_location("u_num_lights");
-        for (auto i = 0; i < lighting::max_lights; ++i) {
-            uniform_handles_[i + uniform::u_light_mode0] = get_uniform_location("u_lights[" + std::to_string(i) + "].mode_");
-            uniform_handles_[i + uniform::u_light_power0] = get_uniform_location("u_lights[" + std::to_string(i) + "].power_");
-            uniform_handles_[i + uniform::u_light_colour0] = get_uniform_location("u_lights[" + std::to_string(i) + "].colour_");
-            uniform_handles_[i + uniform::u_light_attenuation_constant0] = get_uniform_location("u_lights[" + std::to_string(i) + "].attenuation_constant_");
-            uniform_handles_[i + uniform::u_light_attenuation_linear0] = get_uniform_location("u_lights[" + std::to_string(i) + "].attenuation_linear_");
-            uniform_handles_[i + uniform::u_light_attenuation_quadratic0] = get_uniform_location("u_lights[" + std::to_string(i) + "].attenuation_quadratic_");
-            uniform_handles_[i + uniform::u_light_spotlight_inner_cosine0] = get_uniform_location("u_lights[" + std::to_string(i) + "].spotlight_inner_cosine_");
-            uniform_handles_[i + uniform::u_light_spotlight_outer_cosine0] = get_uniform_location("u_lights[" + std::to_string(i) + "].spotlight_outer_cosine_");
-            uniform_handles_[i + uniform::u_light_position0] = get_uniform_location("u_lights[" + std::to_string(i) + "].position_");
-            uniform_handles_[i + uniform::u_light_direction0] = get_uniform_location("u_lights[" + std::to_string(i) + "].direction_");
-            uniform_handles_[i + uniform::u_light_shadow_distance0] = get_uniform_location("u_lights[" + std::to_string(i) + "].shadow_distance_");
-            uniform_handles_[i + uniform::u_light_view_projection_matrix0] = get_uniform_location("u_lights[" + std::to_string(i) + "].view_projection_matrix_");
-        }
     }
 
     void forward_shader::assign_textures() {
@@ -58,9 +41,7 @@ namespace mkr {
         set_uniform(uniform::u_texture_normal, (int32_t) texture_unit::texture_normal);
         set_uniform(uniform::u_texture_displacement, (int32_t) texture_unit::texture_displacement);
 
-        for (auto i = 0; i < lighting::max_lights; ++i) {
-            set_uniform(i + uniform::u_texture_shadows0, (int32_t) (i + texture_unit::texture_shadows0));
-            set_uniform(i + uniform::u_cubemap_shadows0, (int32_t) (i + texture_unit::cubemap_shadows0));
-        }
+        set_uniform(uniform::u_shadow_atlas, (int32_t) texture_unit::texture_shadow_atlas);
+        set_uniform(uniform::u_shadow_cubemaps, (int32_t) texture_unit::texture_shadow_cubemaps);
     }
 }
\ No newline at end of file
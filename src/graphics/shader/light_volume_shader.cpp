@@ -0,0 +1,42 @@
+#include "graphics/shader/light_volume_shader.h"
+#include "graphics/shader/texture_unit.h"
+
+namespace mkr {
+    light_volume_shader::light_volume_shader(const std::string& _name, const std::vector<std::string>& _vs_sources, const std::vector<std::string>& _fs_sources)
+        : shader_program(_name, _vs_sources, _fs_sources, uniform::num_shader_uniforms) {
+        assign_uniforms();
+        assign_textures();
+    }
+
+    void light_volume_shader::assign_uniforms() {
+        // Transform
+        uniform_handles_[uniform::u_view_matrix] = get_uniform_location("u_view_matrix");
+        uniform_handles_[uniform::u_projection_matrix] = get_uniform_location("u_projection_matrix");
+        uniform_handles_[uniform::u_inv_view_matrix] = get_uniform_location("u_inv_view_matrix");
+        uniform_handles_[uniform::u_inv_projection_matrix] = get_uniform_location("u_inv_projection_matrix");
+        uniform_handles_[uniform::u_viewport_size] = get_uniform_location("u_viewport_size");
+
+        // Textures
+        uniform_handles_[uniform::u_texture_depth] = get_uniform_location("u_texture_depth");
+        uniform_handles_[uniform::u_texture_normal] = get_uniform_location("u_texture_normal");
+        uniform_handles_[uniform::u_texture_diffuse] = get_uniform_location("u_texture_diffuse");
+        uniform_handles_[uniform::u_texture_specular] = get_uniform_location("u_texture_specular");
+
+        // Shadows
+        uniform_handles_[uniform::u_shadow_atlas] = get_uniform_location("u_shadow_atlas");
+        uniform_handles_[uniform::u_shadow_cubemaps] = get_uniform_location("u_shadow_cubemaps");
+
+        // Lights
+        uniform_handles_[uniform::u_light_index] = get_uniform_location("u_light_index");
+    }
+
+    void light_volume_shader::assign_textures() {
+        set_uniform(uniform::u_texture_depth, (int32_t) texture_unit::texture_depth);
+        set_uniform(uniform::u_texture_normal, (int32_t) texture_unit::texture_normal);
+        set_uniform(uniform::u_texture_diffuse, (int32_t) texture_unit::texture_diffuse);
+        set_uniform(uniform::u_texture_specular, (int32_t) texture_unit::texture_specular);
+
+        set_uniform(uniform::u_shadow_atlas, (int32_t) texture_unit::texture_shadow_atlas);
+        set_uniform(uniform::u_shadow_cubemaps, (int32_t) texture_unit::texture_shadow_cubemaps);
+    }
+} // mkr
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "graphics/shader/shader_program.h"
+
+namespace mkr {
+    class light_volume_shader : public shader_program {
+    public:
+        enum uniform : uint32_t {
+            // Transform
+            u_view_matrix,
+            u_projection_matrix,
+            u_inv_view_matrix,
+            u_inv_projection_matrix,
+            u_viewport_size, // The size of the rendered region of the render targets, in pixels.
+
+            // Textures
+            u_texture_depth,
+            u_texture_normal,
+            u_texture_diffuse,
+            u_texture_specular,
+
+            // Shadows
+            u_shadow_atlas,
+            u_shadow_cubemaps,
+
+            // Lights
+            // The lights themselves are read from the light cluster storage buffers, see light_clusters.
+            u_light_index,
+
+            num_shader_uniforms,
+        };
+
+    protected:
+        /**
+         * Assign uniforms to uniform_handles_.
+         */
+        void assign_uniforms();
+
+        /**
+         * Assign textures to GL_TEXTURE0 to GL_TEXTUREN.
+         */
+        void assign_textures();
+
+    public:
+        light_volume_shader(const std::string& _name, const std::vector<std::string>& _vs_sources, const std::vector<std::string>& _fs_sources);
+
+        virtual ~light_volume_shader() {}
+    };
+} // mkr
\ No newline at end of file
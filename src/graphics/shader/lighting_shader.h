@@ -1,7 +1,6 @@
 #pragma once
 
 #include "graphics/shader/shader_program.h"
-#include "graphics/lighting/lighting.h"
 
 namespace mkr {
     class lighting_shader : public shader_program {
@@ -9,34 +8,25 @@ namespace mkr {
         enum uniform : uint32_t {
             // Transform
             u_inv_view_matrix,
+            u_inv_projection_matrix,
+            u_viewport_size, // The size of the rendered region of the render targets, in pixels.
 
             // Textures
-            u_texture_position,
+            u_texture_depth,
             u_texture_normal,
             u_texture_diffuse,
             u_texture_specular,
 
             // Shadows
-            u_texture_shadows0,
-            u_cubemap_shadows0 = lighting::max_lights + u_texture_shadows0,
+            u_shadow_atlas,
+            u_shadow_cubemaps,
 
             // Lights
-            u_num_lights = lighting::max_lights + u_cubemap_shadows0,
+            // The lights themselves are read from the light cluster storage buffers, see light_clusters.
             u_ambient_light,
-            u_light_mode0, // Light Mode 0 to N
-            u_light_power0 = lighting::max_lights + u_light_mode0, // Light Power 0 to N
-            u_light_colour0 = lighting::max_lights + u_light_power0, // Light Colour 0 to N
-            u_light_attenuation_constant0 = lighting::max_lights + u_light_colour0, // Light Attenuation Constant 0 to N
-            u_light_attenuation_linear0 = lighting::max_lights + u_light_attenuation_constant0, // Light Attenuation Linear 0 to N
-            u_light_attenuation_quadratic0 = lighting::max_lights + u_light_attenuation_linear0, // Light Attenuation Quadratic 0 to N
-            u_light_spotlight_inner_cosine0 = lighting::max_lights + u_light_attenuation_quadratic0, // Spotlight Inner Cosine 0 to N
-            u_light_spotlight_outer_cosine0 = lighting::max_lights + u_light_spotlight_inner_cosine0, // Spotlight Outer Cosine 0 to N
-            u_light_position0 = lighting::max_lights + u_light_spotlight_outer_cosine0, // Light Position Camera Space 0 to N
-            u_light_direction0 = lighting::max_lights + u_light_position0, // Light Direction Camera Space 0 to N
-            u_light_shadow_distance0 = lighting::max_lights + u_light_direction0, // Light's shadow casting distance.
-            u_light_view_projection_matrix0 = lighting::max_lights + u_light_shadow_distance0, // Spotlight/Directional Light View Projection Matrix
-
-            num_shader_uniforms = lighting::max_lights + u_light_view_projection_matrix0,
+            u_directional_only,
+
+            num_shader_uniforms,
         };
 
     protected:
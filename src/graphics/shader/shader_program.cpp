@@ -1,24 +1,25 @@
 #include <log/log.h>
 #include "graphics/shader/shader_program.h"
+#include "graphics/device/graphics_device.h"
 
 namespace mkr {
     GLuint shader_program::create_shader(GLenum _shader_type, const std::string& _shader_source) {
         // Create the shader.
-        GLuint shader_handle = glCreateShader(_shader_type);
+        GLuint shader_handle = gfx().create_shader(_shader_type);
         // Set the source (the shader code) of the shader.
         const GLchar* source = _shader_source.c_str();
-        glShaderSource(shader_handle, 1, &(source), nullptr);
+        gfx().shader_source(shader_handle, 1, &(source), nullptr);
         // Compile the shader.
-        glCompileShader(shader_handle);
+        gfx().compile_shader(shader_handle);
 
         // Verify compile status.
         GLint status = 0;
-        glGetShaderiv(shader_handle, GL_COMPILE_STATUS, &status);
+        gfx().get_shaderiv(shader_handle, GL_COMPILE_STATUS, &status);
         if (status == GL_FALSE) {
             GLint log_length = 0;
-            glGetShaderiv(shader_handle, GL_INFO_LOG_LENGTH, &log_length);
+            gfx().get_shaderiv(shader_handle, GL_INFO_LOG_LENGTH, &log_length);
             std::unique_ptr<GLchar> info_log{new GLchar[log_length]};
-            glGetShaderInfoLog(shader_handle, log_length, &log_length, info_log.get());
+            gfx().get_shader_info_log(shader_handle, log_length, &log_length, info_log.get());
             MKR_CORE_ERROR(info_log.get());
             throw std::runtime_error(info_log.get());
         }
@@ -27,7 +28,7 @@ namespace mkr {
     }
 
     GLint shader_program::get_uniform_location(const std::string& _uniform_name) const {
-        GLint uniform_location = glGetUniformLocation(program_handle_, _uniform_name.c_str());
+        GLint uniform_location = gfx().get_uniform_location(program_handle_, _uniform_name.c_str());
         if (uniform_location == -1) {
             std::string err_msg = "cannot find uniform " + _uniform_name + " in shader " + name_;
             MKR_CORE_WARN(err_msg);
@@ -36,7 +37,7 @@ namespace mkr {
     }
 
     GLint shader_program::get_attrib_location(const std::string& _attrib_name) const {
-        GLint attrib_location = glGetAttribLocation(program_handle_, _attrib_name.c_str());
+        GLint attrib_location = gfx().get_attrib_location(program_handle_, _attrib_name.c_str());
         if (attrib_location == -1) {
             std::string err_msg = "cannot find attribute " + _attrib_name + " in shader " + name_;
             MKR_CORE_WARN(err_msg);
@@ -52,7 +53,7 @@ namespace mkr {
         uniform_handles_ = std::make_unique<GLint[]>(_num_uniforms);
 
         // Create the shader program.
-        program_handle_ = glCreateProgram();
+        program_handle_ = gfx().create_program();
 
         // Create the shaders.
         std::vector<GLuint> vs_handles;
@@ -61,7 +62,7 @@ namespace mkr {
             GLuint handle = create_shader(GL_VERTEX_SHADER, src);
             vs_handles.push_back(handle);
             // Attach the shader to the program.
-            glAttachShader(program_handle_, handle);
+            gfx().attach_shader(program_handle_, handle);
         }
 
         std::vector<GLuint> fs_handles;
@@ -70,33 +71,33 @@ namespace mkr {
             GLuint handle = create_shader(GL_FRAGMENT_SHADER, src);
             fs_handles.push_back(handle);
             // Attach the shader to the program.
-            glAttachShader(program_handle_, handle);
+            gfx().attach_shader(program_handle_, handle);
         }
 
         // Link the shader program. Now that we have attached the shaders, this will use the attached shaders to create an executable that will run on the programmable vertex processor.
-        glLinkProgram(program_handle_);
+        gfx().link_program(program_handle_);
 
         /**
          * Now that we are done creating the shader program, we no longer need the shaders, and they can be deleted.
          * It is also possible to store the shaders to create other shader programs,
          * but there isn't a compelling reason to do so since we can just re-create them again if necessary. */
         for (GLuint handle : vs_handles) {
-            glDetachShader(program_handle_, handle);
-            glDeleteShader(handle);
+            gfx().detach_shader(program_handle_, handle);
+            gfx().delete_shader(handle);
         }
         for (GLuint handle : fs_handles) {
-            glDetachShader(program_handle_, handle);
-            glDeleteShader(handle);
+            gfx().detach_shader(program_handle_, handle);
+            gfx().delete_shader(handle);
         }
 
         // Verify link status.
         GLint status = 0;
-        glGetProgramiv(program_handle_, GL_LINK_STATUS, &status);
+        gfx().get_programiv(program_handle_, GL_LINK_STATUS, &status);
         if (status == GL_FALSE) {
             GLint log_length = 0;
-            glGetProgramiv(program_handle_, GL_INFO_LOG_LENGTH, &log_length);
+            gfx().get_programiv(program_handle_, GL_INFO_LOG_LENGTH, &log_length);
             std::unique_ptr<GLchar> info_log{new GLchar[log_length]};
-            glGetProgramInfoLog(program_handle_, log_length, &log_length, info_log.get());
+            gfx().get_program_info_log(program_handle_, log_length, &log_length, info_log.get());
             MKR_CORE_ERROR(info_log.get());
             throw std::runtime_error(info_log.get());
         }
@@ -111,7 +112,7 @@ namespace mkr {
         uniform_handles_ = std::make_unique<GLint[]>(_num_uniforms);
 
         // Create the shader program.
-        program_handle_ = glCreateProgram();
+        program_handle_ = gfx().create_program();
 
         // Create the shaders.
         std::vector<GLuint> vs_handles;
@@ -120,7 +121,7 @@ namespace mkr {
             GLuint handle = create_shader(GL_VERTEX_SHADER, src);
             vs_handles.push_back(handle);
             // Attach the shader to the program.
-            glAttachShader(program_handle_, handle);
+            gfx().attach_shader(program_handle_, handle);
         }
 
         std::vector<GLuint> gs_handles;
@@ -129,7 +130,7 @@ namespace mkr {
             GLuint handle = create_shader(GL_GEOMETRY_SHADER, src);
             gs_handles.push_back(handle);
             // Attach the shader to the program.
-            glAttachShader(program_handle_, handle);
+            gfx().attach_shader(program_handle_, handle);
         }
 
         std::vector<GLuint> fs_handles;
@@ -138,37 +139,37 @@ namespace mkr {
             GLuint handle = create_shader(GL_FRAGMENT_SHADER, src);
             fs_handles.push_back(handle);
             // Attach the shader to the program.
-            glAttachShader(program_handle_, handle);
+            gfx().attach_shader(program_handle_, handle);
         }
 
         // Link the shader program. Now that we have attached the shaders, this will use the attached shaders to create an executable that will run on the programmable vertex processor.
-        glLinkProgram(program_handle_);
+        gfx().link_program(program_handle_);
 
         /**
          * Now that we are done creating the shader program, we no longer need the shaders, and they can be deleted.
          * It is also possible to store the shaders to create other shader programs,
          * but there isn't a compelling reason to do so since we can just re-create them again if necessary. */
         for (GLuint handle : vs_handles) {
-            glDetachShader(program_handle_, handle);
-            glDeleteShader(handle);
+            gfx().detach_shader(program_handle_, handle);
+            gfx().delete_shader(handle);
         }
         for (GLuint handle : gs_handles) {
-            glDetachShader(program_handle_, handle);
-            glDeleteShader(handle);
+            gfx().detach_shader(program_handle_, handle);
+            gfx().delete_shader(handle);
         }
         for (GLuint handle : fs_handles) {
-            glDetachShader(program_handle_, handle);
-            glDeleteShader(handle);
+            gfx().detach_shader(program_handle_, handle);
+            gfx().delete_shader(handle);
         }
 
         // Verify link status.
         GLint status = 0;
-        glGetProgramiv(program_handle_, GL_LINK_STATUS, &status);
+        gfx().get_programiv(program_handle_, GL_LINK_STATUS, &status);
         if (status == GL_FALSE) {
             GLint log_length = 0;
-            glGetProgramiv(program_handle_, GL_INFO_LOG_LENGTH, &log_length);
+            gfx().get_programiv(program_handle_, GL_INFO_LOG_LENGTH, &log_length);
             std::unique_ptr<GLchar> info_log{new GLchar[log_length]};
-            glGetProgramInfoLog(program_handle_, log_length, &log_length, info_log.get());
+            gfx().get_program_info_log(program_handle_, log_length, &log_length, info_log.get());
             MKR_CORE_ERROR(info_log.get());
             throw std::runtime_error(info_log.get());
         }
@@ -177,250 +178,250 @@ namespace mkr {
     }
 
     shader_program::~shader_program() {
-        glDeleteProgram(program_handle_);
+        gfx().delete_program(program_handle_);
     }
 
     void shader_program::use() {
-        glUseProgram(program_handle_);
+        gfx().use_program(program_handle_);
     }
 
     // Float
     void shader_program::set_uniform(const std::string& _uniform_name, float _value0) {
-        glProgramUniform1f(program_handle_, get_uniform_location(_uniform_name), _value0);
+        gfx().program_uniform1f(program_handle_, get_uniform_location(_uniform_name), _value0);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, float _value0, float _value1) {
-        glProgramUniform2f(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
+        gfx().program_uniform2f(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, float _value0, float _value1, float _value2) {
-        glProgramUniform3f(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
+        gfx().program_uniform3f(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, float _value0, float _value1, float _value2, float _value3) {
-        glProgramUniform4f(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
+        gfx().program_uniform4f(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
     }
 
     // Integer
     void shader_program::set_uniform(const std::string& _uniform_name, int32_t _value0) {
-        glProgramUniform1i(program_handle_, get_uniform_location(_uniform_name), _value0);
+        gfx().program_uniform1i(program_handle_, get_uniform_location(_uniform_name), _value0);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, int32_t _value0, int32_t _value1) {
-        glProgramUniform2i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
+        gfx().program_uniform2i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, int32_t _value0, int32_t _value1, int32_t _value2) {
-        glProgramUniform3i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
+        gfx().program_uniform3i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, int32_t _value0, int32_t _value1, int32_t _value2, int32_t _value3) {
-        glProgramUniform4i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
+        gfx().program_uniform4i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
     }
 
     // Unsigned Integer
     void shader_program::set_uniform(const std::string& _uniform_name, uint32_t _value0) {
-        glProgramUniform1ui(program_handle_, get_uniform_location(_uniform_name), _value0);
+        gfx().program_uniform1ui(program_handle_, get_uniform_location(_uniform_name), _value0);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, uint32_t _value0, uint32_t _value1) {
-        glProgramUniform2ui(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
+        gfx().program_uniform2ui(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, uint32_t _value0, uint32_t _value1, uint32_t _value2) {
-        glProgramUniform3ui(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
+        gfx().program_uniform3ui(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, uint32_t _value0, uint32_t _value1, uint32_t _value2, uint32_t _value3) {
-        glProgramUniform4ui(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
+        gfx().program_uniform4ui(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
     }
 
     // Boolean
     void shader_program::set_uniform(const std::string& _uniform_name, bool _value0) {
-        glProgramUniform1i(program_handle_, get_uniform_location(_uniform_name), _value0);
+        gfx().program_uniform1i(program_handle_, get_uniform_location(_uniform_name), _value0);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _value0, bool _value1) {
-        glProgramUniform2i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
+        gfx().program_uniform2i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _value0, bool _value1, bool _value2) {
-        glProgramUniform3i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
+        gfx().program_uniform3i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _value0, bool _value1, bool _value2, bool _value3) {
-        glProgramUniform4i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
+        gfx().program_uniform4i(program_handle_, get_uniform_location(_uniform_name), _value0, _value1, _value2, _value3);
     }
 
     // Matrix
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix2x2& _value) {
-        glProgramUniformMatrix2fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix2fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix3x3& _value) {
-        glProgramUniformMatrix3fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix3fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix4x4& _value) {
-        glProgramUniformMatrix4fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix4fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix2x3& _value) {
-        glProgramUniformMatrix2x3fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix2x3fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix3x2& _value) {
-        glProgramUniformMatrix3x2fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix3x2fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix4x2& _value) {
-        glProgramUniformMatrix4x2fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix4x2fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix2x4& _value) {
-        glProgramUniformMatrix2x4fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix2x4fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix3x4& _value) {
-        glProgramUniformMatrix3x4fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix3x4fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(const std::string& _uniform_name, bool _transpose, const matrix4x3& _value) {
-        glProgramUniformMatrix4x3fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix4x3fv(program_handle_, get_uniform_location(_uniform_name), 1, _transpose, _value[0]);
     }
 
     // Colour
     void shader_program::set_uniform(const std::string& _uniform_name, const colour& _colour) {
-        glProgramUniform4f(program_handle_, get_uniform_location(_uniform_name), _colour.r_, _colour.g_, _colour.b_, _colour.a_);
+        gfx().program_uniform4f(program_handle_, get_uniform_location(_uniform_name), _colour.r_, _colour.g_, _colour.b_, _colour.a_);
     }
 
     // Vector2
     void shader_program::set_uniform(const std::string& _uniform_name, const vector2& _value) {
-        glProgramUniform2f(program_handle_, get_uniform_location(_uniform_name), _value.x_, _value.y_);
+        gfx().program_uniform2f(program_handle_, get_uniform_location(_uniform_name), _value.x_, _value.y_);
     }
 
     // Vector3
     void shader_program::set_uniform(const std::string& _uniform_name, const vector3& _value) {
-        glProgramUniform3f(program_handle_, get_uniform_location(_uniform_name), _value.x_, _value.y_, _value.z_);
+        gfx().program_uniform3f(program_handle_, get_uniform_location(_uniform_name), _value.x_, _value.y_, _value.z_);
     }
 
     // Float
     void shader_program::set_uniform(uint32_t _shader_uniform, float _value0) {
-        glProgramUniform1f(program_handle_, uniform_handles_[_shader_uniform], _value0);
+        gfx().program_uniform1f(program_handle_, uniform_handles_[_shader_uniform], _value0);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, float _value0, float _value1) {
-        glProgramUniform2f(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
+        gfx().program_uniform2f(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, float _value0, float _value1, float _value2) {
-        glProgramUniform3f(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
+        gfx().program_uniform3f(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, float _value0, float _value1, float _value2, float _value3) {
-        glProgramUniform4f(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
+        gfx().program_uniform4f(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
     }
 
     // Integer
     void shader_program::set_uniform(uint32_t _shader_uniform, int32_t _value0) {
-        glProgramUniform1i(program_handle_, uniform_handles_[_shader_uniform], _value0);
+        gfx().program_uniform1i(program_handle_, uniform_handles_[_shader_uniform], _value0);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, int32_t _value0, int32_t _value1) {
-        glProgramUniform2i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
+        gfx().program_uniform2i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, int32_t _value0, int32_t _value1, int32_t _value2) {
-        glProgramUniform3i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
+        gfx().program_uniform3i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, int32_t _value0, int32_t _value1, int32_t _value2, int32_t _value3) {
-        glProgramUniform4i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
+        gfx().program_uniform4i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
     }
 
     // Unsigned Integer
     void shader_program::set_uniform(uint32_t _shader_uniform, uint32_t _value0) {
-        glProgramUniform1ui(program_handle_, uniform_handles_[_shader_uniform], _value0);
+        gfx().program_uniform1ui(program_handle_, uniform_handles_[_shader_uniform], _value0);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, uint32_t _value0, uint32_t _value1) {
-        glProgramUniform2ui(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
+        gfx().program_uniform2ui(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, uint32_t _value0, uint32_t _value1, uint32_t _value2) {
-        glProgramUniform3ui(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
+        gfx().program_uniform3ui(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, uint32_t _value0, uint32_t _value1, uint32_t _value2, uint32_t _value3) {
-        glProgramUniform4ui(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
+        gfx().program_uniform4ui(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
     }
 
     // Boolean
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _value0) {
-        glProgramUniform1i(program_handle_, uniform_handles_[_shader_uniform], _value0);
+        gfx().program_uniform1i(program_handle_, uniform_handles_[_shader_uniform], _value0);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _value0, bool _value1) {
-        glProgramUniform2i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
+        gfx().program_uniform2i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _value0, bool _value1, bool _value2) {
-        glProgramUniform3i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
+        gfx().program_uniform3i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _value0, bool _value1, bool _value2, bool _value3) {
-        glProgramUniform4i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
+        gfx().program_uniform4i(program_handle_, uniform_handles_[_shader_uniform], _value0, _value1, _value2, _value3);
     }
 
     // Matrix
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix2x2& _value) {
-        glProgramUniformMatrix2fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix2fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix3x3& _value) {
-        glProgramUniformMatrix3fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix3fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix4x4& _value) {
-        glProgramUniformMatrix4fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix4fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix2x3& _value) {
-        glProgramUniformMatrix2x3fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix2x3fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix3x2& _value) {
-        glProgramUniformMatrix3x2fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix3x2fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix4x2& _value) {
-        glProgramUniformMatrix4x2fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix4x2fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix2x4& _value) {
-        glProgramUniformMatrix2x4fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix2x4fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix3x4& _value) {
-        glProgramUniformMatrix3x4fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix3x4fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     void shader_program::set_uniform(uint32_t _shader_uniform, bool _transpose, const matrix4x3& _value) {
-        glProgramUniformMatrix4x3fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
+        gfx().program_uniform_matrix4x3fv(program_handle_, uniform_handles_[_shader_uniform], 1, _transpose, _value[0]);
     }
 
     // Colour
     void shader_program::set_uniform(uint32_t _shader_uniform, const colour& _colour) {
-        glProgramUniform4f(program_handle_, uniform_handles_[_shader_uniform], _colour.r_, _colour.g_, _colour.b_, _colour.a_);
+        gfx().program_uniform4f(program_handle_, uniform_handles_[_shader_uniform], _colour.r_, _colour.g_, _colour.b_, _colour.a_);
     }
 
     // Vector2
     void shader_program::set_uniform(uint32_t _shader_uniform, const vector2& _value) {
-        glProgramUniform2f(program_handle_, uniform_handles_[_shader_uniform], _value.x_, _value.y_);
+        gfx().program_uniform2f(program_handle_, uniform_handles_[_shader_uniform], _value.x_, _value.y_);
     }
 
     // Vector3
     void shader_program::set_uniform(uint32_t _shader_uniform, const vector3& _value) {
-        glProgramUniform3f(program_handle_, uniform_handles_[_shader_uniform], _value.x_, _value.y_, _value.z_);
+        gfx().program_uniform3f(program_handle_, uniform_handles_[_shader_uniform], _value.x_, _value.y_, _value.z_);
     }
 }
\ No newline at end of file
@@ -7,17 +7,10 @@ namespace mkr {
     public:
         enum uniform : uint32_t {
             // Vertex Shader
+            u_view_projection_matrix,
             u_texture_offset,
             u_texture_scale,
 
-            // Geometry Shader
-            u_view_projection_matrices0,
-            u_view_projection_matrices1,
-            u_view_projection_matrices2,
-            u_view_projection_matrices3,
-            u_view_projection_matrices4,
-            u_view_projection_matrices5,
-
             // Fragment Shader
             u_light_pos,
             u_shadow_distance,
@@ -33,17 +26,10 @@ namespace mkr {
     protected:
         void assign_uniforms() {
             // Vertex Shader
+            uniform_handles_[uniform::u_view_projection_matrix] = get_uniform_location("u_view_projection_matrix");
             uniform_handles_[uniform::u_texture_offset] = get_uniform_location("u_texture_offset");
             uniform_handles_[uniform::u_texture_scale] = get_uniform_location("u_texture_scale");
 
-            // Geometry Shader
-            uniform_handles_[uniform::u_view_projection_matrices0] = get_uniform_location("u_view_projection_matrices[0]");
-            uniform_handles_[uniform::u_view_projection_matrices1] = get_uniform_location("u_view_projection_matrices[1]");
-            uniform_handles_[uniform::u_view_projection_matrices2] = get_uniform_location("u_view_projection_matrices[2]");
-            uniform_handles_[uniform::u_view_projection_matrices3] = get_uniform_location("u_view_projection_matrices[3]");
-            uniform_handles_[uniform::u_view_projection_matrices4] = get_uniform_location("u_view_projection_matrices[4]");
-            uniform_handles_[uniform::u_view_projection_matrices5] = get_uniform_location("u_view_projection_matrices[5]");
-
             // Fragment Shader
             uniform_handles_[uniform::u_light_pos] = get_uniform_location("u_light_pos");
             uniform_handles_[uniform::u_shadow_distance] = get_uniform_location("u_shadow_distance");
@@ -59,8 +45,8 @@ namespace mkr {
         }
 
     public:
-        shadow_cubemap_shader(const std::string& _name, const std::vector<std::string>& _vs_sources, const std::vector<std::string>& _gs_sources, const std::vector<std::string>& _fs_sources)
-            : shader_program(_name, _vs_sources, _gs_sources, _fs_sources, uniform::num_shader_uniforms) {
+        shadow_cubemap_shader(const std::string& _name, const std::vector<std::string>& _vs_sources, const std::vector<std::string>& _fs_sources)
+            : shader_program(_name, _vs_sources, _fs_sources, uniform::num_shader_uniforms) {
             assign_uniforms();
             assign_textures();
         }
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mkr {
+    // Shader storage buffer binding points. Must match the binding qualifiers in the shaders!
+    enum storage_binding : uint32_t {
+        light_cluster_info = 0,
+        light_list,
+        light_grid,
+        light_index_list,
+        shadow_list,
+
+        num_storage_bindings,
+    };
+} // mkr
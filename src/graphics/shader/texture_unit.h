@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstdint>
-#include "graphics/lighting/lighting.h"
 
 namespace mkr {
     // Maximum 32 texture units in OpenGL.
@@ -13,14 +12,14 @@ namespace mkr {
         texture_normal = 3,
         texture_displacement = 4,
 
-        texture_position,
+        texture_depth,
         texture_accumulation,
         texture_revealage,
 
-        // For every shadow index, since only either the texture2d or cubemap will be bound at any given time, they can share the same index.
-        texture_shadows0, // Range: [texture_shadows0, texture_shadows0 + lighting::max_lights)
-        cubemap_shadows0 = texture_shadows0, // Range: [cubemap_shadows0, cubemap_shadows0 + lighting::max_lights)
+        // Every shadow map lives in one of these two textures, see shadow_atlas.
+        texture_shadow_atlas,
+        texture_shadow_cubemaps,
 
-        num_texture_units = lighting::max_lights + cubemap_shadows0,
+        num_texture_units,
     };
 } // mkr
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <maths/vector3.h>
+
+namespace mkr {
+    class bounding_sphere {
+    private:
+        vector3 centre_;
+        float radius_;
+
+    public:
+        bounding_sphere(const vector3& _centre, float _radius)
+            : centre_(_centre), radius_(_radius) {}
+
+        virtual ~bounding_sphere() {}
+
+        [[nodiscard]] const vector3& centre() const { return centre_; }
+
+        [[nodiscard]] float radius() const { return radius_; }
+    };
+}
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <bit>
+#include <log/log.h>
+#include "graphics/shadow/shadow_atlas.h"
+#include "graphics/shader/texture_unit.h"
+
+namespace mkr {
+    shadow_atlas::shadow_atlas(uint32_t _max_size, uint32_t _cubemap_size, uint32_t _max_cubemap_layers)
+        : max_size_(std::bit_floor(std::max(_max_size, min_tile_size))), cubemap_size_(_cubemap_size), max_cubemap_layers_(_max_cubemap_layers) {}
+
+    std::optional<shadow_tile> shadow_atlas::take_tile(uint32_t _size) {
+        // Use the smallest free tile that is large enough.
+        for (auto iter = free_tiles_.lower_bound(_size); iter != free_tiles_.end(); ++iter) {
+            if (iter->second.empty()) { continue; }
+            shadow_tile tile = iter->second.back();
+            iter->second.pop_back();
+
+            // Split the tile down to the requested size, freeing the other three quarters at every level.
+            while (tile.size_ > _size) {
+                const uint32_t half = tile.size_ / 2;
+                auto& quarters = free_tiles_[half];
+                quarters.push_back({tile.x_ + half, tile.y_, half});
+                quarters.push_back({tile.x_, tile.y_ + half, half});
+                quarters.push_back({tile.x_ + half, tile.y_ + half, half});
+                tile.size_ = half;
+            }
+            return tile;
+        }
+        return std::nullopt;
+    }
+
+    bool shadow_atlas::grow_atlas(uint32_t _min_size) {
+        if (size_ >= max_size_) { return false; }
+
+        const uint32_t new_size = (size_ == 0) ? std::min(_min_size, max_size_) : size_ * 2;
+        auto new_buffer = std::make_unique<shadow_atlas_buffer>(new_size);
+        auto new_static_buffer = static_buffer_ ? std::make_unique<shadow_atlas_buffer>(new_size) : nullptr;
+
+        if (size_ == 0) {
+            free_tiles_[new_size].push_back({0, 0, new_size});
+        } else {
+            // The old atlas becomes the bottom left quarter of the new one, so the tiles already handed out keep their coordinates and contents.
+            buffer_->copy_region_to(new_buffer.get(), 0, 0, size_, size_);
+            if (static_buffer_) { static_buffer_->copy_region_to(new_static_buffer.get(), 0, 0, size_, size_); }
+
+            auto& quarters = free_tiles_[size_];
+            quarters.push_back({size_, 0, size_});
+            quarters.push_back({0, size_, size_});
+            quarters.push_back({size_, size_, size_});
+        }
+
+        size_ = new_size;
+        buffer_ = std::move(new_buffer);
+        static_buffer_ = std::move(new_static_buffer);
+        MKR_CORE_INFO("shadow atlas resized to {}x{}", size_, size_);
+        return true;
+    }
+
+    bool shadow_atlas::grow_cubemaps() {
+        const uint32_t num_layers = cubemaps_ ? cubemaps_->layers() : 0;
+        if (num_layers >= max_cubemap_layers_) { return false; }
+
+        const uint32_t new_num_layers = (num_layers == 0) ? 1 : std::min(num_layers * 2, max_cubemap_layers_);
+        auto new_cubemaps = std::make_unique<shadow_cubemap_array_buffer>(cubemap_size_, new_num_layers);
+        auto new_static_cubemaps = static_cubemaps_ ? std::make_unique<shadow_cubemap_array_buffer>(cubemap_size_, new_num_layers) : nullptr;
+        if (num_layers > 0) {
+            cubemaps_->copy_layers_to(new_cubemaps.get(), 0, num_layers);
+            if (static_cubemaps_) { static_cubemaps_->copy_layers_to(new_static_cubemaps.get(), 0, num_layers); }
+        }
+
+        // Hand out the lowest layers first.
+        for (uint32_t layer = new_num_layers; layer-- > num_layers;) { free_layers_.push_back(layer); }
+
+        cubemaps_ = std::move(new_cubemaps);
+        static_cubemaps_ = std::move(new_static_cubemaps);
+        MKR_CORE_INFO("shadow cubemap array resized to {} layers", new_num_layers);
+        return true;
+    }
+
+    void shadow_atlas::release_atlas() {
+        size_ = 0;
+        free_tiles_.clear();
+        buffer_.reset();
+        static_buffer_.reset();
+    }
+
+    void shadow_atlas::release_cubemaps() {
+        num_used_layers_ = 0;
+        free_layers_.clear();
+        cubemaps_.reset();
+        static_cubemaps_.reset();
+    }
+
+    std::optional<shadow_tile> shadow_atlas::allocate_tile(uint32_t _size) {
+        uint32_t size = std::bit_floor(std::clamp(_size, min_tile_size, max_size_));
+        while (true) {
+            if (auto tile = take_tile(size)) { return tile; }
+            if (grow_atlas(size)) { continue; }
+            if (size <= min_tile_size) { return std::nullopt; }
+            size /= 2;
+        }
+    }
+
+    void shadow_atlas::free_tile(const shadow_tile& _tile) {
+        // Merge the tile with its siblings for as long as all four quarters of the parent tile are free.
+        shadow_tile tile = _tile;
+        while (tile.size_ < size_) {
+            auto& free_tiles = free_tiles_[tile.size_];
+            const uint32_t parent_size = tile.size_ * 2;
+            const shadow_tile parent{tile.x_ - tile.x_ % parent_size, tile.y_ - tile.y_ % parent_size, parent_size};
+            const auto is_sibling = [&](const shadow_tile& _other) {
+                return !(_other == tile) &&
+                       parent.x_ <= _other.x_ && _other.x_ < parent.x_ + parent_size &&
+                       parent.y_ <= _other.y_ && _other.y_ < parent.y_ + parent_size;
+            };
+            if (std::count_if(free_tiles.begin(), free_tiles.end(), is_sibling) < 3) { break; }
+            std::erase_if(free_tiles, is_sibling);
+            tile = parent;
+        }
+
+        // Release the atlas once nothing is using it.
+        if (tile.size_ == size_) {
+            release_atlas();
+            return;
+        }
+        free_tiles_[tile.size_].push_back(tile);
+    }
+
+    std::optional<uint32_t> shadow_atlas::allocate_layer() {
+        if (free_layers_.empty() && !grow_cubemaps()) { return std::nullopt; }
+        const uint32_t layer = free_layers_.back();
+        free_layers_.pop_back();
+        ++num_used_layers_;
+        return layer;
+    }
+
+    void shadow_atlas::free_layer(uint32_t _layer) {
+        free_layers_.push_back(_layer);
+        if (--num_used_layers_ == 0) { release_cubemaps(); }
+    }
+
+    shadow_atlas_buffer* shadow_atlas::static_buffer() {
+        if (!static_buffer_ && size_ > 0) { static_buffer_ = std::make_unique<shadow_atlas_buffer>(size_); }
+        return static_buffer_.get();
+    }
+
+    shadow_cubemap_array_buffer* shadow_atlas::static_cubemaps() {
+        if (!static_cubemaps_ && cubemaps_) { static_cubemaps_ = std::make_unique<shadow_cubemap_array_buffer>(cubemap_size_, cubemaps_->layers()); }
+        return static_cubemaps_.get();
+    }
+
+    uint64_t shadow_atlas::memory_usage() const {
+        // Every texel is a 32 bit depth-stencil value.
+        const uint64_t atlas_bytes = static_cast<uint64_t>(size_) * size_ * 4;
+        const uint64_t cubemap_bytes = cubemaps_ ? static_cast<uint64_t>(cubemap_size_) * cubemap_size_ * num_cubemap_sides * cubemaps_->layers() * 4 : 0;
+        return atlas_bytes * (static_buffer_ ? 2 : 1) + cubemap_bytes * (static_cubemaps_ ? 2 : 1);
+    }
+
+    void shadow_atlas::bind() {
+        if (buffer_) { buffer_->get_depth_stencil_attachment()->bind(texture_unit::texture_shadow_atlas); }
+        if (cubemaps_) { cubemaps_->get_depth_stencil_attachment()->bind(texture_unit::texture_shadow_cubemaps); }
+    }
+} // mkr
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "graphics/framebuffer/shadow_atlas_buffer.h"
+#include "graphics/framebuffer/shadow_cubemap_array_buffer.h"
+#include "graphics/lighting/lighting.h"
+
+namespace mkr {
+    /// Where a light's shadow map lives. Must match the std430 layout of the shadow struct in shadow.frag!
+    struct gpu_shadow {
+        float view_projection_matrices_[lighting::max_cascades][16]; // Column major. Spot lights only use the first.
+        float tile_rects_[lighting::max_cascades][4]; // The offset (xy) and scale (zw) of each cascade's tile, in atlas texture coordinates.
+        float split_distances_[lighting::max_cascades]; // The far distance of each cascade from the camera.
+        int32_t num_cascades_;
+        int32_t cubemap_layer_; // For point lights, the layer of the shadow cubemap array.
+        int32_t padding_[2];
+    };
+    static_assert(sizeof(gpu_shadow) == 352, "gpu_shadow must match the std430 layout of the shadow struct in shadow.frag");
+
+    /// A square tile of the shadow atlas, in texels.
+    struct shadow_tile {
+        uint32_t x_ = 0;
+        uint32_t y_ = 0;
+        uint32_t size_ = 0;
+
+        inline bool operator==(const shadow_tile& _rhs) const { return x_ == _rhs.x_ && y_ == _rhs.y_ && size_ == _rhs.size_; }
+    };
+
+    /**
+     * Hands out shadow maps at runtime.
+     * Spot and directional lights get square tiles of a single depth texture. Tiles are power of two sized, and come from a quadtree,
+     * so that a freed tile merges with its free siblings back into a larger one.
+     * Point lights get a layer of a cubemap array, as every face of a cubemap array must be the same size.
+     * Both textures are only created once a shadow map is needed, grow by doubling when they run out of space, and are released once every shadow map in them has been freed,
+     * so that the memory used follows the shadow maps in use rather than the maximum number of shadow casting lights.
+     */
+    class shadow_atlas {
+    public:
+        static constexpr uint32_t min_tile_size = 256;
+
+    private:
+        const uint32_t max_size_;
+        const uint32_t cubemap_size_;
+        const uint32_t max_cubemap_layers_;
+
+        // Atlas
+        uint32_t size_ = 0; // 0 while there is no atlas texture.
+        std::map<uint32_t, std::vector<shadow_tile>> free_tiles_; // Keyed by tile size.
+        std::unique_ptr<shadow_atlas_buffer> buffer_;
+        std::unique_ptr<shadow_atlas_buffer> static_buffer_;
+
+        // Cubemaps
+        uint32_t num_used_layers_ = 0;
+        std::vector<uint32_t> free_layers_;
+        std::unique_ptr<shadow_cubemap_array_buffer> cubemaps_;
+        std::unique_ptr<shadow_cubemap_array_buffer> static_cubemaps_;
+
+        std::optional<shadow_tile> take_tile(uint32_t _size);
+        bool grow_atlas(uint32_t _min_size);
+        bool grow_cubemaps();
+        void release_atlas();
+        void release_cubemaps();
+
+    public:
+        /**
+         * @param _max_size The largest the atlas may grow to, in texels.
+         * @param _cubemap_size The face size of every point light shadow map, in texels.
+         * @param _max_cubemap_layers The largest number of point light shadow maps.
+         */
+        shadow_atlas(uint32_t _max_size, uint32_t _cubemap_size, uint32_t _max_cubemap_layers);
+        ~shadow_atlas() = default;
+
+        /**
+         * Allocate a tile of the atlas. If there is no room for a tile of the requested size, even after growing the atlas, smaller tiles are tried.
+         * @param _size The size of the tile in texels. Rounded down to a power of two, and clamped to [min_tile_size, max_size].
+         * @return The tile, or nothing if the atlas is full.
+         */
+        [[nodiscard]] std::optional<shadow_tile> allocate_tile(uint32_t _size);
+        void free_tile(const shadow_tile& _tile);
+
+        /**
+         * Allocate a layer of the cubemap array.
+         * @return The layer, or nothing if every layer is in use.
+         */
+        [[nodiscard]] std::optional<uint32_t> allocate_layer();
+        void free_layer(uint32_t _layer);
+
+        [[nodiscard]] inline uint32_t size() const { return size_; }
+        [[nodiscard]] inline uint32_t cubemap_size() const { return cubemap_size_; }
+        [[nodiscard]] inline shadow_atlas_buffer* buffer() { return buffer_.get(); }
+        [[nodiscard]] inline shadow_cubemap_array_buffer* cubemaps() { return cubemaps_.get(); }
+        /// A copy of the atlas, for caching the static shadow casters. Created on first use.
+        [[nodiscard]] shadow_atlas_buffer* static_buffer();
+        /// A copy of the cubemap array, for caching the static shadow casters. Created on first use.
+        [[nodiscard]] shadow_cubemap_array_buffer* static_cubemaps();
+        /// The number of bytes of texture memory held.
+        [[nodiscard]] uint64_t memory_usage() const;
+
+        /// Bind the atlas and the cubemap array to their texture units.
+        void bind();
+    };
+} // mkr
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <maths/maths_util.h>
+#include <maths/matrix.h>
+#include <maths/matrix_util.h>
+#include <maths/vector3.h>
+#include "component/camera.h"
+#include "graphics/shadow/bounding_sphere.h"
+
+namespace mkr {
+    /// A single cascade of a directional light's shadow map.
+    struct shadow_cascade {
+        /// The light's view matrix, with no translation. Cascades are snapped in this space.
+        matrix4x4 light_view_matrix_;
+        /// The centre of the cascade in light space, snapped to the texel grid.
+        vector3 centre_;
+        float radius_;
+        matrix4x4 view_matrix_;
+        matrix4x4 projection_matrix_;
+
+        /**
+         * Check whether a shadow caster can cast a shadow into the cascade.
+         * Casters between the light and the cascade are kept, as they are clamped onto the near plane when rendered.
+         * @param _caster the world space bounding sphere of the caster
+         * @return true if the caster may cast a shadow into the cascade
+         */
+        [[nodiscard]] bool intersects(const bounding_sphere& _caster) const {
+            const vector3 centre = light_view_matrix_ * _caster.centre();
+            const float extent = radius_ + _caster.radius();
+            // In OpenGL convention, the light looks down the -z axis, so casters further from the light have a smaller z.
+            return std::abs(centre.x_ - centre_.x_) <= extent &&
+                   std::abs(centre.y_ - centre_.y_) <= extent &&
+                   centre.z_ >= centre_.z_ - extent;
+        }
+    };
+
+    class shadow_cascades {
+    public:
+        shadow_cascades() = delete;
+
+        /**
+         * Get the split distances of the cascades, blending between a logarithmic and a uniform distribution.
+         * @param _near the camera's near clipping distance
+         * @param _far the shadow distance
+         * @param _num_cascades the number of cascades
+         * @param _lambda the blend factor, where 0 is a uniform distribution and 1 is a logarithmic distribution
+         * @param _splits output, the far distance of each cascade
+         */
+        static void get_split_distances(float _near, float _far, uint32_t _num_cascades, float _lambda, float* _splits) {
+            for (uint32_t i = 1; i <= _num_cascades; ++i) {
+                const float t = static_cast<float>(i) / static_cast<float>(_num_cascades);
+                const float log_split = _near * std::pow(_far / _near, t);
+                const float uniform_split = _near + (_far - _near) * t;
+                _splits[i - 1] = _lambda * log_split + (1.0f - _lambda) * uniform_split;
+            }
+        }
+
+        /**
+         * Get the bounding sphere of a slice of the camera's view volume.
+         * The radius only depends on the camera's projection, so it does not change as the camera moves or rotates.
+         * @param _cam_pos the camera position
+         * @param _cam_forward the NORMALISED direction the camera is facing
+         * @param _cam the camera
+         * @param _near the near distance of the slice
+         * @param _far the far distance of the slice
+         * @return the bounding sphere of the slice
+         */
+        static bounding_sphere get_slice_sphere(const vector3& _cam_pos, const vector3& _cam_forward, const camera& _cam, float _near, float _far) {
+            float centre_dist, radius;
+            if (_cam.mode_ == projection_mode::perspective) {
+                // k is the slope of the frustum's corner edges.
+                const float tan_half_fov = std::tan(_cam.fov_ * 0.5f);
+                const float k_sqr = tan_half_fov * tan_half_fov * (1.0f + _cam.aspect_ratio_ * _cam.aspect_ratio_);
+                if (k_sqr >= (_far - _near) / (_far + _near)) {
+                    // The far corners bound the whole slice.
+                    centre_dist = _far;
+                    radius = _far * std::sqrt(k_sqr);
+                } else {
+                    // The smallest sphere through all eight corners.
+                    centre_dist = 0.5f * (_far + _near) * (1.0f + k_sqr);
+                    radius = 0.5f * std::sqrt((_far - _near) * (_far - _near) + 2.0f * (_far * _far + _near * _near) * k_sqr + (_far + _near) * (_far + _near) * k_sqr * k_sqr);
+                }
+            } else {
+                const float half_height = _cam.ortho_size_ * 0.5f;
+                const float half_width = half_height * _cam.aspect_ratio_;
+                const float half_depth = (_far - _near) * 0.5f;
+                centre_dist = (_far + _near) * 0.5f;
+                radius = std::sqrt(half_width * half_width + half_height * half_height + half_depth * half_depth);
+            }
+            return bounding_sphere{_cam_pos + _cam_forward * centre_dist, radius};
+        }
+
+        /**
+         * Fit a cascade around a bounding sphere.
+         * The cascade is snapped to the texel grid of the shadow map in light space, so that it moves in whole texels and the shadows do not shimmer as the camera moves.
+         * @param _light_forward the NORMALISED direction of the light
+         * @param _light_up the NORMALISED up direction of the light
+         * @param _sphere the bounding sphere of the slice of the view volume covered by the cascade
+         * @param _resolution the size of the cascade in texels
+         * @return the cascade
+         */
+        static shadow_cascade fit_cascade(const vector3& _light_forward, const vector3& _light_up, const bounding_sphere& _sphere, uint32_t _resolution) {
+            shadow_cascade cascade;
+            cascade.light_view_matrix_ = matrix_util::view_matrix(vector3::zero(), _light_forward, _light_up);
+            const auto light_view_matrix_inverse = cascade.light_view_matrix_.transposed(); // Since translation is 0, inverse equals transpose.
+
+            // Round the radius up, so that floating point noise does not change the size of the cascade from frame to frame.
+            cascade.radius_ = std::ceil(_sphere.radius() * 16.0f) / 16.0f;
+
+            const float texel_size = 2.0f * cascade.radius_ / static_cast<float>(_resolution);
+            cascade.centre_ = cascade.light_view_matrix_ * _sphere.centre();
+            cascade.centre_.x_ = std::floor(cascade.centre_.x_ / texel_size) * texel_size;
+            cascade.centre_.y_ = std::floor(cascade.centre_.y_ / texel_size) * texel_size;
+
+            cascade.view_matrix_ = matrix_util::view_matrix(light_view_matrix_inverse * cascade.centre_, _light_forward, _light_up);
+            cascade.projection_matrix_ = matrix_util::orthographic_matrix(1.0f, 2.0f * cascade.radius_, -cascade.radius_, cascade.radius_);
+            return cascade;
+        }
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cmath>
+#include <maths/maths_util.h>
+#include <maths/vector3.h>
+#include "graphics/shadow/bounding_sphere.h"
+
+namespace mkr {
+    /// Tests that find the shadow casters which can cast a shadow into a light's shadow map.
+    class shadow_culling {
+    public:
+        shadow_culling() = delete;
+
+        /**
+         * Check whether a caster is within a point light's shadow distance.
+         * @param _caster the world space bounding sphere of the caster
+         * @param _light_pos the position of the light
+         * @param _shadow_distance the light's shadow distance
+         * @return true if the caster may cast a shadow
+         */
+        static bool in_sphere(const bounding_sphere& _caster, const vector3& _light_pos, float _shadow_distance) {
+            const vector3 offset = _caster.centre() - _light_pos;
+            const float max_distance = _shadow_distance + _caster.radius();
+            return offset.dot(offset) <= max_distance * max_distance;
+        }
+
+        /**
+         * Check whether a caster is within a spot light's cone.
+         * @param _caster the world space bounding sphere of the caster
+         * @param _light_pos the position of the light
+         * @param _light_dir the NORMALISED direction of the light
+         * @param _half_angle half of the cone's angle, in radians
+         * @param _shadow_distance the light's shadow distance
+         * @return true if the caster may cast a shadow
+         */
+        static bool in_cone(const bounding_sphere& _caster, const vector3& _light_pos, const vector3& _light_dir, float _half_angle, float _shadow_distance) {
+            const vector3 offset = _caster.centre() - _light_pos;
+            const float dist_along = offset.dot(_light_dir);
+            const float dist_perp = std::sqrt(maths_util::max<float>(0.0f, offset.dot(offset) - dist_along * dist_along));
+            // The distance of the sphere's centre from the side of the cone.
+            const float dist_side = std::cos(_half_angle) * dist_perp - std::sin(_half_angle) * dist_along;
+            return dist_side <= _caster.radius() &&
+                   dist_along <= _shadow_distance + _caster.radius() &&
+                   dist_along >= -_caster.radius();
+        }
+
+        /**
+         * Check whether a caster is within the frustum of one face of a point light's cubemap.
+         * Each face has a 90 degree field of view, so a point is in front of the face when its distance along the face's direction is at least its distance along either of the other axes.
+         * @param _caster the world space bounding sphere of the caster
+         * @param _light_pos the position of the light
+         * @param _face_dir the axis aligned direction of the face
+         * @return true if the caster may cast a shadow into the face
+         */
+        static bool in_cube_face(const bounding_sphere& _caster, const vector3& _light_pos, const vector3& _face_dir) {
+            const vector3 offset = _caster.centre() - _light_pos;
+            const float dist_along = offset.dot(_face_dir);
+            const vector3 perp = offset - _face_dir * dist_along;
+            const float max_perp = maths_util::max<float>(std::abs(perp.x_), maths_util::max<float>(std::abs(perp.y_), std::abs(perp.z_)));
+            // The side planes are at 45 degrees to the face's direction, so the sphere's radius is scaled by sqrt(2).
+            return dist_along + _caster.radius() * std::sqrt(2.0f) >= max_perp;
+        }
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <stdexcept>
 #include <GL/glew.h>
 
@@ -201,5 +202,90 @@ namespace mkr {
                     throw std::runtime_error("invalid sized format");
             };
         }
+
+        /// The number of bytes a pixel takes up in GPU memory. Formats with 3 components are counted as padded to 4, as most drivers store them.
+        static uint32_t bytes_per_pixel(sized_format _format) {
+            switch (_format) {
+                case sized_format::r8:
+                case sized_format::r8_snorm:
+                case sized_format::r3_g3_b2:
+                case sized_format::rgba2:
+                case sized_format::r8i:
+                case sized_format::r8ui:
+                case sized_format::stencil_index1:
+                case sized_format::stencil_index4:
+                case sized_format::stencil_index8:
+                    return 1;
+                case sized_format::r16:
+                case sized_format::r16_snorm:
+                case sized_format::rg8:
+                case sized_format::rg8_snorm:
+                case sized_format::rgb4:
+                case sized_format::rgb5:
+                case sized_format::rgba4:
+                case sized_format::rgb5_a1:
+                case sized_format::r16f:
+                case sized_format::r16i:
+                case sized_format::r16ui:
+                case sized_format::rg8i:
+                case sized_format::rg8ui:
+                case sized_format::depth_component16:
+                case sized_format::stencil_index16:
+                    return 2;
+                case sized_format::rg16:
+                case sized_format::rg16_snorm:
+                case sized_format::rgb8:
+                case sized_format::rgb8_snorm:
+                case sized_format::rgb10:
+                case sized_format::rgba8:
+                case sized_format::rgba8_snorm:
+                case sized_format::rgb10_a2:
+                case sized_format::rgb10_a2ui:
+                case sized_format::srgb8:
+                case sized_format::srgb8_alpha8:
+                case sized_format::rg16f:
+                case sized_format::r32f:
+                case sized_format::r11f_g11f_b10f:
+                case sized_format::rgb9_e5:
+                case sized_format::r32i:
+                case sized_format::r32ui:
+                case sized_format::rg16i:
+                case sized_format::rg16ui:
+                case sized_format::rgb8i:
+                case sized_format::rgb8ui:
+                case sized_format::rgba8i:
+                case sized_format::rgba8ui:
+                case sized_format::depth_component24:
+                case sized_format::depth_component32:
+                case sized_format::depth_component32f:
+                case sized_format::depth24_stencil8:
+                    return 4;
+                case sized_format::rgb12:
+                case sized_format::rgb16_snorm:
+                case sized_format::rgba12:
+                case sized_format::rgba16:
+                case sized_format::rgb16f:
+                case sized_format::rgba16f:
+                case sized_format::rg32f:
+                case sized_format::rg32i:
+                case sized_format::rg32ui:
+                case sized_format::rgb16i:
+                case sized_format::rgb16ui:
+                case sized_format::rgba16i:
+                case sized_format::rgba16ui:
+                case sized_format::depth32f_stencil8:
+                    return 8;
+                case sized_format::rgb32f:
+                case sized_format::rgba32f:
+                case sized_format::rgb32i:
+                case sized_format::rgb32ui:
+                case sized_format::rgba32i:
+                case sized_format::rgba32ui:
+                    return 16;
+
+                default:
+                    throw std::runtime_error("invalid sized format");
+            };
+        }
     };
 }
\ No newline at end of file
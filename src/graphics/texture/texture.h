@@ -4,8 +4,10 @@
 #include <cmath>
 #include <SDL2/SDL_image.h>
 #include <GL/glew.h>
+#include "graphics/device/graphics_device.h"
 #include <maths/maths_util.h>
 #include "graphics/texture/pixel_format.h"
+#include "memory/memory_tracker.h"
 
 namespace mkr {
     class texture {
@@ -13,6 +15,8 @@ namespace mkr {
         const std::string name_;
         const uint32_t width_, height_;
         GLuint handle_;
+        gpu_memory_tag gpu_tag_ = gpu_memory_tag::texture;
+        size_t gpu_bytes_ = 0;
 
         static uint32_t mip_map_level(uint32_t _width, uint32_t _height) {
             const uint32_t log2_width = static_cast<uint32_t>(std::log2f(static_cast<float>(_width)));
@@ -20,11 +24,28 @@ namespace mkr {
             return maths_util::clamp<uint32_t>(maths_util::min(log2_width, log2_height), 1, GL_TEXTURE_MAX_LEVEL);
         }
 
+        /**
+         * Record the GPU memory taken up by the texture's storage, which is released when the texture is destroyed.
+         * @param _tag the kind of texture
+         * @param _levels the number of mipmap levels
+         * @param _layers the number of layers, such as 6 for a cubemap
+         * @param _format the format the texture is stored in
+         */
+        void track_gpu_memory(gpu_memory_tag _tag, uint32_t _levels, uint32_t _layers, sized_format _format) {
+            size_t bytes = 0;
+            for (uint32_t i = 0; i < _levels; ++i) {
+                bytes += static_cast<size_t>(maths_util::max<uint32_t>(width_ >> i, 1)) * maths_util::max<uint32_t>(height_ >> i, 1);
+            }
+            gpu_tag_ = _tag;
+            gpu_bytes_ = bytes * _layers * pixel_format::bytes_per_pixel(_format);
+            memory_tracker::gpu_allocate(gpu_tag_, gpu_bytes_);
+        }
+
         texture(const std::string& _name, uint32_t _width, uint32_t _height)
             : handle_(0), name_(_name), width_(_width), height_(_height) {}
 
     public:
-        virtual ~texture() {}
+        virtual ~texture() { memory_tracker::gpu_deallocate(gpu_tag_, gpu_bytes_); }
 
         [[nodiscard]] inline const std::string& name() const { return name_; }
 
@@ -34,7 +55,7 @@ namespace mkr {
 
         [[nodiscard]] inline GLuint handle() const { return handle_; }
 
-        inline void bind(uint32_t _texture_unit) { glBindTextureUnit((GLuint) _texture_unit, handle_); }
+        inline void bind(uint32_t _texture_unit) { gfx().bind_texture_unit((GLuint) _texture_unit, handle_); }
     };
 
     class texture2d : public texture {
@@ -49,40 +70,42 @@ namespace mkr {
              * glTexImage2D where it can resize itself to generate mipmaps. The glTextureStorage2D documentation
              * states "GL_INVALID_VALUE is generated if width, height or levels are less than 1." */
             // Direct-State-Access Method (OpenGL 4.5) Create Texture
-            glCreateTextures(GL_TEXTURE_2D, 1, &handle_);
+            gfx().create_textures(GL_TEXTURE_2D, 1, &handle_);
 
-            glTextureStorage2D(handle_, (GLsizei) mip_map_level(width_, height_),
+            gfx().texture_storage_2d(handle_, (GLsizei) mip_map_level(width_, height_),
                                (GLenum) _internal_format, ///< Format to store the texture data in OpenGL.
                                (GLsizei) width_, (GLsizei) height_);
-            glTextureSubImage2D(handle_, 0, 0, 0, (GLsizei) width_, (GLsizei) height_,
+            gfx().texture_sub_image_2d(handle_, 0, 0, 0, (GLsizei) width_, (GLsizei) height_,
                                 (GLenum) pixel_format::sized_to_base(_internal_format), ///< Format of the image data being passed in. It is expected to be compatible with the sized format.
                                 GL_UNSIGNED_BYTE, _data);
 
             // Texture Parameter(s)
-            glTextureParameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTextureParameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
             // Generate Mipmap
-            glGenerateTextureMipmap(handle_);
+            gfx().generate_texture_mipmap(handle_);
+            track_gpu_memory(gpu_memory_tag::texture, mip_map_level(width_, height_), 1, _internal_format);
         }
 
         // Framebuffer attachment.
         texture2d(const std::string& _name, uint32_t _width, uint32_t _height, sized_format _internal_format)
             : texture(_name, _width, _height) {
-            glCreateTextures(GL_TEXTURE_2D, 1, &handle_);
-            glTextureStorage2D(handle_, 1, (GLenum) _internal_format, (GLsizei) width_, (GLsizei) height_);
-            glTextureParameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTextureParameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glGenerateTextureMipmap(handle_);
+            gfx().create_textures(GL_TEXTURE_2D, 1, &handle_);
+            gfx().texture_storage_2d(handle_, 1, (GLenum) _internal_format, (GLsizei) width_, (GLsizei) height_);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            gfx().generate_texture_mipmap(handle_);
+            track_gpu_memory(gpu_memory_tag::framebuffer, 1, 1, _internal_format);
         }
 
         virtual ~texture2d() {
             // Delete Texture
-            glDeleteTextures(1, &handle_);
+            gfx().delete_textures(1, &handle_);
         }
     };
 
@@ -126,42 +149,70 @@ namespace mkr {
     public:
         cubemap(const std::string& _name, uint32_t _size, std::array<const void*, num_cubemap_sides> _data, sized_format _internal_format = sized_format::rgba8)
             : texture(_name, _size, _size) {
-            glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &handle_);
+            gfx().create_textures(GL_TEXTURE_CUBE_MAP, 1, &handle_);
 
-            glTextureStorage2D(handle_, (GLsizei) mip_map_level(width_, height_),
+            gfx().texture_storage_2d(handle_, (GLsizei) mip_map_level(width_, height_),
                                (GLenum) _internal_format, ///< Format to store the texture data in OpenGL.
                                (GLsizei) width_, (GLsizei) height_);
 
             // Note that for cubemaps, we have to use glTextureSubImage3D instead of glTextureSubImage2D, but we still use glTextureStorage2D.
             for (auto i = 0; i < num_cubemap_sides; ++i) {
-                glTextureSubImage3D(handle_, 0, 0, 0, i, (GLsizei) width_, (GLsizei) height_, 1,
+                gfx().texture_sub_image_3d(handle_, 0, 0, 0, i, (GLsizei) width_, (GLsizei) height_, 1,
                                     (GLenum) pixel_format::sized_to_base(_internal_format), ///< Format of the image data being passed in. It is expected to be compatible with the sized format.
                                     GL_UNSIGNED_BYTE, _data[i]);
             }
-            glTextureParameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTextureParameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-
-            glGenerateTextureMipmap(handle_);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+            gfx().generate_texture_mipmap(handle_);
+            track_gpu_memory(gpu_memory_tag::cubemap, mip_map_level(width_, height_), num_cubemap_sides, _internal_format);
         }
 
         // Framebuffer attachment.
         cubemap(const std::string& _name, uint32_t _size, sized_format _internal_format = sized_format::rgba8)
             : texture(_name, _size, _size) {
-            glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &handle_);
-            glTextureStorage2D(handle_, 1, (GLenum) _internal_format, (GLsizei) width_, (GLsizei) height_);
-            glTextureParameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glTextureParameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTextureParameteri(handle_, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-            glGenerateTextureMipmap(handle_);
+            gfx().create_textures(GL_TEXTURE_CUBE_MAP, 1, &handle_);
+            gfx().texture_storage_2d(handle_, 1, (GLenum) _internal_format, (GLsizei) width_, (GLsizei) height_);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            gfx().generate_texture_mipmap(handle_);
+            track_gpu_memory(gpu_memory_tag::framebuffer, 1, num_cubemap_sides, _internal_format);
         }
 
         virtual ~cubemap() {
-            glDeleteTextures(1, &handle_);
+            gfx().delete_textures(1, &handle_);
         }
     };
+
+    class cubemap_array : public texture {
+    private:
+        const uint32_t layers_;
+
+    public:
+        // Framebuffer attachment.
+        cubemap_array(const std::string& _name, uint32_t _size, uint32_t _layers, sized_format _internal_format = sized_format::rgba8)
+            : texture(_name, _size, _size), layers_(_layers) {
+            gfx().create_textures(GL_TEXTURE_CUBE_MAP_ARRAY, 1, &handle_);
+            // Every layer is made of 6 faces.
+            gfx().texture_storage_3d(handle_, 1, (GLenum) _internal_format, (GLsizei) width_, (GLsizei) height_, (GLsizei) (_layers * num_cubemap_sides));
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            gfx().texture_parameteri(handle_, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            track_gpu_memory(gpu_memory_tag::framebuffer, 1, _layers * num_cubemap_sides, _internal_format);
+        }
+
+        virtual ~cubemap_array() {
+            gfx().delete_textures(1, &handle_);
+        }
+
+        [[nodiscard]] inline uint32_t layers() const { return layers_; }
+    };
 }
\ No newline at end of file
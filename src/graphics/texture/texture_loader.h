@@ -8,7 +8,7 @@
 
 namespace mkr {
     class texture_loader {
-    private:
+    public:
         /**
             \brief Flip the image data horizontally.
             \param _data The image data to flip.
@@ -63,7 +63,6 @@ namespace mkr {
             delete[] temp_row;
         }
 
-    public:
         texture_loader() = delete;
 
         static void init() {
@@ -6,6 +6,7 @@
 #include <common/singleton.h>
 #include "graphics/texture/texture.h"
 #include "graphics/texture/texture_loader.h"
+#include "memory/memory_tracker.h"
 
 namespace mkr {
     class texture_manager : public singleton<texture_manager> {
@@ -28,6 +29,7 @@ namespace mkr {
 
         texture2d* make_texture2d(const std::string& _name, const std::string& _file, bool _flip_x = false, bool _flip_y = false) {
             if (texture2ds_.contains(_name)) { throw std::runtime_error("duplicate texture2d name"); }
+            memory_scope scope{memory_tag::texture};
             texture2ds_[_name] = texture_loader::load_texture2d(_name, _file, _flip_x, _flip_y);
             return texture2ds_[_name].get();
         }
@@ -41,6 +43,7 @@ namespace mkr {
         // Skybox textures need to be flipped on the Y-axis due to some stupid OpenGL cubemap convention.
         cubemap* make_cubemap(const std::string& _name, std::array<std::string, num_cubemap_sides> _files, bool _flip_x = false, bool _flip_y = true) {
             if (cubemaps_.contains(_name)) { throw std::runtime_error("duplicate cubemap name"); }
+            memory_scope scope{memory_tag::texture};
             cubemaps_[_name] = texture_loader::load_cubemap(_name, _files, _flip_x, _flip_y);
             return cubemaps_[_name].get();
         }
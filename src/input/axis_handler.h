@@ -1,28 +1,34 @@
 #pragma once
 
-#include <unordered_map>
 #include <unordered_set>
-#include <mutex>
-#include "event/event_dispatcher.h"
+#include "event/event_bus.h"
 #include "input/input.h"
 #include "input/input_event.h"
+#include "input/binding_index.h"
+#include "input/input_registry.h"
+#include "memory/frame_allocator.h"
 
 namespace mkr {
     class axis_handler {
     private:
-        std::mutex reg_mutex_, state_mutex_;
-        std::unordered_map<input_mask_t, std::unordered_set<input_action_t>> registry_;
-        std::unordered_map<input_action_t, float> state_;
+        struct registrations {
+            binding_index axes_;
+            // Support using buttons as positive/negative axes.
+            binding_index positive_buttons_, negative_buttons_;
+        };
 
-        // Support using buttons as positive/negative axes.
-        std::unordered_map<input_mask_t, std::unordered_set<input_action_t>> positive_buttons_, negative_buttons_;
+        input_registry<registrations> registry_;
+
+        // Only touched by the thread that handles input.
+        /// Accumulated over a frame and released by post_events(), so it lives in the frame arena.
+        frame_unordered_map<input_action_t, float> state_;
         std::unordered_set<input_action_t> downed_positives_, downed_negatives_;
 
     public:
         axis_handler() = default;
         virtual ~axis_handler() = default;
 
-        void dispatch_events(event_dispatcher& _event_dispatcher);
+        void post_events(event_bus& _event_bus);
         void on_axis(input_mask_t _input_mask, float _value);
         void register_axis(input_action_t _action, input_mask_t _axis);
         void unregister_axis(input_action_t _action, input_mask_t _axis);
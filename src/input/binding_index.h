@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "input/input.h"
+#include "input/input_helper.h"
+#include "input/keycode.h"
+
+namespace mkr {
+    /**
+     * Input actions registered to input masks, indexed by keycode.
+     * An input mask's context and controller index may have several bits set, so registrations cannot be found by hashing the whole mask.
+     * Instead, the registrations for each keycode are kept in a flat array, and an input only checks the registrations for its own keycode.
+     */
+    class binding_index {
+    private:
+        struct binding {
+            /// The input context in the high 16 bits, and the controller index in the low 16 bits. The top half of an input mask.
+            uint32_t filter_;
+            input_action_t action_;
+
+            inline bool operator==(const binding& _rhs) const = default;
+        };
+
+        std::array<std::vector<binding>, num_keycodes> bindings_;
+
+        static uint32_t filter_of(input_mask_t _input_mask) { return static_cast<uint32_t>(_input_mask >> 32); }
+
+    public:
+        /**
+         * Register an input action to an input mask. Registering the same action to the same mask twice has no effect.
+         * @param _action The input action.
+         * @param _input_mask The input mask.
+         */
+        void add(input_action_t _action, input_mask_t _input_mask) {
+            const auto keycode = input_helper::get_keycode(_input_mask);
+            if (keycode >= num_keycodes) { return; }
+
+            auto& bindings = bindings_[keycode];
+            const binding b{filter_of(_input_mask), _action};
+            if (std::find(bindings.begin(), bindings.end(), b) == bindings.end()) { bindings.push_back(b); }
+        }
+
+        /**
+         * Unregister an input action from an input mask.
+         * @param _action The input action.
+         * @param _input_mask The input mask it was registered to.
+         */
+        void remove(input_action_t _action, input_mask_t _input_mask) {
+            const auto keycode = input_helper::get_keycode(_input_mask);
+            if (keycode >= num_keycodes) { return; }
+            std::erase(bindings_[keycode], binding{filter_of(_input_mask), _action});
+        }
+
+        /**
+         * Call a function for every action registered to a mask that matches an input. See input_helper::compare_mask().
+         * An action registered to several matching masks is passed once for each of them.
+         * @param _input_mask The input's mask.
+         * @param _func Called with each matching input action.
+         */
+        template<typename F>
+        void for_each_action(input_mask_t _input_mask, F&& _func) const {
+            const auto keycode = input_helper::get_keycode(_input_mask);
+            if (keycode >= num_keycodes) { return; }
+
+            const uint32_t filter = filter_of(_input_mask);
+            for (const auto& b : bindings_[keycode]) {
+                // Both the input contexts and the controller indices must share a bit.
+                const uint32_t common = b.filter_ & filter;
+                if ((common & 0xFFFF0000) && (common & 0x0000FFFF)) { _func(b.action_); }
+            }
+        }
+    };
+} // mkr
\ No newline at end of file
@@ -1,85 +1,50 @@
 #include "input/click_handler.h"
-#include "input/input_helper.h"
+#include "memory/frame_allocator.h"
 
 namespace mkr {
-    void click_handler::dispatch_events(event_dispatcher& _event_dispatcher) {
-        std::lock_guard<std::mutex> state_lock{state_mutex_};
-
-        std::unordered_set<input_action_t> down_buttons = curr_state_;
+    void click_handler::post_events(event_bus& _event_bus) {
+        frame_unordered_set<input_action_t> down_buttons{curr_state_.begin(), curr_state_.end()};
         for (auto action : prev_state_) {
             down_buttons.erase(action);
         }
-        std::unordered_set<input_action_t> up_buttons = prev_state_;
+        frame_unordered_set<input_action_t> up_buttons{prev_state_.begin(), prev_state_.end()};
         for (auto action : curr_state_) {
             up_buttons.erase(action);
         }
 
         for (auto action : down_buttons) {
             click_event e{action, button_state::down, positions_[action]};
-            _event_dispatcher.dispatch_event<click_event>(&e);
+            _event_bus.post(e);
         }
         for (auto action : curr_state_) {
             click_event e{action, button_state::pressed, positions_[action]};
-            _event_dispatcher.dispatch_event<click_event>(&e);
+            _event_bus.post(e);
         }
         for (auto action : up_buttons) {
             click_event e{action, button_state::up, positions_[action]};
-            _event_dispatcher.dispatch_event<click_event>(&e);
+            _event_bus.post(e);
         }
 
         prev_state_ = curr_state_;
     }
 
     void click_handler::on_key_down(input_mask_t _input_mask) {
-        std::lock_guard<std::mutex> reg_lock{reg_mutex_};
-        for (const auto& iter : registry_) {
-            if (!input_helper::compare_mask(_input_mask, iter.first)) {
-                continue;
-            }
-
-            const auto& actions = iter.second;
-            std::lock_guard<std::mutex> state_lock{state_mutex_};
-            curr_state_.insert(actions.begin(), actions.end());
-        }
+        registry_.acquire().for_each_action(_input_mask, [&](input_action_t _action) { curr_state_.insert(_action); });
     }
 
     void click_handler::on_key_up(input_mask_t _input_mask) {
-        std::lock_guard<std::mutex> reg_lock{reg_mutex_};
-        for (const auto& iter : registry_) {
-            if (!input_helper::compare_mask(_input_mask, iter.first)) {
-                continue;
-            }
-
-            const auto& actions = iter.second;
-            std::lock_guard<std::mutex> state_lock{state_mutex_};
-            for (auto action : actions) {
-                curr_state_.erase(action);
-            }
-        }
+        registry_.acquire().for_each_action(_input_mask, [&](input_action_t _action) { curr_state_.erase(_action); });
     }
 
     void click_handler::on_motion(input_mask_t _input_mask, vector2 _position) {
-        std::lock_guard<std::mutex> reg_lock{reg_mutex_};
-        for (const auto& iter : registry_) {
-            if (!input_helper::compare_mask(_input_mask, iter.first)) {
-                continue;
-            }
-
-            const auto& actions = iter.second;
-            std::lock_guard<std::mutex> state_lock{state_mutex_};
-            for (auto action : actions) {
-                positions_[action] = _position;
-            }
-        }
+        registry_.acquire().for_each_action(_input_mask, [&](input_action_t _action) { positions_[_action] = _position; });
     }
 
     void click_handler::register_click(input_action_t _action, input_mask_t _click) {
-        std::lock_guard lock{reg_mutex_};
-        registry_[_click].insert(_action);
+        registry_.modify([&](binding_index& _registry) { _registry.add(_action, _click); });
     }
 
     void click_handler::unregister_click(input_action_t _action, input_mask_t _click) {
-        std::lock_guard lock{reg_mutex_};
-        registry_[_click].erase(_action);
+        registry_.modify([&](binding_index& _registry) { _registry.remove(_action, _click); });
     }
 } // mkr
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <log/log.h>
+#include "application/application.h"
+#include "application/command_line.h"
 #include "application/sdl_message_pump.h"
 #include "input/input_helper.h"
 #include "input/input_manager.h"
@@ -6,96 +8,96 @@
 #include "input/sdl_to_controller_index.h"
 
 namespace mkr {
-    void input_manager::sdl_event_callback(const event* _event) {
-        const auto& e = static_cast<const sdl_event*>(_event)->sdl_event_;
+    void input_manager::sdl_event_callback(const sdl_event& _event) {
+        const auto& e = _event.sdl_event_;
+        input_record record{};
         switch (e.type) {
-            // Keyboard
-            case SDL_KEYDOWN: {
-                // Keyboard defaults to controller_index_0.
-                const input_mask_t mask = input_helper::get_input_mask(input_context_, controller_index_0, sdl_to_keycode::from_keyboard_button((SDL_KeyCode) e.key.keysym.sym));
-                button_handler_.on_key_down(mask);
-                axis_handler_.on_key_down(mask);
-            }
+            // Keyboard and mouse default to controller_index_0.
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+                record.type_ = (e.type == SDL_KEYDOWN) ? input_record_type::key_down : input_record_type::key_up;
+                record.controller_index_ = controller_index_0;
+                record.keycode_ = sdl_to_keycode::from_keyboard_button((SDL_KeyCode) e.key.keysym.sym);
                 break;
-            case SDL_KEYUP: {
-                // Keyboard defaults to controller_index_0.
-                const input_mask_t mask = input_helper::get_input_mask(input_context_, controller_index_0, sdl_to_keycode::from_keyboard_button((SDL_KeyCode) e.key.keysym.sym));
-                button_handler_.on_key_up(mask);
-                axis_handler_.on_key_up(mask);
-            }
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                record.type_ = (e.type == SDL_MOUSEBUTTONDOWN) ? input_record_type::mouse_down : input_record_type::mouse_up;
+                record.controller_index_ = controller_index_0;
+                record.keycode_ = sdl_to_keycode::from_mouse_button(e.button.button);
+                break;
+            case SDL_MOUSEMOTION:
+                record.type_ = input_record_type::mouse_motion;
+                record.controller_index_ = controller_index_0;
+                record.buttons_ = e.motion.state;
+                record.position_ = vector2{(float) e.motion.x, (float) e.motion.y};
+                record.delta_ = vector2{(float) e.motion.xrel, (float) e.motion.yrel};
                 break;
 
-            // Mouse
-            case SDL_MOUSEBUTTONDOWN: {
-                // Mouse defaults to controller_index_0.
-                const input_mask_t mask = input_helper::get_input_mask(input_context_, controller_index_0, sdl_to_keycode::from_mouse_button(e.button.button));
-                button_handler_.on_key_down(mask);
-                click_handler_.on_key_down(mask);
-            }
+            // Gamepad
+            case SDL_CONTROLLERAXISMOTION:
+                record.type_ = input_record_type::gamepad_axis;
+                record.controller_index_ = sdl_to_controller_index::from_joystick_id(e.caxis.which);
+                record.keycode_ = sdl_to_keycode::from_gamepad_axis((SDL_GameControllerAxis) e.caxis.axis);
+                // Normalise the axis value to between [-1, 1]. SDL gamepad axis values range is [-32768, 32767].
+                record.value_ = e.caxis.value < 0 ? (float) e.caxis.value / -32768.0f : (float) e.caxis.value / 32767.0f;
                 break;
-            case SDL_MOUSEBUTTONUP: {
-                // Mouse defaults to controller_index_0.
-                const input_mask_t mask = input_helper::get_input_mask(input_context_, controller_index_0, sdl_to_keycode::from_mouse_button(e.button.button));
-                button_handler_.on_key_up(mask);
-                click_handler_.on_key_up(mask);
-            }
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP:
+                record.type_ = (e.type == SDL_CONTROLLERBUTTONDOWN) ? input_record_type::gamepad_down : input_record_type::gamepad_up;
+                record.controller_index_ = sdl_to_controller_index::from_joystick_id(e.cbutton.which);
+                record.keycode_ = sdl_to_keycode::from_gamepad_button((SDL_GameControllerButton) e.cbutton.button);
                 break;
-            case SDL_MOUSEMOTION: {
-                // Mouse defaults to controller_index_0.
-                const vector2 pos{(float) e.motion.x, (float) e.motion.y};
-                const vector2 delta{(float) e.motion.xrel, (float) e.motion.yrel};
+            default:
+                return;
+        }
 
+        if (!pending_records_.try_push(record)) {
+            num_dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void input_manager::handle_record(const input_record& _record) {
+        const auto mask_of = [&](mkr::keycode _keycode) { return input_helper::get_input_mask(input_context_, _record.controller_index_, _keycode); };
+        switch (_record.type_) {
+            case input_record_type::key_down:
+                button_handler_.on_key_down(mask_of(_record.keycode_));
+                axis_handler_.on_key_down(mask_of(_record.keycode_));
+                break;
+            case input_record_type::key_up:
+                button_handler_.on_key_up(mask_of(_record.keycode_));
+                axis_handler_.on_key_up(mask_of(_record.keycode_));
+                break;
+            case input_record_type::mouse_down:
+                button_handler_.on_key_down(mask_of(_record.keycode_));
+                click_handler_.on_key_down(mask_of(_record.keycode_));
+                break;
+            case input_record_type::mouse_up:
+                button_handler_.on_key_up(mask_of(_record.keycode_));
+                click_handler_.on_key_up(mask_of(_record.keycode_));
+                break;
+            case input_record_type::mouse_motion:
                 // Clicks
-                if (e.motion.state & SDL_BUTTON_LMASK) {
-                    click_handler_.on_motion(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_left), pos);
-                }
-                if (e.motion.state & SDL_BUTTON_RMASK) {
-                    click_handler_.on_motion(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_right), pos);
-                }
-                if (e.motion.state & SDL_BUTTON_MMASK) {
-                    click_handler_.on_motion(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_middle), pos);
-                }
-                if (e.motion.state & SDL_BUTTON_X1MASK) {
-                    click_handler_.on_motion(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_x1), pos);
-                }
-                if (e.motion.state & SDL_BUTTON_X2MASK) {
-                    click_handler_.on_motion(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_x2), pos);
-                }
+                if (_record.buttons_ & SDL_BUTTON_LMASK) { click_handler_.on_motion(mask_of(kc_mouse_left), _record.position_); }
+                if (_record.buttons_ & SDL_BUTTON_RMASK) { click_handler_.on_motion(mask_of(kc_mouse_right), _record.position_); }
+                if (_record.buttons_ & SDL_BUTTON_MMASK) { click_handler_.on_motion(mask_of(kc_mouse_middle), _record.position_); }
+                if (_record.buttons_ & SDL_BUTTON_X1MASK) { click_handler_.on_motion(mask_of(kc_mouse_x1), _record.position_); }
+                if (_record.buttons_ & SDL_BUTTON_X2MASK) { click_handler_.on_motion(mask_of(kc_mouse_x2), _record.position_); }
 
                 // Axis
-                axis_handler_.on_axis(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_axis_x), delta.x_);
-                axis_handler_.on_axis(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_axis_y), delta.y_);
+                axis_handler_.on_axis(mask_of(kc_mouse_axis_x), _record.delta_.x_);
+                axis_handler_.on_axis(mask_of(kc_mouse_axis_y), _record.delta_.y_);
 
                 // Motion
-                motion_handler_.on_motion(input_helper::get_input_mask(input_context_, controller_index_0, kc_mouse_motion), pos, delta);
-            }
+                motion_handler_.on_motion(mask_of(kc_mouse_motion), _record.position_, _record.delta_);
                 break;
-
-            // Gamepad
-            case SDL_CONTROLLERAXISMOTION: {
-                // Normalise the axis value to between [-1, 1]. SDL gamepad axis values range is [-32768, 32767].
-                const auto value = e.caxis.value < 0 ? (float) e.caxis.value / -32768.0f : (float) e.caxis.value / 32767.0f;
-                const input_mask_t mask = input_helper::get_input_mask(input_context_,
-                                                                       sdl_to_controller_index::from_joystick_id(e.caxis.which),
-                                                                       sdl_to_keycode::from_gamepad_axis((SDL_GameControllerAxis) e.caxis.axis));
-                axis_handler_.on_axis(mask, value);
-            }
+            case input_record_type::gamepad_axis:
+                axis_handler_.on_axis(mask_of(_record.keycode_), _record.value_);
                 break;
-            case SDL_CONTROLLERBUTTONDOWN: {
-                const input_mask_t mask = input_helper::get_input_mask(input_context_,
-                                                                       sdl_to_controller_index::from_joystick_id(e.cbutton.which),
-                                                                       sdl_to_keycode::from_gamepad_button((SDL_GameControllerButton) e.cbutton.button));
-                button_handler_.on_key_down(mask);
-            }
-                break;
-            case SDL_CONTROLLERBUTTONUP: {
-                const input_mask_t mask = input_helper::get_input_mask(input_context_,
-                                                                       sdl_to_controller_index::from_joystick_id(e.cbutton.which),
-                                                                       sdl_to_keycode::from_gamepad_button((SDL_GameControllerButton) e.cbutton.button));
-                button_handler_.on_key_up(mask);
-            }
+            case input_record_type::gamepad_down:
+                button_handler_.on_key_down(mask_of(_record.keycode_));
                 break;
-            default:
+            case input_record_type::gamepad_up:
+                button_handler_.on_key_up(mask_of(_record.keycode_));
                 break;
         }
     }
@@ -110,18 +112,53 @@ namespace mkr {
         SDL_JoystickEventState(SDL_ENABLE);
         SDL_GameControllerEventState(SDL_ENABLE);
 
-        sdl_event_listener.set_callback(std::bind(&input_manager::sdl_event_callback, this, std::placeholders::_1));
-        sdl_message_pump::instance().get_event_dispatcher().add_listener<sdl_event>(&sdl_event_listener);
+        // Replays run at the fixed delta time they were recorded with, so that every replay steps the simulation the same way.
+        const auto& cmd = command_line::instance();
+        if (cmd.has("replay")) {
+            replayer_ = std::make_unique<input_replayer>(cmd.get_string("replay"));
+            application::instance().set_fixed_delta_time(replayer_->fixed_delta_time());
+            application::instance().set_fixed_frame_time(true);
+            if (cmd.has("record")) { MKR_CORE_WARN("--record is ignored when replaying"); }
+        } else if (cmd.has("record")) {
+            recorder_ = std::make_unique<input_recorder>(cmd.get_string("record"), application::instance().fixed_delta_time());
+        }
+
+        sdl_message_pump::instance().get_event_dispatcher().add_listener<sdl_event>(&sdl_event_listener, [this](const sdl_event& _event) { sdl_event_callback(_event); });
     }
 
     void input_manager::update() {
-        button_handler_.dispatch_events(input_event_dispatcher_);
-        axis_handler_.dispatch_events(input_event_dispatcher_);
-        click_handler_.dispatch_events(input_event_dispatcher_);
-        motion_handler_.dispatch_events(input_event_dispatcher_);
+        const uint32_t frame = frame_++;
+        auto& bus = event_bus::instance();
+
+        // Live input is thrown away during a replay, so that the recording is the only input.
+        input_record record;
+        if (replayer_) {
+            while (pending_records_.try_pop(record)) {}
+            replayer_->post_frame(frame, bus);
+            if (replayer_->finished()) {
+                MKR_CORE_INFO("Input replay finished after {} frames", frame + 1);
+                replayer_.reset();
+                application::instance().terminate();
+            }
+            return;
+        }
+
+        if (recorder_) { recorder_->begin_frame(frame, application::instance().time_elapsed()); }
+        while (pending_records_.try_pop(record)) { handle_record(record); }
+
+        if (const auto num_dropped = num_dropped_records_.exchange(0, std::memory_order_relaxed); num_dropped > 0) {
+            MKR_CORE_WARN("Input record ring is full, {} input events were dropped", num_dropped);
+        }
+
+        button_handler_.post_events(bus);
+        axis_handler_.post_events(bus);
+        click_handler_.post_events(bus);
+        motion_handler_.post_events(bus);
     }
 
     void input_manager::exit() {
+        recorder_.reset();
+        replayer_.reset();
         sdl_message_pump::instance().get_event_dispatcher().remove_listener<sdl_event>(&sdl_event_listener);
         SDL_QuitSubSystem(SDL_INIT_GAMECONTROLLER | SDL_INIT_JOYSTICK | SDL_INIT_HAPTIC);
     }
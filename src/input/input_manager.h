@@ -1,26 +1,46 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <SDL2/SDL.h>
 #include <common/singleton.h>
+#include "util/spsc_ring.h"
 #include "input/keycode.h"
+#include "input/input_record.h"
+#include "input/input_recording.h"
 #include "input/button_handler.h"
 #include "input/axis_handler.h"
 #include "input/click_handler.h"
 #include "input/motion_handler.h"
 
 namespace mkr {
+    class sdl_event;
+
     /**
      * The input manager is an interface for the user to register input actions to an input event.
      * This abstracts away the need for the game code to know the exact type of input device that is being used.
-     * The 4 event types are button, axis, click and motion.
+     * The 4 event types are button, axis, click and motion. Input events are posted to the event_bus once per frame.
      */
     class input_manager : public singleton<input_manager> {
         friend class singleton<input_manager>;
 
     private:
+        /// The most input records that can wait to be handled. Records that arrive when the ring is full are dropped.
+        static constexpr size_t max_pending_records = 4096;
+
         input_context input_context_ = input_context_default;
         event_listener sdl_event_listener;
-        event_dispatcher input_event_dispatcher_;
+
+        /// Filled by sdl_event_callback(), and emptied once a frame by update().
+        spsc_ring<input_record, max_pending_records> pending_records_;
+        std::atomic<uint32_t> num_dropped_records_ = 0;
+
+        /// Counts the frames since init(), so that recordings and replays line up.
+        uint32_t frame_ = 0;
+        /// Set with --record=<file>. Writes the input events posted every frame.
+        std::unique_ptr<input_recorder> recorder_;
+        /// Set with --replay=<file>. Posts the events of a recording in place of live input.
+        std::unique_ptr<input_replayer> replayer_;
 
         button_handler button_handler_;
         axis_handler axis_handler_;
@@ -31,11 +51,15 @@ namespace mkr {
 
         virtual ~input_manager() = default;
 
-        void sdl_event_callback(const event* _event);
+        /// Translate an SDL event into an input record, and queue it to be handled by update().
+        void sdl_event_callback(const sdl_event& _event);
+        /// Pass an input record to the input handlers, under the current input context.
+        void handle_record(const input_record& _record);
 
     public:
         void init();
 
+        /// Handle the input records queued since the last update, and post the resulting input events to the event bus, to be delivered at event_phase::input.
         void update();
 
         void exit();
@@ -56,19 +80,8 @@ namespace mkr {
          */
         inline input_context get_input_context() const { return input_context_; }
 
-        /**
-         * Get the event dispatcher. Input events will be dispatched via this dispatcher.
-         * @return The event dispatcher.
-         * @see input_event.h
-         */
-        inline event_dispatcher* get_event_dispatcher() { return &input_event_dispatcher_; }
-
-        /**
-         * Get the event dispatcher. Input events will be dispatched via this dispatcher.
-         * @return The event dispatcher.
-         * @see input_event.h
-         */
-        inline const event_dispatcher* get_event_dispatcher() const { return &input_event_dispatcher_; }
+        /// Whether the input comes from a recording rather than from the input devices.
+        [[nodiscard]] inline bool replaying() const { return replayer_ != nullptr; }
 
         /**
          * In relative mode, the cursor is hidden, the mouse position is constrained to the window,
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <maths/vector2.h>
+#include "input/input.h"
+#include "input/keycode.h"
+
+namespace mkr {
+    enum class input_record_type : uint8_t {
+        key_down,
+        key_up,
+        mouse_down,
+        mouse_up,
+        mouse_motion,
+        gamepad_axis,
+        gamepad_down,
+        gamepad_up,
+    };
+
+    /**
+     * A raw input event, as read from SDL, waiting to be handled by the input manager.
+     * The input context is applied when the record is handled, so the record does not depend on state owned by the thread handling input.
+     */
+    struct input_record {
+        input_record_type type_;
+        controller_index controller_index_;
+        mkr::keycode keycode_;
+        /// The SDL mask of the mouse buttons held during a mouse motion.
+        uint32_t buttons_;
+        /// The normalised value of a gamepad axis.
+        float value_;
+        vector2 position_;
+        vector2 delta_;
+    };
+} // mkr
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <stdexcept>
+#include <type_traits>
+#include <log/log.h>
+#include "input/input_recording.h"
+
+namespace mkr {
+    namespace {
+        constexpr uint32_t magic = 0x49524B4D; // "MKRI"
+        constexpr uint32_t version = 2;
+        /// The offset of the number of frames in the header, after the magic number, the version and the fixed delta time.
+        constexpr std::streamoff num_frames_offset = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(float);
+
+        template<typename T>
+        void write_value(std::ostream& _stream, const T& _value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            _stream.write(reinterpret_cast<const char*>(&_value), sizeof(T));
+        }
+
+        template<typename T>
+        T read_value(std::istream& _stream) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            _stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+            if (!_stream) { throw std::runtime_error("unexpected end of input recording"); }
+            return value;
+        }
+    }
+
+    input_recorder::input_recorder(const std::string& _filename, float _fixed_delta_time)
+        : stream_(_filename, std::ios::binary | std::ios::trunc) {
+        if (!stream_) {
+            const std::string err_msg = "failed to open input recording " + _filename;
+            MKR_CORE_ERROR(err_msg);
+            throw std::runtime_error(err_msg);
+        }
+        write_value(stream_, magic);
+        write_value(stream_, version);
+        write_value(stream_, _fixed_delta_time);
+        write_value(stream_, num_frames_); // Patched in the destructor.
+
+        // The input manager posts its events before the input phase, so every event is recorded on the frame it was posted.
+        auto& bus = event_bus::instance();
+        bus.subscribe<button_event>(&listener_, event_phase::input, [this](std::span<const button_event> _events) {
+            for (const auto& e : _events) { record(e); }
+        });
+        bus.subscribe<axis_event>(&listener_, event_phase::input, [this](std::span<const axis_event> _events) {
+            for (const auto& e : _events) { record(e); }
+        });
+        bus.subscribe<click_event>(&listener_, event_phase::input, [this](std::span<const click_event> _events) {
+            for (const auto& e : _events) { record(e); }
+        });
+        bus.subscribe<motion_event>(&listener_, event_phase::input, [this](std::span<const motion_event> _events) {
+            for (const auto& e : _events) { record(e); }
+        });
+    }
+
+    input_recorder::~input_recorder() {
+        auto& bus = event_bus::instance();
+        bus.unsubscribe<button_event>(&listener_);
+        bus.unsubscribe<axis_event>(&listener_);
+        bus.unsubscribe<click_event>(&listener_);
+        bus.unsubscribe<motion_event>(&listener_);
+
+        // Replays run until the last recorded frame, not just until the last event, so that the frames with no input after it are replayed too.
+        stream_.seekp(num_frames_offset);
+        write_value(stream_, num_frames_);
+        if (!stream_) { MKR_CORE_ERROR("failed to write input recording"); }
+    }
+
+    void input_recorder::write(const recorded_input& _input) {
+        write_value(stream_, _input);
+        if (!stream_) { MKR_CORE_ERROR("failed to write input recording"); }
+    }
+
+    void input_recorder::record(const button_event& _event) {
+        write({frame_, timestamp_, _event.action_, recorded_input_type::button, static_cast<uint8_t>(_event.state_)});
+    }
+
+    void input_recorder::record(const axis_event& _event) {
+        write({frame_, timestamp_, _event.action_, recorded_input_type::axis, 0, 0, {_event.value_}});
+    }
+
+    void input_recorder::record(const click_event& _event) {
+        write({frame_, timestamp_, _event.action_, recorded_input_type::click, static_cast<uint8_t>(_event.state_), 0,
+               {_event.position_.x_, _event.position_.y_}});
+    }
+
+    void input_recorder::record(const motion_event& _event) {
+        write({frame_, timestamp_, _event.action_, recorded_input_type::motion, 0, 0,
+               {_event.position_.x_, _event.position_.y_, _event.delta_.x_, _event.delta_.y_}});
+    }
+
+    input_replayer::input_replayer(const std::string& _filename) {
+        std::ifstream stream(_filename, std::ios::binary);
+        if (!stream) {
+            const std::string err_msg = "failed to open input recording " + _filename;
+            MKR_CORE_ERROR(err_msg);
+            throw std::runtime_error(err_msg);
+        }
+        if (read_value<uint32_t>(stream) != magic) { throw std::runtime_error("invalid input recording"); }
+        if (read_value<uint32_t>(stream) != version) { throw std::runtime_error("unsupported input recording version"); }
+        fixed_delta_time_ = read_value<float>(stream);
+        num_frames_ = read_value<uint32_t>(stream);
+
+        recorded_input input;
+        while (stream.read(reinterpret_cast<char*>(&input), sizeof(input))) {
+            inputs_.push_back(input);
+        }
+        MKR_CORE_INFO("Loaded input recording {} with {} events over {} frames", _filename, inputs_.size(), num_frames_);
+    }
+
+    void input_replayer::post_frame(uint32_t _frame, event_bus& _event_bus) {
+        num_frames_posted_ = _frame + 1;
+        for (; next_ < inputs_.size() && inputs_[next_].frame_ <= _frame; ++next_) {
+            const auto& input = inputs_[next_];
+            const auto* v = input.values_;
+            switch (input.type_) {
+                case recorded_input_type::button:
+                    _event_bus.post(button_event{input.action_, static_cast<button_state>(input.state_)});
+                    break;
+                case recorded_input_type::axis:
+                    _event_bus.post(axis_event{input.action_, v[0]});
+                    break;
+                case recorded_input_type::click:
+                    _event_bus.post(click_event{input.action_, static_cast<button_state>(input.state_), vector2{v[0], v[1]}});
+                    break;
+                case recorded_input_type::motion:
+                    _event_bus.post(motion_event{input.action_, vector2{v[0], v[1]}, vector2{v[2], v[3]}});
+                    break;
+            }
+        }
+    }
+} // mkr
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "event/event_bus.h"
+#include "input/input.h"
+#include "input/input_event.h"
+
+namespace mkr {
+    enum class recorded_input_type : uint8_t {
+        button,
+        axis,
+        click,
+        motion,
+    };
+
+    /**
+     * Input recordings store the input events posted by the input manager, after the physical inputs have been mapped to input actions.
+     * The file contains a header, with the magic number, the version, the fixed delta time the recording was made with and the number of frames recorded,
+     * followed by one recorded_input per event, in the order the events were posted.
+     * Replaying a recording posts the same events on the same frames, so that runs of the application can be reproduced.
+     */
+    struct recorded_input {
+        /// The frame the event was posted on, counted from the first frame of the recording.
+        uint32_t frame_;
+        /// The time the event was posted, in seconds since the application started.
+        float timestamp_;
+        input_action_t action_;
+        recorded_input_type type_;
+        /// The button_state of button and click events.
+        uint8_t state_;
+        uint16_t padding_ = 0;
+        /// The value of axis events, the position of click events, or the position and delta of motion events.
+        float values_[4] = {};
+    };
+    static_assert(sizeof(recorded_input) == 32, "recorded_input is written to file as is, so its layout must not change");
+
+    /// Writes the input events posted each frame to an input recording.
+    class input_recorder {
+    private:
+        std::ofstream stream_;
+        event_listener listener_;
+        uint32_t frame_ = 0;
+        float timestamp_ = 0.0f;
+        /// Written to the header when the recording is closed, as it is not known until then.
+        uint32_t num_frames_ = 0;
+
+        void write(const recorded_input& _input);
+
+    public:
+        /**
+         * Create a recording. Throws std::runtime_error if the file cannot be opened.
+         * @param _filename The file to write.
+         * @param _fixed_delta_time The application's fixed delta time, stored so that the recording is replayed with the same simulation step.
+         */
+        input_recorder(const std::string& _filename, float _fixed_delta_time);
+        ~input_recorder();
+
+        /**
+         * Set the frame and time that the events posted from now on are recorded with.
+         * @param _frame The frame, counted from the first frame of the recording.
+         * @param _timestamp The time in seconds since the application started.
+         */
+        inline void begin_frame(uint32_t _frame, float _timestamp) {
+            frame_ = _frame;
+            timestamp_ = _timestamp;
+            num_frames_ = _frame + 1;
+        }
+
+        void record(const button_event& _event);
+        void record(const axis_event& _event);
+        void record(const click_event& _event);
+        void record(const motion_event& _event);
+    };
+
+    /// Posts the input events of an input recording on the frames they were recorded on.
+    class input_replayer {
+    private:
+        std::vector<recorded_input> inputs_;
+        size_t next_ = 0;
+        float fixed_delta_time_ = 0.0f;
+        uint32_t num_frames_ = 0;
+        uint32_t num_frames_posted_ = 0;
+
+    public:
+        /**
+         * Load a recording. Throws std::runtime_error if the file cannot be read, or is not an input recording.
+         * @param _filename The file to read.
+         */
+        explicit input_replayer(const std::string& _filename);
+
+        /// The fixed delta time the recording was made with.
+        [[nodiscard]] inline float fixed_delta_time() const { return fixed_delta_time_; }
+
+        /// The number of frames recorded, including the frames after the last event.
+        [[nodiscard]] inline uint32_t num_frames() const { return num_frames_; }
+
+        /// Whether every recorded frame has been posted.
+        [[nodiscard]] inline bool finished() const { return next_ >= inputs_.size() && num_frames_posted_ >= num_frames_; }
+
+        /**
+         * Post the events recorded on a frame.
+         * @param _frame The frame, counted from the first frame of the replay.
+         * @param _event_bus The event bus to post to.
+         */
+        void post_frame(uint32_t _frame, event_bus& _event_bus);
+    };
+} // mkr
\ No newline at end of file
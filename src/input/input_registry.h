@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace mkr {
+    /**
+     * Input registrations, published as copy-on-write snapshots.
+     * Registering copies the latest snapshot, changes the copy, and publishes it. Only registration takes a lock, to order concurrent registrations.
+     * The input handlers read the registrations on every input event, so acquire() only checks an atomic version number, and picks up the new snapshot when it has changed.
+     * @tparam T The registrations.
+     */
+    template<typename T>
+    class input_registry {
+    private:
+        // Registration side.
+        std::mutex mutex_;
+        std::shared_ptr<const T> latest_ = std::make_shared<const T>();
+        std::atomic<std::shared_ptr<const T>> published_{latest_};
+        std::atomic<uint64_t> version_ = 0;
+
+        // Input handling side.
+        std::shared_ptr<const T> active_ = latest_;
+        uint64_t active_version_ = 0;
+
+    public:
+        /**
+         * Change the registrations. May be called from any thread.
+         * @param _modify Called with a copy of the latest registrations to change.
+         */
+        template<typename F>
+        void modify(F&& _modify) {
+            std::lock_guard lock{mutex_};
+            auto next = std::make_shared<T>(*latest_);
+            _modify(*next);
+            latest_ = next;
+            published_.store(std::move(next), std::memory_order_release);
+            version_.fetch_add(1, std::memory_order_release);
+        }
+
+        /**
+         * Get the latest registrations. Must only be called from the thread that handles input.
+         * The reference is valid until the next call to acquire().
+         */
+        const T& acquire() {
+            const uint64_t version = version_.load(std::memory_order_acquire);
+            if (version != active_version_) {
+                active_ = published_.load(std::memory_order_acquire);
+                active_version_ = version;
+            }
+            return *active_;
+        }
+    };
+} // mkr
\ No newline at end of file
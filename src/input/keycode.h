@@ -309,5 +309,7 @@ namespace mkr {
         /********************************** Motion (For Motion Handler) **********************************/
         // Mouse Motion
         kc_mouse_motion,
+
+        num_keycodes,
     };
 } // mkr
\ No newline at end of file
@@ -1,40 +1,27 @@
 #include "input/motion_handler.h"
-#include "input/input_helper.h"
 
 namespace mkr {
-    void motion_handler::dispatch_events(event_dispatcher& _event_dispatcher) {
-        std::lock_guard state_lock{state_mutex_};
+    void motion_handler::post_events(event_bus& _event_bus) {
         for (auto iter : state_) {
             motion_event e{iter.first, iter.second.position_, iter.second.delta_};
-            _event_dispatcher.dispatch_event<motion_event>(&e);
+            _event_bus.post(e);
         }
-        state_.clear();
+        state_ = decltype(state_){};
     }
 
     void motion_handler::on_motion(input_mask_t _input_mask, vector2 _position, vector2 _delta) {
-        std::lock_guard reg_lock{reg_mutex_};
-        for (const auto& iter : registry_) {
-            if (!input_helper::compare_mask(_input_mask, iter.first)) {
-                continue;
-            }
-
-            const auto& actions = iter.second;
-            std::lock_guard state_lock{state_mutex_};
-            for (auto action : actions) {
-                auto& m = state_[action];
-                m.position_ = _position;
-                m.delta_ += _delta;
-            }
-        }
+        registry_.acquire().for_each_action(_input_mask, [&](input_action_t _action) {
+            auto& m = state_[_action];
+            m.position_ = _position;
+            m.delta_ += _delta;
+        });
     }
 
     void motion_handler::register_motion(input_action_t _input_action, input_mask_t _input_mask) {
-        std::lock_guard lock{reg_mutex_};
-        registry_[_input_mask].insert(_input_action);
+        registry_.modify([&](binding_index& _registry) { _registry.add(_input_action, _input_mask); });
     }
 
     void motion_handler::unregister_motion(input_action_t _input_action, input_mask_t _input_mask) {
-        std::lock_guard lock{reg_mutex_};
-        registry_[_input_mask].erase(_input_action);
+        registry_.modify([&](binding_index& _registry) { _registry.remove(_input_action, _input_mask); });
     }
 } // mkr
\ No newline at end of file
@@ -1,26 +1,26 @@
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
-#include <mutex>
-#include "event/event_dispatcher.h"
+#include "event/event_bus.h"
 #include "input/input.h"
 #include "input/input_event.h"
+#include "input/binding_index.h"
+#include "input/input_registry.h"
+#include "memory/frame_allocator.h"
 
 namespace mkr {
     class motion_handler {
     private:
         struct motion_data { vector2 position_, delta_; };
 
-        std::unordered_map<input_mask_t, std::unordered_set<input_action_t>> registry_;
-        std::unordered_map<input_action_t, motion_data> state_;
-        std::mutex reg_mutex_, state_mutex_;
+        input_registry<binding_index> registry_;
+        /// Accumulated over a frame and released by post_events(), so it lives in the frame arena. Only touched by the thread that handles input.
+        frame_unordered_map<input_action_t, motion_data> state_;
 
     public:
         motion_handler() = default;
         virtual ~motion_handler() = default;
 
-        void dispatch_events(event_dispatcher& _event_dispatcher);
+        void post_events(event_bus& _event_bus);
         void on_motion(input_mask_t _input_mask, vector2 _position, vector2 _delta);
         void register_motion(input_action_t _action, input_mask_t _motion);
         void unregister_motion(input_action_t _action, input_mask_t _motion);
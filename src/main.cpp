@@ -1,6 +1,8 @@
 #include "application/application.h"
+#include "application/command_line.h"
 
 int main(int _argc, char* _argv[]) {
+    mkr::command_line::instance().parse(_argc, _argv);
     mkr::application::instance().run();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,43 @@
+#include <new>
+#include "memory/allocation_counter.h"
+#include "memory/memory_tracker.h"
+
+namespace mkr {
+    namespace {
+        thread_local uint64_t num_thread_allocations = 0;
+
+        /// Charged to the calling thread's current memory_tag, so that the tracker sees every allocation made through the global operator new.
+        void* counted_alloc(std::size_t _size) {
+            ++num_thread_allocations;
+            if (void* ptr = memory_tracker::allocate(_size == 0 ? 1 : _size, memory_tracker::current_tag())) { return ptr; }
+            throw std::bad_alloc{};
+        }
+
+        void* counted_aligned_alloc(std::size_t _size, std::align_val_t _alignment) {
+            ++num_thread_allocations;
+            if (void* ptr = memory_tracker::allocate_aligned(_size == 0 ? 1 : _size, static_cast<std::size_t>(_alignment), memory_tracker::current_tag())) { return ptr; }
+            throw std::bad_alloc{};
+        }
+    }
+
+    uint64_t allocation_counter::thread_count() {
+        return num_thread_allocations;
+    }
+} // mkr
+
+void* operator new(std::size_t _size) { return mkr::counted_alloc(_size); }
+void* operator new[](std::size_t _size) { return mkr::counted_alloc(_size); }
+void* operator new(std::size_t _size, std::align_val_t _alignment) { return mkr::counted_aligned_alloc(_size, _alignment); }
+void* operator new[](std::size_t _size, std::align_val_t _alignment) { return mkr::counted_aligned_alloc(_size, _alignment); }
+void* operator new(std::size_t _size, const std::nothrow_t&) noexcept { try { return mkr::counted_alloc(_size); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t _size, const std::nothrow_t&) noexcept { try { return mkr::counted_alloc(_size); } catch (...) { return nullptr; } }
+
+// The tracker's header records how the memory was allocated, so every form of delete frees the same way.
+void operator delete(void* _ptr) noexcept { mkr::memory_tracker::deallocate(_ptr); }
+void operator delete[](void* _ptr) noexcept { mkr::memory_tracker::deallocate(_ptr); }
+void operator delete(void* _ptr, std::size_t) noexcept { mkr::memory_tracker::deallocate(_ptr); }
+void operator delete[](void* _ptr, std::size_t) noexcept { mkr::memory_tracker::deallocate(_ptr); }
+void operator delete(void* _ptr, std::align_val_t) noexcept { mkr::memory_tracker::deallocate(_ptr); }
+void operator delete[](void* _ptr, std::align_val_t) noexcept { mkr::memory_tracker::deallocate(_ptr); }
+void operator delete(void* _ptr, std::size_t, std::align_val_t) noexcept { mkr::memory_tracker::deallocate(_ptr); }
+void operator delete[](void* _ptr, std::size_t, std::align_val_t) noexcept { mkr::memory_tracker::deallocate(_ptr); }
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mkr {
+    /**
+     * Counts heap allocations made through the global operator new.
+     * Used to check that steady-state frames do not allocate.
+     */
+    class allocation_counter {
+    public:
+        allocation_counter() = delete;
+
+        /// The number of heap allocations made by the calling thread so far.
+        static uint64_t thread_count();
+    };
+} // mkr
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "memory/linear_arena.h"
+
+namespace mkr {
+    /**
+     * Each thread has its own arena for data that only lives for one frame.
+     * The arena is reset by the application at the end of every frame, so frame containers must be emptied or destroyed before then,
+     * and must only be used on threads that reset their arena.
+     */
+    class frame_arena {
+    public:
+        frame_arena() = delete;
+
+        static linear_arena& local() {
+            thread_local linear_arena arena;
+            return arena;
+        }
+    };
+
+    /// An STL allocator that allocates from the calling thread's frame arena.
+    template<typename T>
+    class frame_allocator {
+    public:
+        using value_type = T;
+
+        frame_allocator() noexcept = default;
+
+        template<typename U>
+        frame_allocator(const frame_allocator<U>&) noexcept {}
+
+        [[nodiscard]] T* allocate(size_t _n) {
+            return static_cast<T*>(frame_arena::local().allocate(_n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* _ptr, size_t _n) noexcept {
+            frame_arena::local().deallocate(_ptr, _n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(const frame_allocator<U>&) const noexcept { return true; }
+    };
+
+    template<typename T>
+    using frame_vector = std::vector<T, frame_allocator<T>>;
+
+    template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    using frame_unordered_map = std::unordered_map<Key, Value, Hash, KeyEqual, frame_allocator<std::pair<const Key, Value>>>;
+
+    template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    using frame_unordered_set = std::unordered_set<Key, Hash, KeyEqual, frame_allocator<Key>>;
+} // mkr
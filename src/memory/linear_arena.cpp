@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include "memory/linear_arena.h"
+#include "memory/memory_tracker.h"
+
+namespace mkr {
+    void linear_arena::add_block(size_t _min_size) {
+        memory_scope scope{memory_tag::frame_arena};
+        if (!blocks_.empty()) {
+            used_in_previous_blocks_ += static_cast<size_t>(top_ - blocks_.back().get());
+        }
+
+        const size_t size = std::bit_ceil(std::max({_min_size, min_block_size_, block_sizes_.empty() ? 0 : block_sizes_.back() * 2}));
+        blocks_.push_back(std::make_unique<std::byte[]>(size));
+        block_sizes_.push_back(size);
+        top_ = blocks_.back().get();
+        end_ = top_ + size;
+    }
+
+    void* linear_arena::allocate(size_t _size, size_t _alignment) {
+        auto align = [&](std::byte* _ptr) {
+            const auto address = reinterpret_cast<std::uintptr_t>(_ptr);
+            return _ptr + ((_alignment - (address & (_alignment - 1))) & (_alignment - 1));
+        };
+
+        std::byte* ptr = align(top_);
+        if (blocks_.empty() || ptr + _size > end_) {
+            add_block(_size + _alignment);
+            ptr = align(top_);
+        }
+        top_ = ptr + _size;
+        peak_ = std::max(peak_, used());
+        return ptr;
+    }
+
+    void linear_arena::deallocate(void* _ptr, size_t _size) {
+        if (static_cast<std::byte*>(_ptr) + _size == top_) {
+            top_ = static_cast<std::byte*>(_ptr);
+        }
+    }
+
+    void linear_arena::reset() {
+        // Merge the blocks into one, so that the next frame fits without chaining.
+        if (blocks_.size() > 1) {
+            const size_t total = capacity();
+            blocks_.clear();
+            block_sizes_.clear();
+            used_in_previous_blocks_ = 0;
+            add_block(total);
+        }
+
+        used_in_previous_blocks_ = 0;
+        top_ = blocks_.empty() ? nullptr : blocks_.back().get();
+    }
+
+    size_t linear_arena::capacity() const {
+        size_t total = 0;
+        for (auto size : block_sizes_) { total += size; }
+        return total;
+    }
+} // mkr
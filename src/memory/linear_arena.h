@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mkr {
+    /**
+     * A bump allocator. Allocating advances a pointer, and everything is released at once by reset().
+     * When the current block runs out, a new block is chained on. On reset(), chained blocks are merged into a single block
+     * large enough for everything allocated since the last reset, so that a steady workload stops touching the heap after a few resets.
+     */
+    class linear_arena {
+    private:
+        /// The minimum size of a block.
+        static constexpr size_t min_block_size_ = 1024 * 1024;
+
+        std::vector<std::unique_ptr<std::byte[]>> blocks_;
+        std::vector<size_t> block_sizes_;
+        std::byte* top_ = nullptr;
+        std::byte* end_ = nullptr;
+        /// Bytes used in the blocks before the current one.
+        size_t used_in_previous_blocks_ = 0;
+        /// The most bytes that have been in use at once since the arena was created. Not cleared by reset(), so that it can be read after a frame's reset.
+        size_t peak_ = 0;
+
+        void add_block(size_t _min_size);
+
+    public:
+        linear_arena() = default;
+        linear_arena(const linear_arena&) = delete;
+        linear_arena& operator=(const linear_arena&) = delete;
+        virtual ~linear_arena() = default;
+
+        /**
+         * Allocate memory from the arena. The memory stays valid until the next reset().
+         * @param _size The size of the allocation in bytes.
+         * @param _alignment The alignment of the allocation. Must be a power of 2.
+         * @return The allocated memory.
+         */
+        void* allocate(size_t _size, size_t _alignment = alignof(std::max_align_t));
+
+        /**
+         * Memory is only really released by reset(). However, if this was the latest allocation, the space is reclaimed right away.
+         * A growing vector gains nothing from this, as its old buffer is freed after the new one has been allocated above it, so reserve frame vectors up front.
+         * @param _ptr The memory to deallocate.
+         * @param _size The size of the allocation in bytes.
+         */
+        void deallocate(void* _ptr, size_t _size);
+
+        /// Release every allocation. Nothing allocated from the arena may be used afterwards.
+        void reset();
+
+        /// The number of bytes currently in use.
+        [[nodiscard]] inline size_t used() const { return used_in_previous_blocks_ + static_cast<size_t>(top_ - (blocks_.empty() ? top_ : blocks_.back().get())); }
+
+        /// The most bytes that have been in use at once since the arena was created, such as by the busiest frame so far.
+        [[nodiscard]] inline size_t peak() const { return peak_; }
+
+        /// The number of bytes reserved from the heap.
+        [[nodiscard]] size_t capacity() const;
+    };
+} // mkr
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#include <flecs.h>
+#include <log/log.h>
+#include "memory/memory_tracker.h"
+
+namespace mkr {
+    namespace {
+        constexpr size_t num_tags = static_cast<size_t>(memory_tag::num_memory_tags);
+        constexpr size_t num_gpu_tags = static_cast<size_t>(gpu_memory_tag::num_gpu_memory_tags);
+
+        const char* tag_names[num_tags] = {"untagged", "mesh", "texture", "renderer", "frame_arena", "ecs"};
+        const char* gpu_tag_names[num_gpu_tags] = {"vertex_buffer", "index_buffer", "texture", "cubemap", "framebuffer"};
+
+        /// Kept in front of every allocation. It is 16 bytes, so that memory from malloc stays aligned for any type.
+        struct allocation_header {
+            uint64_t size_;
+            /// The distance from the start of the underlying allocation to the memory handed out.
+            uint32_t offset_;
+            memory_tag tag_;
+        };
+        static_assert(sizeof(allocation_header) == 16);
+        constexpr size_t header_size = sizeof(allocation_header);
+
+        /// Updated by every thread. The counters are independent, so relaxed ordering is enough.
+        struct tag_counters {
+            std::atomic<int64_t> current_{0};
+            std::atomic<int64_t> peak_{0};
+            std::atomic<uint64_t> num_allocations_{0};
+            std::atomic<uint64_t> total_bytes_{0};
+        };
+
+        /// Only touched by update() and the budget setters, on the main thread.
+        struct tag_report {
+            uint64_t prev_total_bytes_ = 0;
+            double allocation_rate_ = 0.0;
+            uint64_t budget_ = 0;
+            bool over_budget_ = false;
+        };
+
+        // Constant initialised, so they are ready before any static constructor allocates.
+        tag_counters counters[num_tags];
+        tag_counters gpu_counters[num_gpu_tags];
+        tag_report reports[num_tags];
+        tag_report gpu_reports[num_gpu_tags];
+        float time_since_report = 0.0f;
+
+        thread_local memory_tag current_thread_tag = memory_tag::untagged;
+
+        void record_allocation(tag_counters& _counters, size_t _bytes) {
+            const int64_t current = _counters.current_.fetch_add(static_cast<int64_t>(_bytes), std::memory_order_relaxed) + static_cast<int64_t>(_bytes);
+            _counters.num_allocations_.fetch_add(1, std::memory_order_relaxed);
+            _counters.total_bytes_.fetch_add(_bytes, std::memory_order_relaxed);
+            int64_t peak = _counters.peak_.load(std::memory_order_relaxed);
+            while (current > peak && !_counters.peak_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+        }
+
+        void record_deallocation(tag_counters& _counters, size_t _bytes) {
+            _counters.current_.fetch_sub(static_cast<int64_t>(_bytes), std::memory_order_relaxed);
+        }
+
+        /// A resize is not a new allocation, so only the difference in size is recorded, and only growth counts towards the allocation rate.
+        void record_resize(tag_counters& _counters, size_t _old_bytes, size_t _new_bytes) {
+            if (_new_bytes <= _old_bytes) {
+                record_deallocation(_counters, _old_bytes - _new_bytes);
+                return;
+            }
+            const int64_t growth = static_cast<int64_t>(_new_bytes - _old_bytes);
+            const int64_t current = _counters.current_.fetch_add(growth, std::memory_order_relaxed) + growth;
+            _counters.total_bytes_.fetch_add(static_cast<uint64_t>(growth), std::memory_order_relaxed);
+            int64_t peak = _counters.peak_.load(std::memory_order_relaxed);
+            while (current > peak && !_counters.peak_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+        }
+
+        allocation_header* header_of(void* _ptr) {
+            return reinterpret_cast<allocation_header*>(static_cast<std::byte*>(_ptr) - header_size);
+        }
+
+        void* write_header(std::byte* _base, size_t _offset, size_t _size, memory_tag _tag) {
+            std::byte* ptr = _base + _offset;
+            auto* header = reinterpret_cast<allocation_header*>(ptr - header_size);
+            header->size_ = _size;
+            header->offset_ = static_cast<uint32_t>(_offset);
+            header->tag_ = _tag;
+            return ptr;
+        }
+
+        void* init_header(std::byte* _base, size_t _offset, size_t _size, memory_tag _tag) {
+            record_allocation(counters[static_cast<size_t>(_tag)], _size);
+            return write_header(_base, _offset, _size, _tag);
+        }
+
+        std::byte* aligned_base_alloc(size_t _size, size_t _alignment) {
+            // The header goes at the end of a whole alignment unit in front of the memory, so that the memory stays aligned.
+            // aligned_alloc requires the size to be a multiple of the alignment.
+            const size_t total = (_alignment + _size + _alignment - 1) & ~(_alignment - 1);
+#ifdef _WIN32
+            return static_cast<std::byte*>(_aligned_malloc(total, _alignment));
+#else
+            return static_cast<std::byte*>(std::aligned_alloc(_alignment, total));
+#endif
+        }
+
+        void base_free(void* _ptr) {
+            const allocation_header* header = header_of(_ptr);
+            std::byte* base = static_cast<std::byte*>(_ptr) - header->offset_;
+#ifdef _WIN32
+            if (header->offset_ != header_size) {
+                _aligned_free(base);
+                return;
+            }
+#endif
+            std::free(base);
+        }
+
+        memory_stats make_stats(const tag_counters& _counters, const tag_report& _report) {
+            return memory_stats{_counters.current_.load(std::memory_order_relaxed),
+                                _counters.peak_.load(std::memory_order_relaxed),
+                                _counters.num_allocations_.load(std::memory_order_relaxed),
+                                _report.allocation_rate_,
+                                _report.budget_};
+        }
+
+        void update_report(const char* _prefix, const char* _name, const tag_counters& _counters, tag_report& _report, float _elapsed) {
+            const uint64_t total_bytes = _counters.total_bytes_.load(std::memory_order_relaxed);
+            _report.allocation_rate_ = static_cast<double>(total_bytes - _report.prev_total_bytes_) / static_cast<double>(_elapsed);
+            _report.prev_total_bytes_ = total_bytes;
+
+            if (_report.budget_ == 0) { return; }
+            const int64_t current = _counters.current_.load(std::memory_order_relaxed);
+            // Only warn when the budget is first exceeded, not every second while it stays exceeded.
+            if (current > static_cast<int64_t>(_report.budget_)) {
+                if (!_report.over_budget_) {
+                    MKR_CORE_WARN("Memory budget exceeded: {}{} is using {:.2f} MB of its {:.2f} MB budget.", _prefix, _name,
+                                  static_cast<double>(current) / (1024.0 * 1024.0), static_cast<double>(_report.budget_) / (1024.0 * 1024.0));
+                }
+                _report.over_budget_ = true;
+            } else {
+                _report.over_budget_ = false;
+            }
+        }
+
+        void log_stats(const char* _prefix, const char* _name, const memory_stats& _stats) {
+            constexpr double mb = 1024.0 * 1024.0;
+            MKR_CORE_INFO("{}{:<14} current {:>10.2f} MB, peak {:>10.2f} MB, {:>10} allocations, {:>10.2f} MB/s, budget {}", _prefix, _name,
+                          static_cast<double>(_stats.current_) / mb, static_cast<double>(_stats.peak_) / mb, _stats.num_allocations_, _stats.allocation_rate_ / mb,
+                          _stats.budget_ == 0 ? "none" : std::to_string(_stats.budget_ / (1024 * 1024)) + " MB");
+        }
+
+        void* ecs_malloc(ecs_size_t _size) { return memory_tracker::allocate(static_cast<size_t>(_size), memory_tag::ecs); }
+
+        void* ecs_calloc(ecs_size_t _size) {
+            void* ptr = memory_tracker::allocate(static_cast<size_t>(_size), memory_tag::ecs);
+            if (ptr) { std::memset(ptr, 0, static_cast<size_t>(_size)); }
+            return ptr;
+        }
+
+        void* ecs_realloc(void* _ptr, ecs_size_t _size) {
+            return _ptr ? memory_tracker::reallocate(_ptr, static_cast<size_t>(_size)) : memory_tracker::allocate(static_cast<size_t>(_size), memory_tag::ecs);
+        }
+
+        void ecs_free(void* _ptr) { memory_tracker::deallocate(_ptr); }
+    }
+
+    memory_tag memory_tracker::current_tag() {
+        return current_thread_tag;
+    }
+
+    void* memory_tracker::allocate(size_t _size, memory_tag _tag) {
+        auto* base = static_cast<std::byte*>(std::malloc(header_size + _size));
+        return base ? init_header(base, header_size, _size, _tag) : nullptr;
+    }
+
+    void* memory_tracker::allocate_aligned(size_t _size, size_t _alignment, memory_tag _tag) {
+        if (_alignment <= header_size) { return allocate(_size, _tag); }
+        auto* base = aligned_base_alloc(_size, _alignment);
+        return base ? init_header(base, _alignment, _size, _tag) : nullptr;
+    }
+
+    void* memory_tracker::reallocate(void* _ptr, size_t _size) {
+        allocation_header* header = header_of(_ptr);
+        const size_t old_size = header->size_;
+        const memory_tag tag = header->tag_;
+
+        // Aligned memory cannot be resized in place portably, so it is copied.
+        if (header->offset_ != header_size) {
+            const size_t alignment = header->offset_;
+            auto* base = aligned_base_alloc(_size, alignment);
+            if (!base) { return nullptr; }
+            void* ptr = write_header(base, alignment, _size, tag);
+            std::memcpy(ptr, _ptr, std::min(old_size, _size));
+            base_free(_ptr);
+            record_resize(counters[static_cast<size_t>(tag)], old_size, _size);
+            return ptr;
+        }
+
+        auto* base = static_cast<std::byte*>(std::realloc(reinterpret_cast<std::byte*>(header), header_size + _size));
+        if (!base) { return nullptr; }
+        record_resize(counters[static_cast<size_t>(tag)], old_size, _size);
+        return write_header(base, header_size, _size, tag);
+    }
+
+    void memory_tracker::deallocate(void* _ptr) {
+        if (!_ptr) { return; }
+        const allocation_header* header = header_of(_ptr);
+        record_deallocation(counters[static_cast<size_t>(header->tag_)], header->size_);
+        base_free(_ptr);
+    }
+
+    void memory_tracker::hook_ecs() {
+        // Flecs keeps the first OS API it is given, and skips installing its own once one is set. So its threads, locks and clocks are installed first,
+        // and only the allocator functions are replaced afterwards. ecs_os_set_api() would be ignored by then, so the installed API is patched in place.
+        ecs_set_os_api_impl();
+        ecs_os_api.malloc_ = ecs_malloc;
+        ecs_os_api.calloc_ = ecs_calloc;
+        ecs_os_api.realloc_ = ecs_realloc;
+        ecs_os_api.free_ = ecs_free;
+    }
+
+    void memory_tracker::gpu_allocate(gpu_memory_tag _tag, size_t _bytes) {
+        record_allocation(gpu_counters[static_cast<size_t>(_tag)], _bytes);
+    }
+
+    void memory_tracker::gpu_deallocate(gpu_memory_tag _tag, size_t _bytes) {
+        record_deallocation(gpu_counters[static_cast<size_t>(_tag)], _bytes);
+    }
+
+    memory_stats memory_tracker::stats(memory_tag _tag) {
+        return make_stats(counters[static_cast<size_t>(_tag)], reports[static_cast<size_t>(_tag)]);
+    }
+
+    memory_stats memory_tracker::stats(gpu_memory_tag _tag) {
+        return make_stats(gpu_counters[static_cast<size_t>(_tag)], gpu_reports[static_cast<size_t>(_tag)]);
+    }
+
+    void memory_tracker::set_budget(memory_tag _tag, uint64_t _bytes) {
+        reports[static_cast<size_t>(_tag)].budget_ = _bytes;
+    }
+
+    void memory_tracker::set_budget(gpu_memory_tag _tag, uint64_t _bytes) {
+        gpu_reports[static_cast<size_t>(_tag)].budget_ = _bytes;
+    }
+
+    void memory_tracker::update(float _delta_time) {
+        time_since_report += _delta_time;
+        if (time_since_report < 1.0f) { return; }
+
+        for (size_t i = 0; i < num_tags; ++i) { update_report("", tag_names[i], counters[i], reports[i], time_since_report); }
+        for (size_t i = 0; i < num_gpu_tags; ++i) { update_report("gpu ", gpu_tag_names[i], gpu_counters[i], gpu_reports[i], time_since_report); }
+        time_since_report = 0.0f;
+    }
+
+    void memory_tracker::dump() {
+        MKR_CORE_INFO("Memory usage:");
+        for (size_t i = 0; i < num_tags; ++i) { log_stats("    ", tag_names[i], stats(static_cast<memory_tag>(i))); }
+        MKR_CORE_INFO("GPU memory usage:");
+        for (size_t i = 0; i < num_gpu_tags; ++i) { log_stats("    ", gpu_tag_names[i], stats(static_cast<gpu_memory_tag>(i))); }
+    }
+
+    const char* memory_tracker::name(memory_tag _tag) {
+        return tag_names[static_cast<size_t>(_tag)];
+    }
+
+    const char* memory_tracker::name(gpu_memory_tag _tag) {
+        return gpu_tag_names[static_cast<size_t>(_tag)];
+    }
+
+    memory_scope::memory_scope(memory_tag _tag) : prev_tag_(current_thread_tag) {
+        current_thread_tag = _tag;
+    }
+
+    memory_scope::~memory_scope() {
+        current_thread_tag = prev_tag_;
+    }
+} // mkr
\ No newline at end of file
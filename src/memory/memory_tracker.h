@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mkr {
+    /// The engine subsystems that heap allocations are charged to.
+    enum class memory_tag : uint8_t {
+        /// Anything allocated outside of a memory_scope.
+        untagged = 0,
+        /// Meshes, including the CPU copies of their vertices and indices.
+        mesh,
+        /// Textures loaded by the texture manager, including the decoded images.
+        texture,
+        /// The renderer's persistent state.
+        renderer,
+        /// The blocks of the frame arenas, which hold the renderer's per-frame maps.
+        frame_arena,
+        /// The entity component system.
+        ecs,
+
+        num_memory_tags,
+    };
+
+    /// The kinds of GPU memory that are accounted for.
+    enum class gpu_memory_tag : uint8_t {
+        vertex_buffer = 0,
+        index_buffer,
+        texture,
+        cubemap,
+        /// Textures attached to framebuffers, such as the G-buffer and the shadow maps.
+        framebuffer,
+
+        num_gpu_memory_tags,
+    };
+
+    struct memory_stats {
+        /// The number of bytes currently allocated.
+        int64_t current_ = 0;
+        /// The most bytes that have been allocated at once.
+        int64_t peak_ = 0;
+        /// The number of allocations made so far.
+        uint64_t num_allocations_ = 0;
+        /// The number of bytes allocated per second, measured over the last second.
+        double allocation_rate_ = 0.0;
+        /// The number of bytes that may be allocated before a warning is logged, or 0 for no limit.
+        uint64_t budget_ = 0;
+    };
+
+    /**
+     * Charges every heap allocation to the memory_tag of the allocating thread's innermost memory_scope, and tracks the GPU memory reported by
+     * the buffers and textures. Keeps the current and peak bytes and the allocation rate of every tag, and warns when a tag exceeds its budget.
+     * The global operator new is routed through allocate(), which keeps the tag and size in a small header in front of every allocation.
+     */
+    class memory_tracker {
+    public:
+        memory_tracker() = delete;
+
+        /// The tag that the calling thread's heap allocations are currently charged to.
+        static memory_tag current_tag();
+
+        /// Allocate memory, charged to a tag. Returns nullptr if out of memory.
+        static void* allocate(size_t _size, memory_tag _tag);
+
+        /// Allocate memory with an alignment greater than the default, charged to a tag. Returns nullptr if out of memory.
+        static void* allocate_aligned(size_t _size, size_t _alignment, memory_tag _tag);
+
+        /// Resize memory allocated by allocate(), keeping its tag. Returns nullptr if out of memory, in which case the original memory is untouched.
+        static void* reallocate(void* _ptr, size_t _size);
+
+        /// Free memory allocated by any of the functions above.
+        static void deallocate(void* _ptr);
+
+        /// Route the entity component system's allocations through the tracker, keeping flecs' own threading and timing functions.
+        /// Must be called before the first world is created, as flecs would otherwise install its default OS API with untracked allocators.
+        static void hook_ecs();
+
+        /// Record that GPU memory has been allocated.
+        static void gpu_allocate(gpu_memory_tag _tag, size_t _bytes);
+
+        /// Record that GPU memory has been freed.
+        static void gpu_deallocate(gpu_memory_tag _tag, size_t _bytes);
+
+        static memory_stats stats(memory_tag _tag);
+
+        static memory_stats stats(gpu_memory_tag _tag);
+
+        static void set_budget(memory_tag _tag, uint64_t _bytes);
+
+        static void set_budget(gpu_memory_tag _tag, uint64_t _bytes);
+
+        /**
+         * Measure the allocation rates and check the budgets, once a second. Call once per frame.
+         * @param _delta_time the time since the last call
+         */
+        static void update(float _delta_time);
+
+        /// Log the current and peak bytes, the allocation count and the allocation rate of every tag.
+        static void dump();
+
+        static const char* name(memory_tag _tag);
+
+        static const char* name(gpu_memory_tag _tag);
+    };
+
+    /**
+     * Charges the calling thread's heap allocations to a tag for as long as it is in scope. Scopes nest, so the innermost scope wins.
+     * Memory is charged to the tag it was allocated under, even if it is freed under another.
+     */
+    class memory_scope {
+    private:
+        memory_tag prev_tag_;
+
+    public:
+        explicit memory_scope(memory_tag _tag);
+        memory_scope(const memory_scope&) = delete;
+        memory_scope& operator=(const memory_scope&) = delete;
+        ~memory_scope();
+    };
+} // mkr
\ No newline at end of file
@@ -1,34 +1,200 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <log/log.h>
 #include "scene/scene.h"
+#include "scene/scene_serializer.h"
 #include "application/application.h"
+#include "graphics/mesh/static_batcher.h"
 #include "component/transform.h"
 #include "component/local_to_world.h"
 #include "component/render_mesh.h"
 #include "component/light.h"
 #include "component/camera.h"
+#include "component/static_tag.h"
+#include "component/baked_tag.h"
 
 namespace mkr {
-    void scene::update() {
-        // Update Local-To-World.
-        auto q = world_.query_builder<const transform, local_to_world, const local_to_world*>()
+    namespace {
+        void compute_local_to_world(const transform& _child, const local_to_world* _parent, local_to_world& _out) {
+            matrix4x4 trans = _child.transform_matrix();
+            quaternion rot = _child.get_rotation();
+            if (_parent) {
+                trans = _parent->transform_ * trans;
+                rot = _parent->rotation_ * rot;
+            }
+            _out.transform_ = trans;
+            _out.rotation_ = rot;
+            _out.position_ = vector3{trans[3][0], trans[3][1], trans[3][2]};
+            _out.left_ = quaternion::rotate(vector3::x_axis(), rot);
+            _out.up_ = quaternion::rotate(vector3::y_axis(), rot);
+            _out.forward_ = quaternion::rotate(vector3::z_axis(), rot);
+        }
+    }
+
+    scene::scene() {
+        // Every entity with a transform can move, so it also keeps its previous state for render interpolation.
+        // Baked static chunks have no transform, so they only get a local_to_world.
+        world_.component<transform>().add(flecs::With, world_.component<previous_local_to_world>());
+        // Registered up front, so that saved scenes can be loaded into a scene that has not baked yet.
+        world_.component<static_tag>();
+        world_.component<baked_tag>();
+
+        // Static entities never move, so they are left out of the per-frame work, and only updated by update_static_local_to_world().
+        local_to_world_query_ = world_.query_builder<const transform, local_to_world, const local_to_world*>()
             .term_at(3).parent()
             .cascade().optional()
+            .term<static_tag>().not_()
             .build();
-        q.iter([](flecs::iter& _iter, const transform* _child, local_to_world* _out, const local_to_world* _parent) {
+        static_local_to_world_query_ = world_.query_builder<const transform, local_to_world, const local_to_world*>()
+            .term_at(3).parent()
+            .cascade().optional()
+            .term<static_tag>()
+            .build();
+        previous_local_to_world_query_ = world_.query_builder<const local_to_world, previous_local_to_world>()
+            .term<static_tag>().not_()
+            .build();
+    }
+
+    void scene::fixed_update() {
+        // Keep the state of the previous step for render interpolation.
+        previous_local_to_world_query_.each([](const local_to_world& _current, previous_local_to_world& _previous) {
+            _previous.transform_ = _current;
+            _previous.valid_ = true;
+        });
+
+        const float fixed_delta_time = application::instance().fixed_delta_time();
+        for (auto& sys : fixed_systems_) {
+            sys.run(fixed_delta_time);
+        }
+        update_local_to_world();
+    }
+
+    void scene::update() {
+        update_local_to_world();
+        world_.progress(application::instance().delta_time());
+    }
+
+    void scene::bake_static() {
+        // Rebaking replaces the previous chunks, such as after loading, so that every static entity is in exactly one chunk.
+        for (auto& chunk : static_chunks_) {
+            chunk.destruct();
+        }
+        static_chunks_.clear();
+        static_meshes_.clear();
+
+        // Static entities are baked with their world space transform, so it has to be up to date.
+        update_static_local_to_world();
+
+        std::unordered_map<material*, std::vector<static_instance>> instances;
+        std::vector<flecs::entity> baked;
+        world_.each([&](flecs::entity _entity, const transform&, const local_to_world& _transform, const render_mesh& _render_mesh, const static_tag) {
+            instances[_render_mesh.material_].push_back(static_instance{_render_mesh.mesh_, _transform.transform_});
+            baked.push_back(_entity);
+        });
+        // The baked entities keep their transform and render_mesh, so that they are still saved with the scene, but they are no longer rendered.
+        for (auto& entity : baked) {
+            entity.add<baked_tag>();
+        }
+
+        // The chunks are in world space, and are never saved or moved, so they need no transform.
+        local_to_world chunk_transform;
+        compute_local_to_world(transform{}, nullptr, chunk_transform);
+
+        size_t num_chunks = 0;
+        for (const auto& iter : instances) {
+            auto meshes = static_batcher::bake("static_batch_" + std::to_string(static_meshes_.size()), iter.second);
+            for (auto& m : meshes) {
+                static_chunks_.push_back(world_.entity().set<local_to_world>(chunk_transform).set<render_mesh>(render_mesh{iter.first, m.get()}).add<static_tag>());
+                static_meshes_.push_back(std::move(m));
+                ++num_chunks;
+            }
+        }
+        MKR_CORE_INFO("Baked {} static entities into {} chunks.", baked.size(), num_chunks);
+    }
+
+    std::vector<flecs::entity_t> scene::bulk_create(int32_t _count, const std::vector<flecs::id_t>& _ids, const std::vector<void*>& _data) {
+        if (_ids.size() > FLECS_ID_DESC_MAX || _ids.size() != _data.size()) { throw std::runtime_error("invalid bulk create description"); }
+
+        ecs_bulk_desc_t desc{};
+        desc.count = _count;
+        for (size_t i = 0; i < _ids.size(); ++i) {
+            desc.ids[i] = _ids[i];
+        }
+        desc.data = const_cast<void**>(_data.data());
+
+        // The returned array is owned by flecs and only valid until the next operation, so copy it out.
+        const flecs::entity_t* entities = ecs_bulk_init(world_.c_ptr(), &desc);
+        return std::vector<flecs::entity_t>(entities, entities + _count);
+    }
+
+    std::vector<flecs::entity_t> scene::spawn(std::span<const transform> _transforms, std::span<const render_mesh> _render_meshes, const std::vector<flecs::id_t>& _tags) {
+        if (_transforms.size() != _render_meshes.size()) { throw std::runtime_error("spawn requires one render_mesh per transform"); }
+        if (_transforms.empty()) { return {}; }
+
+        std::vector<flecs::id_t> ids{
+            world_.component<transform>().id(),
+            world_.component<render_mesh>().id(),
+            world_.component<local_to_world>().id(),
+            world_.component<previous_local_to_world>().id(),
+        };
+        std::vector<void*> data{
+            const_cast<transform*>(_transforms.data()),
+            const_cast<render_mesh*>(_render_meshes.data()),
+            nullptr,
+            nullptr,
+        };
+        for (auto tag : _tags) {
+            ids.push_back(tag);
+            data.push_back(nullptr);
+        }
+
+        return bulk_create(static_cast<int32_t>(_transforms.size()), ids, data);
+    }
+
+    void scene::save(const std::string& _file) {
+        std::ofstream stream{_file, std::ios::binary};
+        if (!stream) { throw std::runtime_error("cannot open scene file"); }
+        scene_serializer::save(*this, stream);
+    }
+
+    void scene::load(const std::string& _file) {
+        std::ifstream stream{_file, std::ios::binary};
+        if (!stream) { throw std::runtime_error("cannot open scene file"); }
+        scene_serializer::load(*this, stream);
+        bake_static();
+    }
+
+    std::string scene::snapshot() {
+        std::ostringstream stream{std::ios::binary};
+        scene_serializer::save(*this, stream);
+        return stream.str();
+    }
+
+    void scene::restore(const std::string& _snapshot) {
+        // Every serialized entity has a transform, so this removes exactly what the snapshot will recreate. Baked chunks have none, and are rebaked after.
+        world_.delete_with<transform>();
+        std::istringstream stream{_snapshot, std::ios::binary};
+        scene_serializer::load(*this, stream);
+        bake_static();
+    }
+
+    void scene::update_local_to_world() {
+        local_to_world_query_.iter([](flecs::iter& _iter, const transform* _child, local_to_world* _out, const local_to_world* _parent) {
             for (auto i: _iter) {
-                matrix4x4 trans = _child[i].transform_matrix();
-                quaternion rot = _child[i].get_rotation();
-                if (_parent) {
-                    trans = _parent->transform_ * trans;
-                    rot = _parent->rotation_ * rot;
-                }
-                _out[i].transform_ = trans;
-                _out[i].rotation_ = rot;
-                _out[i].position_ = vector3{trans[3][0], trans[3][1], trans[3][2]};
-                _out[i].left_ = quaternion::rotate(vector3::x_axis(), rot);
-                _out[i].up_ = quaternion::rotate(vector3::y_axis(), rot);
-                _out[i].forward_ = quaternion::rotate(vector3::z_axis(), rot);
+                compute_local_to_world(_child[i], _parent, _out[i]);
             }
         });
-        world_.progress(application::instance().delta_time());
     }
-} // mkr
\ No newline at end of file
+
+    void scene::update_static_local_to_world() {
+        // Static entities can be the parents of dynamic ones, so the dynamic entities are updated after.
+        static_local_to_world_query_.iter([](flecs::iter& _iter, const transform* _child, local_to_world* _out, const local_to_world* _parent) {
+            for (auto i: _iter) {
+                compute_local_to_world(_child[i], _parent, _out[i]);
+            }
+        });
+        update_local_to_world();
+    }
+} // mkr
@@ -2,21 +2,97 @@
 
 #include <utility>
 #include <string>
+#include <vector>
+#include <memory>
+#include <span>
 #include <flecs.h>
+#include "graphics/mesh/mesh.h"
+#include "component/transform.h"
+#include "component/local_to_world.h"
+#include "component/render_mesh.h"
 
 namespace mkr {
     class scene {
+        friend class scene_serializer;
+
     protected:
         flecs::world world_;
+        /// Systems that are stepped at the application's fixed delta time rather than once per frame.
+        std::vector<flecs::system> fixed_systems_;
+        /// The combined meshes created by bake_static(). Owned by the scene so that they are released with it.
+        std::vector<std::unique_ptr<mesh>> static_meshes_;
+        /// The entities that render static_meshes_. They are not saved, as they are rebaked from the static entities.
+        std::vector<flecs::entity> static_chunks_;
+        /// Queries are built once, rather than every frame, so that updating them does not allocate.
+        flecs::query<const transform, local_to_world, const local_to_world*> local_to_world_query_;
+        flecs::query<const transform, local_to_world, const local_to_world*> static_local_to_world_query_;
+        flecs::query<const local_to_world, previous_local_to_world> previous_local_to_world_query_;
+
+        /**
+         * Create a system that runs at the application's fixed delta time.
+         * Fixed systems are not part of the world's pipeline, and only run during fixed_update().
+         * @tparam Components The components of the system.
+         * @param _func The function to invoke for each entity.
+         * @return The created system.
+         */
+        template<typename... Components, typename Func>
+        flecs::system fixed_system(Func&& _func) {
+            auto sys = world_.system<Components...>().kind(0).each(std::forward<Func>(_func));
+            fixed_systems_.push_back(sys);
+            return sys;
+        }
+
+        /// Update the local_to_world of every dynamic entity from its transform and its parent. Static entities are skipped.
+        void update_local_to_world();
+
+        /// Update the local_to_world of every static entity, and then of every dynamic entity. Only needed when static entities are created, such as by bake_static().
+        void update_static_local_to_world();
+
+        /**
+         * Merge the render_mesh of every entity with a static_tag into combined world space meshes, one set of chunks per material, replacing any previous chunks.
+         * The baked entities keep their render_mesh and are given a baked_tag, so that render systems skip them, and each chunk is rendered by a new static entity
+         * with only a local_to_world, a render_mesh and a static_tag. Call once the level has been created, as static entities must not move afterwards.
+         * load() and restore() rebake, as the chunks are not saved.
+         */
+        void bake_static();
+
+        /**
+         * Create entities directly in their final archetype, skipping the intermediate tables that adding components one by one moves them through.
+         * @param _count The number of entities to create.
+         * @param _ids The components, tags and pairs of the entities.
+         * @param _data For each of _ids, an array of _count values to copy into the new entities, or nullptr to default construct them. Tags and pairs must be nullptr.
+         * @return The created entities.
+         */
+        std::vector<flecs::entity_t> bulk_create(int32_t _count, const std::vector<flecs::id_t>& _ids, const std::vector<void*>& _data);
 
     public:
-        scene() {}
+        scene();
         virtual ~scene() {}
 
         virtual void init() = 0;
         virtual void pre_update() = 0;
+        virtual void fixed_update();
         virtual void update();
         virtual void post_update() = 0;
         virtual void exit() = 0;
+
+        /**
+         * Spawn renderable entities in bulk, directly in their final archetype.
+         * Each entity gets a transform, a render_mesh, a local_to_world and a previous_local_to_world.
+         * @param _transforms The transform of each entity.
+         * @param _render_meshes The render_mesh of each entity. Must be the same size as _transforms.
+         * @param _tags Additional tags to add to every entity.
+         * @return The created entities, in the same order as the input arrays.
+         */
+        std::vector<flecs::entity_t> spawn(std::span<const transform> _transforms, std::span<const render_mesh> _render_meshes, const std::vector<flecs::id_t>& _tags = {});
+
+        /// Save the entities of the scene to a binary file.
+        void save(const std::string& _file);
+        /// Load entities from a binary file into the scene, and rebake its static entities.
+        void load(const std::string& _file);
+        /// Take an in-memory snapshot of the entities of the scene.
+        [[nodiscard]] std::string snapshot();
+        /// Replace the entities of the scene with a snapshot, and rebake its static entities.
+        void restore(const std::string& _snapshot);
     };
-} // mkr
\ No newline at end of file
+} // mkr
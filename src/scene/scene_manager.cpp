@@ -1,12 +1,45 @@
+#include <algorithm>
+#include <stdexcept>
 #include "scene/scene_manager.h"
+#include "application/command_line.h"
 #include "game/scene/game_scene.h"
+#include "game/scene/stress_scene.h"
 
 namespace mkr {
     void scene_manager::init() {
-        scene_ = std::make_unique<game_scene>();
+        // The scene can be selected on the command line with --scene=<name>.
+        const auto& args = command_line::instance();
+        const std::string scene_name = args.get_string("scene", "game");
+        if (scene_name == "stress") {
+            // Negative counts are clamped to 0, rather than wrapping around to billions of entities.
+            const auto get_count = [&](const std::string& _name, uint32_t _default) {
+                return static_cast<uint32_t>(std::max(args.get_int(_name, static_cast<int>(_default)), 0));
+            };
+            stress_grid grid;
+            grid.count_x_ = get_count("grid_x", grid.count_x_);
+            grid.count_y_ = get_count("grid_y", grid.count_y_);
+            grid.count_z_ = get_count("grid_z", grid.count_z_);
+            grid.spacing_ = args.get_float("spacing", grid.spacing_);
+            grid.static_ = args.has("static");
+            grid.num_materials_ = get_count("materials", grid.num_materials_);
+            grid.transparent_ratio_ = args.get_float("transparent", grid.transparent_ratio_);
+            grid.num_lights_ = get_count("lights", grid.num_lights_);
+            grid.hierarchy_ = args.has("hierarchy");
+            grid.animated_ratio_ = args.get_float("animated", grid.animated_ratio_);
+            scene_ = std::make_unique<stress_scene>(grid);
+        } else if (scene_name == "game") {
+            scene_ = std::make_unique<game_scene>();
+        } else {
+            MKR_CORE_ERROR("unknown scene {}", scene_name);
+            throw std::runtime_error("unknown scene");
+        }
         scene_->init();
     }
 
+    void scene_manager::fixed_update() {
+        scene_->fixed_update();
+    }
+
     void scene_manager::update() {
         scene_->pre_update();
         scene_->update();
@@ -16,4 +49,4 @@ namespace mkr {
     void scene_manager::exit() {
         scene_->exit();
     }
-}
\ No newline at end of file
+}
@@ -22,6 +22,8 @@ namespace mkr {
 
         void init();
 
+        void fixed_update();
+
         void update();
 
         void exit();
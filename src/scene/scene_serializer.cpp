@@ -0,0 +1,523 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+#include <flecs.h>
+#include <log/log.h>
+#include <maths/maths_util.h>
+#include "scene/scene.h"
+#include "scene/scene_serializer.h"
+#include "graphics/mesh/mesh_manager.h"
+#include "graphics/material/material_manager.h"
+#include "graphics/texture/texture_manager.h"
+#include "graphics/shader/shader_manager.h"
+#include "component/transform.h"
+#include "component/local_to_world.h"
+#include "component/render_mesh.h"
+#include "component/light.h"
+#include "component/camera.h"
+
+namespace mkr {
+    void scene_serializer::write_string(std::ostream& _stream, const std::string& _string) {
+        write<uint32_t>(_stream, static_cast<uint32_t>(_string.size()));
+        _stream.write(_string.data(), static_cast<std::streamsize>(_string.size()));
+    }
+
+    std::string scene_serializer::read_string(std::istream& _stream) {
+        std::string str(read<uint32_t>(_stream), '\0');
+        _stream.read(str.data(), static_cast<std::streamsize>(str.size()));
+        if (!_stream) { throw std::runtime_error("unexpected end of scene file"); }
+        return str;
+    }
+
+    void scene_serializer::write_strings(std::ostream& _stream, const std::vector<std::string>& _strings) {
+        write<uint32_t>(_stream, static_cast<uint32_t>(_strings.size()));
+        for (const auto& str : _strings) { write_string(_stream, str); }
+    }
+
+    std::vector<std::string> scene_serializer::read_strings(std::istream& _stream) {
+        std::vector<std::string> strings(read<uint32_t>(_stream));
+        for (auto& str : strings) { str = read_string(_stream); }
+        return strings;
+    }
+
+    void scene_serializer::write_vector3(std::vector<float>& _column, const vector3& _vector) {
+        _column.insert(_column.end(), {_vector.x_, _vector.y_, _vector.z_});
+    }
+
+    vector3 scene_serializer::read_vector3(const std::vector<float>& _column, size_t _index) {
+        return vector3{_column[_index * 3], _column[_index * 3 + 1], _column[_index * 3 + 2]};
+    }
+
+    void scene_serializer::write_colour(std::vector<float>& _column, const colour& _colour) {
+        _column.insert(_column.end(), {_colour.r_, _colour.g_, _colour.b_, _colour.a_});
+    }
+
+    colour scene_serializer::read_colour(const std::vector<float>& _column, size_t _index) {
+        return colour{_column[_index * 4], _column[_index * 4 + 1], _column[_index * 4 + 2], _column[_index * 4 + 3]};
+    }
+
+    void scene_serializer::write_rotation(std::vector<float>& _column, const quaternion& _rotation) {
+        // Recover the axis and angle from the rotation matrix. The matrix is indexed by [column][row].
+        const matrix4x4 m = _rotation.to_rotation_matrix();
+        const float angle = std::acos(maths_util::clamp<float>((m[0][0] + m[1][1] + m[2][2] - 1.0f) * 0.5f, -1.0f, 1.0f));
+        if (angle < 1e-6f) {
+            _column.insert(_column.end(), {0.0f, 1.0f, 0.0f, 0.0f});
+            return;
+        }
+
+        vector3 axis;
+        if (maths_util::pi - angle > 1e-3f) {
+            axis = vector3{m[1][2] - m[2][1], m[2][0] - m[0][2], m[0][1] - m[1][0]}.normalised();
+        } else {
+            // Near 180 degrees the antisymmetric part vanishes, so the axis is recovered from the diagonal instead.
+            axis = vector3{std::sqrt(maths_util::max<float>(0.0f, (m[0][0] + 1.0f) * 0.5f)),
+                           std::sqrt(maths_util::max<float>(0.0f, (m[1][1] + 1.0f) * 0.5f)),
+                           std::sqrt(maths_util::max<float>(0.0f, (m[2][2] + 1.0f) * 0.5f))};
+            if (axis.x_ >= axis.y_ && axis.x_ >= axis.z_) {
+                axis.y_ = std::copysign(axis.y_, m[1][0] + m[0][1]);
+                axis.z_ = std::copysign(axis.z_, m[2][0] + m[0][2]);
+            } else if (axis.y_ >= axis.z_) {
+                axis.x_ = std::copysign(axis.x_, m[1][0] + m[0][1]);
+                axis.z_ = std::copysign(axis.z_, m[2][1] + m[1][2]);
+            } else {
+                axis.x_ = std::copysign(axis.x_, m[2][0] + m[0][2]);
+                axis.y_ = std::copysign(axis.y_, m[2][1] + m[1][2]);
+            }
+            axis.normalise();
+        }
+
+        // Do not assume the handedness of the quaternion class. Keep whichever sign reproduces the original rotation.
+        auto error = [&](float _angle) {
+            const quaternion q{axis, _angle};
+            const vector3 dx = quaternion::rotate(vector3::x_axis(), q) - quaternion::rotate(vector3::x_axis(), _rotation);
+            const vector3 dy = quaternion::rotate(vector3::y_axis(), q) - quaternion::rotate(vector3::y_axis(), _rotation);
+            return dx.dot(dx) + dy.dot(dy);
+        };
+        const float signed_angle = error(angle) <= error(-angle) ? angle : -angle;
+        _column.insert(_column.end(), {axis.x_, axis.y_, axis.z_, signed_angle});
+    }
+
+    quaternion scene_serializer::read_rotation(const std::vector<float>& _column, size_t _index) {
+        const vector3 axis{_column[_index * 4], _column[_index * 4 + 1], _column[_index * 4 + 2]};
+        return quaternion{axis, _column[_index * 4 + 3]};
+    }
+
+    void scene_serializer::save(scene& _scene, std::ostream& _stream) {
+        flecs::world& world = _scene.world_;
+
+        // Entities
+        std::vector<flecs::entity> entities;
+        std::unordered_map<flecs::entity_t, uint32_t> entity_indices;
+        world.each([&](flecs::entity _entity, const transform&) {
+            entity_indices[_entity.id()] = static_cast<uint32_t>(entities.size());
+            entities.push_back(_entity);
+        });
+
+        // Assets
+        std::vector<std::string> mesh_names, material_names, cubemap_names, shader_names;
+        std::unordered_map<const void*, uint32_t> asset_ids;
+        auto asset_id = [&](const auto* _asset, std::vector<std::string>& _names, auto&& _get_name) -> uint32_t {
+            if (!_asset) { return invalid_id_; }
+            auto iter = asset_ids.find(_asset);
+            if (iter != asset_ids.end()) { return iter->second; }
+            const auto id = static_cast<uint32_t>(_names.size());
+            _names.push_back(_get_name(_asset));
+            asset_ids[_asset] = id;
+            return id;
+        };
+        auto mesh_name = [](const mesh* _mesh) { return _mesh->name(); };
+        auto material_name = [](const material* _material) { return material_manager::instance().get_name(_material); };
+        auto cubemap_name = [](const cubemap* _cubemap) { return _cubemap->name(); };
+        auto shader_name = [](const shader_program* _shader) { return _shader->name(); };
+
+        // Columns
+        std::vector<std::string> names;
+        std::vector<uint8_t> flags;
+        std::vector<uint32_t> children, parents;
+        std::vector<float> positions, rotations, scales;
+
+        std::vector<uint32_t> mesh_entities, mesh_ids, material_ids;
+
+        std::vector<uint32_t> light_entities;
+        std::vector<uint8_t> light_modes;
+        std::vector<float> light_colours, light_powers, light_attenuations, light_angles, light_shadow_distances;
+
+        std::vector<uint32_t> camera_entities, camera_skybox_textures, camera_skybox_shaders;
+        std::vector<uint8_t> camera_modes, camera_depths;
+        std::vector<float> camera_planes, camera_aspect_ratios, camera_fovs, camera_ortho_sizes, camera_viewports, camera_skybox_colours;
+
+        std::vector<std::string> tag_names;
+        std::unordered_map<flecs::id_t, uint32_t> tag_ids;
+        std::vector<uint32_t> tag_entities, tag_columns;
+
+        // Components that are not in a table below would be silently lost, so they are reported once each.
+        const flecs::id_t saved_components[] = {
+            world.component<transform>().id(),
+            world.component<local_to_world>().id(),
+            world.component<previous_local_to_world>().id(),
+            world.component<render_mesh>().id(),
+            world.component<light>().id(),
+            world.component<camera>().id(),
+        };
+        std::map<std::string, uint32_t> unsaved_components;
+
+        for (uint32_t i = 0; i < entities.size(); ++i) {
+            const auto& entity = entities[i];
+
+            const char* name = ecs_get_name(world.c_ptr(), entity.id());
+            names.emplace_back(name ? name : "");
+            flags.push_back(entity.has<local_to_world>() ? has_local_to_world : 0);
+
+            auto parent = entity.parent();
+            if (parent && entity_indices.contains(parent.id())) {
+                children.push_back(i);
+                parents.push_back(entity_indices[parent.id()]);
+            }
+
+            const auto* trans = entity.get<transform>();
+            write_vector3(positions, trans->get_position());
+            write_rotation(rotations, trans->get_rotation());
+            write_vector3(scales, trans->get_scale());
+
+            if (const auto* rend = entity.get<render_mesh>()) {
+                mesh_entities.push_back(i);
+                mesh_ids.push_back(asset_id(rend->mesh_, mesh_names, mesh_name));
+                material_ids.push_back(asset_id(rend->material_, material_names, material_name));
+            }
+
+            if (const auto* lt = entity.get<light>()) {
+                light_entities.push_back(i);
+                light_modes.push_back(static_cast<uint8_t>(lt->get_mode()));
+                write_colour(light_colours, lt->get_colour());
+                light_powers.push_back(lt->get_power());
+                light_attenuations.insert(light_attenuations.end(), {lt->get_attenuation_constant(), lt->get_attenuation_linear(), lt->get_attenuation_quadratic()});
+                light_angles.insert(light_angles.end(), {lt->get_spotlight_inner_angle(), lt->get_spotlight_outer_angle()});
+                light_shadow_distances.push_back(lt->get_shadow_distance());
+            }
+
+            if (const auto* cam = entity.get<camera>()) {
+                camera_entities.push_back(i);
+                camera_modes.push_back(static_cast<uint8_t>(cam->mode_));
+                camera_planes.insert(camera_planes.end(), {cam->near_plane_, cam->far_plane_});
+                camera_aspect_ratios.push_back(cam->aspect_ratio_);
+                camera_fovs.push_back(cam->fov_);
+                camera_ortho_sizes.push_back(cam->ortho_size_);
+                camera_depths.push_back(cam->depth_);
+                camera_viewports.insert(camera_viewports.end(), {cam->viewport_.bottom_x_, cam->viewport_.bottom_y_, cam->viewport_.top_x_, cam->viewport_.top_y_});
+                write_colour(camera_skybox_colours, cam->skybox_.colour_);
+                camera_skybox_textures.push_back(asset_id(cam->skybox_.texture_, cubemap_names, cubemap_name));
+                camera_skybox_shaders.push_back(asset_id(cam->skybox_.shader_, shader_names, shader_name));
+            }
+
+            // Tags have no type info. Pairs, such as the entity's name and parent, are stored separately.
+            entity.each([&](flecs::id _id) {
+                if (_id.is_pair()) { return; }
+                if (ecs_get_typeid(world.c_ptr(), _id) != 0) {
+                    if (std::find(std::begin(saved_components), std::end(saved_components), _id.raw_id()) == std::end(saved_components)) {
+                        ++unsaved_components[_id.entity().path().c_str()];
+                    }
+                    return;
+                }
+                auto iter = tag_ids.find(_id);
+                if (iter == tag_ids.end()) {
+                    iter = tag_ids.emplace(_id, static_cast<uint32_t>(tag_names.size())).first;
+                    tag_names.emplace_back(_id.entity().path().c_str());
+                }
+                tag_entities.push_back(i);
+                tag_columns.push_back(iter->second);
+            });
+        }
+
+        for (const auto& iter : unsaved_components) {
+            MKR_CORE_WARN("Scene save: component {} on {} entities is not serialized, and will be missing when the scene is loaded.", iter.first, iter.second);
+        }
+
+        // Header
+        write<uint32_t>(_stream, magic_);
+        write<uint32_t>(_stream, version_);
+        write<uint32_t>(_stream, static_cast<uint32_t>(entities.size()));
+
+        // Asset Tables
+        write_strings(_stream, mesh_names);
+        write_strings(_stream, material_names);
+        write_strings(_stream, cubemap_names);
+        write_strings(_stream, shader_names);
+
+        // Entity Table
+        for (const auto& name : names) { write_string(_stream, name); }
+        write_column(_stream, flags);
+
+        // Parent/Child Table
+        write<uint32_t>(_stream, static_cast<uint32_t>(children.size()));
+        write_column(_stream, children);
+        write_column(_stream, parents);
+
+        // Transform Table (every entity has a transform)
+        write_column(_stream, positions);
+        write_column(_stream, rotations);
+        write_column(_stream, scales);
+
+        // Render Mesh Table
+        write<uint32_t>(_stream, static_cast<uint32_t>(mesh_entities.size()));
+        write_column(_stream, mesh_entities);
+        write_column(_stream, mesh_ids);
+        write_column(_stream, material_ids);
+
+        // Light Table
+        write<uint32_t>(_stream, static_cast<uint32_t>(light_entities.size()));
+        write_column(_stream, light_entities);
+        write_column(_stream, light_modes);
+        write_column(_stream, light_colours);
+        write_column(_stream, light_powers);
+        write_column(_stream, light_attenuations);
+        write_column(_stream, light_angles);
+        write_column(_stream, light_shadow_distances);
+
+        // Camera Table
+        write<uint32_t>(_stream, static_cast<uint32_t>(camera_entities.size()));
+        write_column(_stream, camera_entities);
+        write_column(_stream, camera_modes);
+        write_column(_stream, camera_planes);
+        write_column(_stream, camera_aspect_ratios);
+        write_column(_stream, camera_fovs);
+        write_column(_stream, camera_ortho_sizes);
+        write_column(_stream, camera_depths);
+        write_column(_stream, camera_viewports);
+        write_column(_stream, camera_skybox_colours);
+        write_column(_stream, camera_skybox_textures);
+        write_column(_stream, camera_skybox_shaders);
+
+        // Tag Table
+        write_strings(_stream, tag_names);
+        write<uint32_t>(_stream, static_cast<uint32_t>(tag_entities.size()));
+        write_column(_stream, tag_entities);
+        write_column(_stream, tag_columns);
+
+        if (!_stream) { throw std::runtime_error("failed to write scene"); }
+    }
+
+    void scene_serializer::load(scene& _scene, std::istream& _stream) {
+        flecs::world& world = _scene.world_;
+
+        // Header
+        if (read<uint32_t>(_stream) != magic_) { throw std::runtime_error("invalid scene file"); }
+        if (read<uint32_t>(_stream) != version_) { throw std::runtime_error("unsupported scene file version"); }
+        const uint32_t num_entities = read<uint32_t>(_stream);
+
+        // Asset Tables. Each asset is resolved once, rather than once per entity that references it.
+        std::vector<mesh*> meshes;
+        for (const auto& name : read_strings(_stream)) {
+            meshes.push_back(mesh_manager::instance().get_mesh(name));
+            if (!meshes.back()) { throw std::runtime_error("unknown mesh in scene file"); }
+        }
+        std::vector<material*> materials;
+        for (const auto& name : read_strings(_stream)) {
+            materials.push_back(material_manager::instance().get_material(name));
+            if (!materials.back()) { throw std::runtime_error("unknown material in scene file"); }
+        }
+        std::vector<cubemap*> cubemaps;
+        for (const auto& name : read_strings(_stream)) {
+            cubemaps.push_back(texture_manager::instance().get_cubemap(name));
+            if (!cubemaps.back()) { throw std::runtime_error("unknown cubemap in scene file"); }
+        }
+        std::vector<shader_program*> shaders;
+        for (const auto& name : read_strings(_stream)) {
+            shaders.push_back(shader_manager::instance().get_shader(name));
+            if (!shaders.back()) { throw std::runtime_error("unknown shader in scene file"); }
+        }
+
+        // Entity Table
+        std::vector<std::string> names(num_entities);
+        for (auto& name : names) { name = read_string(_stream); }
+        const auto flags = read_column<uint8_t>(_stream, num_entities);
+
+        // Parent/Child Table
+        const uint32_t num_children = read<uint32_t>(_stream);
+        const auto children = read_column<uint32_t>(_stream, num_children);
+        const auto parents = read_column<uint32_t>(_stream, num_children);
+
+        // Transform Table
+        const auto positions = read_column<float>(_stream, num_entities * 3);
+        const auto rotations = read_column<float>(_stream, num_entities * 4);
+        const auto scales = read_column<float>(_stream, num_entities * 3);
+
+        // Render Mesh Table
+        const uint32_t num_meshes = read<uint32_t>(_stream);
+        const auto mesh_entities = read_column<uint32_t>(_stream, num_meshes);
+        const auto mesh_ids = read_column<uint32_t>(_stream, num_meshes);
+        const auto material_ids = read_column<uint32_t>(_stream, num_meshes);
+
+        // Light Table
+        const uint32_t num_lights = read<uint32_t>(_stream);
+        const auto light_entities = read_column<uint32_t>(_stream, num_lights);
+        const auto light_modes = read_column<uint8_t>(_stream, num_lights);
+        const auto light_colours = read_column<float>(_stream, num_lights * 4);
+        const auto light_powers = read_column<float>(_stream, num_lights);
+        const auto light_attenuations = read_column<float>(_stream, num_lights * 3);
+        const auto light_angles = read_column<float>(_stream, num_lights * 2);
+        const auto light_shadow_distances = read_column<float>(_stream, num_lights);
+
+        // Camera Table
+        const uint32_t num_cameras = read<uint32_t>(_stream);
+        const auto camera_entities = read_column<uint32_t>(_stream, num_cameras);
+        const auto camera_modes = read_column<uint8_t>(_stream, num_cameras);
+        const auto camera_planes = read_column<float>(_stream, num_cameras * 2);
+        const auto camera_aspect_ratios = read_column<float>(_stream, num_cameras);
+        const auto camera_fovs = read_column<float>(_stream, num_cameras);
+        const auto camera_ortho_sizes = read_column<float>(_stream, num_cameras);
+        const auto camera_depths = read_column<uint8_t>(_stream, num_cameras);
+        const auto camera_viewports = read_column<float>(_stream, num_cameras * 4);
+        const auto camera_skybox_colours = read_column<float>(_stream, num_cameras * 4);
+        const auto camera_skybox_textures = read_column<uint32_t>(_stream, num_cameras);
+        const auto camera_skybox_shaders = read_column<uint32_t>(_stream, num_cameras);
+
+        // Tag Table
+        std::vector<flecs::id_t> tags;
+        for (const auto& name : read_strings(_stream)) {
+            auto tag = world.lookup(name.c_str());
+            if (!tag) { MKR_CORE_WARN("Unknown tag {} in scene file.", name); }
+            tags.push_back(tag.id());
+        }
+        const uint32_t num_tags = read<uint32_t>(_stream);
+        const auto tag_entities = read_column<uint32_t>(_stream, num_tags);
+        const auto tag_columns = read_column<uint32_t>(_stream, num_tags);
+
+        // Map each entity to its rows.
+        auto check_entity = [&](uint32_t _entity) { if (_entity >= num_entities) { throw std::runtime_error("invalid entity in scene file"); } };
+        std::vector<uint32_t> mesh_rows(num_entities, invalid_id_), light_rows(num_entities, invalid_id_), camera_rows(num_entities, invalid_id_);
+        for (uint32_t row = 0; row < num_meshes; ++row) { check_entity(mesh_entities[row]); mesh_rows[mesh_entities[row]] = row; }
+        for (uint32_t row = 0; row < num_lights; ++row) { check_entity(light_entities[row]); light_rows[light_entities[row]] = row; }
+        for (uint32_t row = 0; row < num_cameras; ++row) { check_entity(camera_entities[row]); camera_rows[camera_entities[row]] = row; }
+
+        std::vector<std::vector<uint32_t>> entity_tags(num_entities);
+        for (uint32_t row = 0; row < num_tags; ++row) {
+            check_entity(tag_entities[row]);
+            if (tags.at(tag_columns[row])) { entity_tags[tag_entities[row]].push_back(tag_columns[row]); }
+        }
+
+        std::vector<uint32_t> parent_of(num_entities, invalid_id_);
+        for (uint32_t row = 0; row < num_children; ++row) {
+            check_entity(children[row]);
+            check_entity(parents[row]);
+            parent_of[children[row]] = parents[row];
+        }
+
+        // Parents have to be created before their children, so entities are grouped by their depth in the hierarchy first.
+        std::vector<uint32_t> depths(num_entities, invalid_id_);
+        for (uint32_t i = 0; i < num_entities; ++i) {
+            uint32_t depth = 0;
+            for (uint32_t e = parent_of[i]; e != invalid_id_; e = parent_of[e]) {
+                if (++depth > num_entities) { throw std::runtime_error("cyclic hierarchy in scene file"); }
+            }
+            depths[i] = depth;
+        }
+
+        // Group entities that end up in the same flecs table, so that each group can be created in one go.
+        std::map<std::vector<uint64_t>, std::vector<uint32_t>> groups;
+        for (uint32_t i = 0; i < num_entities; ++i) {
+            std::vector<uint64_t> key{depths[i], parent_of[i], flags[i],
+                                      mesh_rows[i] != invalid_id_, light_rows[i] != invalid_id_, camera_rows[i] != invalid_id_};
+            std::sort(entity_tags[i].begin(), entity_tags[i].end());
+            key.insert(key.end(), entity_tags[i].begin(), entity_tags[i].end());
+            groups[key].push_back(i);
+        }
+
+        std::vector<flecs::entity_t> created(num_entities, 0);
+        for (const auto& group : groups) {
+            const auto& members = group.second;
+            const uint32_t first = members.front();
+
+            std::vector<flecs::id_t> ids;
+            std::vector<void*> data;
+
+            std::vector<transform> transforms;
+            transforms.reserve(members.size());
+            for (auto i : members) {
+                transforms.emplace_back(read_vector3(positions, i), read_rotation(rotations, i), read_vector3(scales, i));
+            }
+            ids.push_back(world.component<transform>().id());
+            data.push_back(transforms.data());
+
+            std::vector<render_mesh> render_meshes;
+            if (mesh_rows[first] != invalid_id_) {
+                for (auto i : members) {
+                    const auto row = mesh_rows[i];
+                    render_meshes.push_back(render_mesh{material_ids[row] == invalid_id_ ? nullptr : materials.at(material_ids[row]),
+                                                        mesh_ids[row] == invalid_id_ ? nullptr : meshes.at(mesh_ids[row])});
+                }
+                ids.push_back(world.component<render_mesh>().id());
+                data.push_back(render_meshes.data());
+            }
+
+            std::vector<light> lights;
+            if (light_rows[first] != invalid_id_) {
+                for (auto i : members) {
+                    const auto row = light_rows[i];
+                    light lt;
+                    lt.set_mode(static_cast<light_mode>(light_modes[row]));
+                    lt.set_colour(read_colour(light_colours, row));
+                    lt.set_power(light_powers[row]);
+                    lt.set_attenuation_constant(light_attenuations[row * 3]);
+                    lt.set_attenuation_linear(light_attenuations[row * 3 + 1]);
+                    lt.set_attenuation_quadratic(light_attenuations[row * 3 + 2]);
+                    lt.set_spotlight_inner_angle(light_angles[row * 2]);
+                    lt.set_spotlight_outer_angle(light_angles[row * 2 + 1]);
+                    lt.set_shadow_distance(light_shadow_distances[row]);
+                    lights.push_back(lt);
+                }
+                ids.push_back(world.component<light>().id());
+                data.push_back(lights.data());
+            }
+
+            std::vector<camera> cameras;
+            if (camera_rows[first] != invalid_id_) {
+                for (auto i : members) {
+                    const auto row = camera_rows[i];
+                    camera cam;
+                    cam.mode_ = static_cast<projection_mode>(camera_modes[row]);
+                    cam.near_plane_ = camera_planes[row * 2];
+                    cam.far_plane_ = camera_planes[row * 2 + 1];
+                    cam.aspect_ratio_ = camera_aspect_ratios[row];
+                    cam.fov_ = camera_fovs[row];
+                    cam.ortho_size_ = camera_ortho_sizes[row];
+                    cam.depth_ = camera_depths[row];
+                    cam.viewport_ = viewport{camera_viewports[row * 4], camera_viewports[row * 4 + 1], camera_viewports[row * 4 + 2], camera_viewports[row * 4 + 3]};
+                    cam.skybox_.colour_ = read_colour(camera_skybox_colours, row);
+                    cam.skybox_.texture_ = camera_skybox_textures[row] == invalid_id_ ? nullptr : cubemaps.at(camera_skybox_textures[row]);
+                    cam.skybox_.shader_ = camera_skybox_shaders[row] == invalid_id_ ? nullptr : shaders.at(camera_skybox_shaders[row]);
+                    cameras.push_back(cam);
+                }
+                ids.push_back(world.component<camera>().id());
+                data.push_back(cameras.data());
+            }
+
+            if (flags[first] & has_local_to_world) {
+                ids.push_back(world.component<local_to_world>().id());
+                data.push_back(nullptr);
+                ids.push_back(world.component<previous_local_to_world>().id());
+                data.push_back(nullptr);
+            }
+
+            for (auto tag : entity_tags[first]) {
+                ids.push_back(tags[tag]);
+                data.push_back(nullptr);
+            }
+
+            if (parent_of[first] != invalid_id_) {
+                ids.push_back(ecs_pair(flecs::ChildOf, created[parent_of[first]]));
+                data.push_back(nullptr);
+            }
+
+            const auto entities = _scene.bulk_create(static_cast<int32_t>(members.size()), ids, data);
+            for (size_t i = 0; i < members.size(); ++i) {
+                created[members[i]] = entities[i];
+            }
+        }
+
+        // Names are set afterwards, as only a handful of entities are named.
+        for (uint32_t i = 0; i < num_entities; ++i) {
+            if (!names[i].empty()) { flecs::entity(world.c_ptr(), created[i]).set_name(names[i].c_str()); }
+        }
+    }
+} // mkr
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <stdexcept>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <maths/vector3.h>
+#include <maths/quaternion.h>
+#include <maths/colour.h>
+
+namespace mkr {
+    class scene;
+
+    /**
+     * Reads and writes the entities of a scene in a compact binary format.
+     *
+     * Every entity with a transform is serialized. Entities without one, such as the chunks of baked static geometry, are derived from the others and are not saved.
+     * Only the components listed below are saved. Saving warns about any other component, as it would be lost. The file contains, in order:
+     * - A header, with the magic number, the version and the number of entities.
+     * - The asset tables: the names of every mesh, material, cubemap and shader referenced, so that each is resolved once on load.
+     * - The entity names and flags.
+     * - The parent/child table.
+     * - One table per component type. Each table lists the entities that have the component, followed by one column per field.
+     *   Asset references are stored as indices into the asset tables.
+     * - The tag table. Tags are referenced by their flecs path, and must be registered in the world before loading.
+     *
+     * On load, entities that share the same components, tags and parent are bulk-created into their final flecs table.
+     */
+    class scene_serializer {
+    private:
+        static constexpr uint32_t magic_ = 0x53524B4D; // "MKRS"
+        static constexpr uint32_t version_ = 1;
+        static constexpr uint32_t invalid_id_ = UINT32_MAX;
+
+        enum entity_flag : uint8_t {
+            has_local_to_world = 0x01,
+        };
+
+        template<typename T>
+        static void write(std::ostream& _stream, const T& _value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            _stream.write(reinterpret_cast<const char*>(&_value), sizeof(T));
+        }
+
+        template<typename T>
+        static void write_column(std::ostream& _stream, const std::vector<T>& _column) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            _stream.write(reinterpret_cast<const char*>(_column.data()), static_cast<std::streamsize>(sizeof(T) * _column.size()));
+        }
+
+        template<typename T>
+        static T read(std::istream& _stream) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            _stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+            if (!_stream) { throw std::runtime_error("unexpected end of scene file"); }
+            return value;
+        }
+
+        template<typename T>
+        static std::vector<T> read_column(std::istream& _stream, size_t _size) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            std::vector<T> column(_size);
+            _stream.read(reinterpret_cast<char*>(column.data()), static_cast<std::streamsize>(sizeof(T) * _size));
+            if (!_stream) { throw std::runtime_error("unexpected end of scene file"); }
+            return column;
+        }
+
+        static void write_string(std::ostream& _stream, const std::string& _string);
+        static std::string read_string(std::istream& _stream);
+        static void write_strings(std::ostream& _stream, const std::vector<std::string>& _strings);
+        static std::vector<std::string> read_strings(std::istream& _stream);
+
+        static void write_vector3(std::vector<float>& _column, const vector3& _vector);
+        static vector3 read_vector3(const std::vector<float>& _column, size_t _index);
+        static void write_colour(std::vector<float>& _column, const colour& _colour);
+        static colour read_colour(const std::vector<float>& _column, size_t _index);
+
+        /**
+         * Quaternions are stored as an axis and an angle, so that the format does not depend on the layout of the quaternion class.
+         * @param _column The column to append the axis and angle to.
+         * @param _rotation The rotation to write.
+         */
+        static void write_rotation(std::vector<float>& _column, const quaternion& _rotation);
+        static quaternion read_rotation(const std::vector<float>& _column, size_t _index);
+
+    public:
+        scene_serializer() = delete;
+
+        static void save(scene& _scene, std::ostream& _stream);
+        static void load(scene& _scene, std::istream& _stream);
+    };
+} // mkr
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mkr {
+    template<typename Signature, size_t Capacity = 32>
+    class inplace_function;
+
+    /**
+     * A callable wrapper like std::function, which stores the callable inside itself rather than on the heap.
+     * Callables larger than Capacity do not compile, rather than silently allocating.
+     * @tparam R The return type.
+     * @tparam Args The argument types.
+     * @tparam Capacity The largest callable that can be stored, in bytes.
+     */
+    template<typename R, typename... Args, size_t Capacity>
+    class inplace_function<R(Args...), Capacity> {
+    private:
+        enum class operation { copy, move, destroy };
+
+        using invoke_func = R (*)(void*, Args&&...);
+        using manage_func = void (*)(operation, void* _dst, void* _src);
+
+        alignas(std::max_align_t) std::byte storage_[Capacity];
+        invoke_func invoke_ = nullptr;
+        manage_func manage_ = nullptr;
+
+        void reset() {
+            if (manage_) { manage_(operation::destroy, storage_, nullptr); }
+            invoke_ = nullptr;
+            manage_ = nullptr;
+        }
+
+    public:
+        inplace_function() = default;
+
+        template<typename F>
+        inplace_function(F&& _func) requires (!std::is_same_v<std::decay_t<F>, inplace_function> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>) {
+            using T = std::decay_t<F>;
+            static_assert(sizeof(T) <= Capacity, "Callable is too large for inplace_function");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Callable is over-aligned for inplace_function");
+
+            ::new (static_cast<void*>(storage_)) T(std::forward<F>(_func));
+            invoke_ = [](void* _storage, Args&&... _args) -> R { return std::invoke(*static_cast<T*>(_storage), std::forward<Args>(_args)...); };
+            manage_ = [](operation _op, void* _dst, void* _src) {
+                switch (_op) {
+                    case operation::copy: ::new (_dst) T(*static_cast<const T*>(_src)); break;
+                    case operation::move: ::new (_dst) T(std::move(*static_cast<T*>(_src))); break;
+                    case operation::destroy: static_cast<T*>(_dst)->~T(); break;
+                }
+            };
+        }
+
+        inplace_function(const inplace_function& _other)
+            : invoke_(_other.invoke_), manage_(_other.manage_) {
+            if (manage_) { manage_(operation::copy, storage_, const_cast<std::byte*>(_other.storage_)); }
+        }
+
+        inplace_function(inplace_function&& _other) noexcept
+            : invoke_(_other.invoke_), manage_(_other.manage_) {
+            if (manage_) { manage_(operation::move, storage_, _other.storage_); }
+        }
+
+        ~inplace_function() { reset(); }
+
+        inplace_function& operator=(const inplace_function& _other) {
+            if (this != &_other) {
+                reset();
+                if (_other.manage_) { _other.manage_(operation::copy, storage_, const_cast<std::byte*>(_other.storage_)); }
+                invoke_ = _other.invoke_;
+                manage_ = _other.manage_;
+            }
+            return *this;
+        }
+
+        inplace_function& operator=(inplace_function&& _other) noexcept {
+            if (this != &_other) {
+                reset();
+                if (_other.manage_) { _other.manage_(operation::move, storage_, _other.storage_); }
+                invoke_ = _other.invoke_;
+                manage_ = _other.manage_;
+            }
+            return *this;
+        }
+
+        R operator()(Args... _args) const { return invoke_(const_cast<std::byte*>(storage_), std::forward<Args>(_args)...); }
+
+        explicit operator bool() const { return invoke_ != nullptr; }
+    };
+}
\ No newline at end of file
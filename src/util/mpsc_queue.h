@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mkr {
+    /**
+     * A fixed size, lock free queue for any number of producer threads and one consumer thread.
+     * Every cell has a sequence number, which tells producers whether the cell is free and tells the consumer whether the cell has been written.
+     * Producers only contend on head_, with a single compare and swap per push.
+     * @tparam T The type of the elements. Does not need to be default constructible or assignable.
+     * @tparam Capacity The number of elements. Must be a power of 2.
+     */
+    template<typename T, size_t Capacity>
+    class mpsc_queue {
+        static_assert(std::has_single_bit(Capacity), "mpsc_queue capacity must be a power of 2");
+
+    private:
+        static constexpr size_t index_mask = Capacity - 1;
+
+        struct cell {
+            std::atomic<size_t> sequence_;
+            alignas(T) std::byte storage_[sizeof(T)];
+        };
+
+        std::unique_ptr<cell[]> cells_;
+        alignas(64) std::atomic<size_t> head_ = 0;
+        alignas(64) size_t tail_ = 0;
+
+    public:
+        mpsc_queue()
+            : cells_(std::make_unique<cell[]>(Capacity)) {
+            for (size_t i = 0; i < Capacity; ++i) { cells_[i].sequence_.store(i, std::memory_order_relaxed); }
+        }
+
+        ~mpsc_queue() {
+            consume([](T&&) {});
+        }
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+        /**
+         * Add an element to the queue. May be called from any thread.
+         * @param _value The element.
+         * @return false if the queue is full, and the element was not added.
+         */
+        bool try_push(const T& _value) {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            while (true) {
+                auto& c = cells_[pos & index_mask];
+                const size_t sequence = c.sequence_.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+                if (diff == 0) {
+                    // The cell is free. Claim it, or try again at the new head if another producer got there first.
+                    if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        ::new (static_cast<void*>(c.storage_)) T(_value);
+                        c.sequence_.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    // The consumer has not emptied the cell yet, so the queue is full.
+                    return false;
+                } else {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Remove every element that has been fully pushed, oldest first. Must only be called by the consumer.
+         * @param _func Called with each element.
+         * @return The number of elements removed.
+         */
+        template<typename F>
+        size_t consume(F&& _func) {
+            size_t num_consumed = 0;
+            while (true) {
+                auto& c = cells_[tail_ & index_mask];
+                if (c.sequence_.load(std::memory_order_acquire) != tail_ + 1) { break; }
+
+                T* value = std::launder(reinterpret_cast<T*>(c.storage_));
+                _func(std::move(*value));
+                value->~T();
+
+                // Mark the cell free for the producers' next trip around the queue.
+                c.sequence_.store(tail_ + Capacity, std::memory_order_release);
+                ++tail_;
+                ++num_consumed;
+            }
+            return num_consumed;
+        }
+
+        [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+    };
+}
\ No newline at end of file
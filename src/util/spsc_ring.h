@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+namespace mkr {
+    /**
+     * A fixed size, lock free ring buffer for one producer thread and one consumer thread.
+     * The producer only writes head_ and the consumer only writes tail_, so neither ever waits on the other.
+     * @tparam T The type of the elements. Copied in and out, so it should be small and trivially copyable.
+     * @tparam Capacity The number of elements. Must be a power of 2.
+     */
+    template<typename T, size_t Capacity>
+    class spsc_ring {
+        static_assert(std::has_single_bit(Capacity), "spsc_ring capacity must be a power of 2");
+
+    private:
+        static constexpr size_t index_mask = Capacity - 1;
+
+        // Kept on separate cache lines, so that the producer and consumer do not invalidate each other's cache line on every push and pop.
+        alignas(64) std::atomic<size_t> head_ = 0;
+        alignas(64) std::atomic<size_t> tail_ = 0;
+        std::array<T, Capacity> buffer_;
+
+    public:
+        /**
+         * Add an element to the ring. Must only be called by the producer.
+         * @param _value The element.
+         * @return false if the ring is full, and the element was not added.
+         */
+        bool try_push(const T& _value) {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) == Capacity) { return false; }
+            buffer_[head & index_mask] = _value;
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Remove the oldest element from the ring. Must only be called by the consumer.
+         * @param _value Output, the element.
+         * @return false if the ring is empty.
+         */
+        bool try_pop(T& _value) {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail == head_.load(std::memory_order_acquire)) { return false; }
+            _value = buffer_[tail & index_mask];
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// The number of elements in the ring. Only exact when called by the producer or the consumer, with the other idle.
+        [[nodiscard]] size_t size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+
+        [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+    };
+}
\ No newline at end of file